@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "../common/tree_join.h"
+
+// ========================================================================
+// AVLMap<Key, Value, Compare, Allocator> - УПОРЯДОЧЕННЫЙ СЛОВАРЬ НА AVL-ДЕРЕВЕ
+// ========================================================================
+// Интерфейс - как у std::map (см. common/tree_map.h). В узле хранится
+// высота поддерева; после вставки и удаления поднимаемся к корню, обновляя
+// высоты и выполняя те же повороты LL / RR / LR / RL, что и учебный
+// simple_avl.cxx. Высота дерева не больше 1.44 log2(n).
+//
+// Массовое построение, split / join и объединение / пересечение / разность
+// словарей - из common/tree_join.h; здесь только join по высотам.
+// ========================================================================
+
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>, typename Augment = NoAugment>
+class AVLMap
+    : public JoinableTreeMap<AVLMap<Key, Value, Compare, Allocator, Augment>, Key, Value, Compare, Allocator,
+                             int, Augment>
+{
+protected:
+    using Base = JoinableTreeMap<AVLMap, Key, Value, Compare, Allocator, int, Augment>;
+    using Node = typename Base::Node;
+    friend Base;
+    friend typename Base::MapBase;
+
+public:
+    using Base::Base;
+
+protected:
+    static int nodeHeight(const Node* node) { return node == nullptr ? 0 : node->balance; }
+
+    static void updateHeight(Node* node)
+    {
+        node->balance = 1 + std::max(nodeHeight(node->left), nodeHeight(node->right));
+    }
+
+    // Поворот с пересчётом высот; возвращает новый корень поддерева
+    Node* rotateLeftAVL(Node* x)
+    {
+        Node* y = x->right;
+        this->rotateLeft(x);
+        updateHeight(x);
+        updateHeight(y);
+        return y;
+    }
+
+    Node* rotateRightAVL(Node* x)
+    {
+        Node* y = x->left;
+        this->rotateRight(x);
+        updateHeight(x);
+        updateHeight(y);
+        return y;
+    }
+
+    // Подъём от node к корню с восстановлением баланса
+    void rebalanceUp(Node* node)
+    {
+        while (node != nullptr)
+        {
+            updateHeight(node);
+            int balance = nodeHeight(node->left) - nodeHeight(node->right);
+            if (balance > 1)
+            {
+                // Left-Right: сначала левый поворот левого ребёнка
+                if (nodeHeight(node->left->left) < nodeHeight(node->left->right))
+                    rotateLeftAVL(node->left);
+                node = rotateRightAVL(node);
+            }
+            else if (balance < -1)
+            {
+                // Right-Left: сначала правый поворот правого ребёнка
+                if (nodeHeight(node->right->right) < nodeHeight(node->right->left))
+                    rotateRightAVL(node->right);
+                node = rotateLeftAVL(node);
+            }
+            node = node->parent;
+        }
+    }
+
+    void afterInsert(Node* node, int)
+    {
+        node->balance = 1;
+        rebalanceUp(node->parent);
+    }
+
+    void eraseNode(Node* node)
+    {
+        rebalanceUp(this->bstErase(node));
+    }
+
+    // --------------------------------------------------------------------
+    // join по высотам (для common/tree_join.h)
+    // --------------------------------------------------------------------
+    static Node* linkAVL(Node* left, Node* mid, Node* right)
+    {
+        Base::link(left, mid, right);
+        updateHeight(mid);
+        return mid;
+    }
+
+    static Node* rotateLeftDetached(Node* x)
+    {
+        Node* y = Base::rotateLeftSubtree(x);
+        updateHeight(x);
+        updateHeight(y);
+        return y;
+    }
+
+    static Node* rotateRightDetached(Node* x)
+    {
+        Node* y = Base::rotateRightSubtree(x);
+        updateHeight(x);
+        updateHeight(y);
+        return y;
+    }
+
+    // tree выше right больше чем на 1: спуск по правому краю tree до
+    // поддерева высоты h(right) или h(right) + 1, на подъёме - повороты
+    static Node* joinRight(Node* tree, Node* mid, Node* right)
+    {
+        Node* inner = tree->right;
+        if (nodeHeight(inner) <= nodeHeight(right) + 1)
+        {
+            Node* joined = linkAVL(inner, mid, right);
+            if (nodeHeight(joined) <= nodeHeight(tree->left) + 1)
+            {
+                Base::setRight(tree, joined);
+                updateHeight(tree);
+                return tree;
+            }
+            Base::setRight(tree, rotateRightDetached(joined));
+            return rotateLeftDetached(tree);
+        }
+        Node* joined = joinRight(inner, mid, right);
+        Base::setRight(tree, joined);
+        updateHeight(tree);
+        if (nodeHeight(joined) <= nodeHeight(tree->left) + 1)
+            return tree;
+        return rotateLeftDetached(tree);
+    }
+
+    static Node* joinLeft(Node* left, Node* mid, Node* tree)
+    {
+        Node* inner = tree->left;
+        if (nodeHeight(inner) <= nodeHeight(left) + 1)
+        {
+            Node* joined = linkAVL(left, mid, inner);
+            if (nodeHeight(joined) <= nodeHeight(tree->right) + 1)
+            {
+                Base::setLeft(tree, joined);
+                updateHeight(tree);
+                return tree;
+            }
+            Base::setLeft(tree, rotateLeftDetached(joined));
+            return rotateRightDetached(tree);
+        }
+        Node* joined = joinLeft(left, mid, inner);
+        Base::setLeft(tree, joined);
+        updateHeight(tree);
+        if (nodeHeight(joined) <= nodeHeight(tree->right) + 1)
+            return tree;
+        return rotateRightDetached(tree);
+    }
+
+    Node* joinNodes(Node* left, Node* mid, Node* right)
+    {
+        Node* top;
+        if (nodeHeight(left) > nodeHeight(right) + 1)
+            top = joinRight(left, mid, right);
+        else if (nodeHeight(right) > nodeHeight(left) + 1)
+            top = joinLeft(left, mid, right);
+        else
+            top = linkAVL(left, mid, right);
+        top->parent = nullptr;
+        return top;
+    }
+};
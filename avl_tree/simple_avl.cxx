@@ -1,6 +1,8 @@
 #include <iostream>
 #include <algorithm>
 
+#include "../common/trace.h"
+
 // Узел AVL дерева
 struct AVLNode
 {
@@ -13,10 +15,11 @@ struct AVLNode
 };
 
 // Класс AVL дерева (самобалансирующееся бинарное дерево поиска)
+template <typename Trace = NoTrace>
 class AVLTree
 {
     AVLNode* root;
-    bool verbose;
+    Trace verbose;
 
     // Получить высоту узла
     int getHeight(AVLNode* node)
@@ -563,6 +566,15 @@ public:
         root = deleteHelper(root, val);
     }
 
+    // Поиск без изменения дерева (спуск от корня, O(log n))
+    bool search(int val)
+    {
+        AVLNode* node = root;
+        while (node != nullptr && node->data != val)
+            node = val < node->data ? node->left : node->right;
+        return node != nullptr;
+    }
+
     void inorder()
     {
         std::cout << "Inorder обход: ";
@@ -589,7 +601,7 @@ int main()
     std::cout << "  ТЕСТ 1: AVL дерево - вставка" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    AVLTree avl1(true);
+    AVLTree<VerboseTrace> avl1(true);
     
     std::cout << "\n--- Вставка элементов в порядке, вызывающем дисбаланс ---" << std::endl;
     std::cout << "Вставляем: 10, 20, 30 (вызовет Right-Right поворот)" << std::endl;
@@ -613,7 +625,7 @@ int main()
     std::cout << "  ТЕСТ 2: Сравнение с обычным BST" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    AVLTree avl2(false);
+    AVLTree<> avl2(false);
     std::cout << "Вставка в порядке возрастания (1-7) в AVL дерево:" << std::endl;
     for (int i = 1; i <= 7; i++)
     {
@@ -627,7 +639,7 @@ int main()
     std::cout << "  ТЕСТ 3: Различные случаи поворотов" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    AVLTree avl3(true);
+    AVLTree<VerboseTrace> avl3(true);
     std::cout << "Тест Left-Left поворота:" << std::endl;
     avl3.insert(30);
     avl3.insert(20);
@@ -635,7 +647,7 @@ int main()
     avl3.printTree();
     
     std::cout << "\nТест Right-Left поворота:" << std::endl;
-    AVLTree avl4(true);
+    AVLTree<VerboseTrace> avl4(true);
     avl4.insert(10);
     avl4.insert(30);
     avl4.insert(20);
@@ -645,7 +657,7 @@ int main()
     std::cout << "  ТЕСТ 4: Ручное распознавание поворотов" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    AVLTree avl5(true);
+    AVLTree<VerboseTrace> avl5(true);
     std::cout << "\nПример 1: Распознавание LL (Left-Left)" << std::endl;
     std::cout << "Вставляем: 50, 30, 20" << std::endl;
     std::cout << "Анализ:" << std::endl;
@@ -658,7 +670,7 @@ int main()
     avl5.printTree();
     
     std::cout << "\nПример 2: Распознавание LR (Left-Right)" << std::endl;
-    AVLTree avl6(true);
+    AVLTree<VerboseTrace> avl6(true);
     std::cout << "Вставляем: 50, 30, 40" << std::endl;
     std::cout << "Анализ:" << std::endl;
     std::cout << "  1. После вставки 40: balance(50) = 2 (перевес слева = L)" << std::endl;
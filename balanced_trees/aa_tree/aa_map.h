@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "../../common/tree_map.h"
+
+// ========================================================================
+// AAMap<Key, Value, Compare, Allocator> - СЛОВАРЬ НА AA-ДЕРЕВЕ
+// ========================================================================
+// Интерфейс - как у std::map (см. common/tree_map.h). В узле - уровень
+// (level), у nullptr уровень 0. Балансировка - skew и split, как в учебном
+// simple_aa_tree.cxx, но не рекурсией, а подъёмом по родительским
+// указателям: после вставки и удаления skew / split применяются к каждому
+// предку - ровно то, что делает рекурсивная версия на обратном ходе.
+// ========================================================================
+
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>, typename Augment = NoAugment>
+class AAMap
+    : public TreeMapBase<AAMap<Key, Value, Compare, Allocator, Augment>, Key, Value, Compare, Allocator, int, Augment>
+{
+protected:
+    using Base = TreeMapBase<AAMap, Key, Value, Compare, Allocator, int, Augment>;
+    using Node = typename Base::Node;
+    friend Base;
+
+public:
+    using Base::Base;
+
+protected:
+    static int level(const Node* node) { return node == nullptr ? 0 : node->balance; }
+
+    // Левое горизонтальное ребро -> правый поворот; возвращает корень поддерева
+    Node* skew(Node* node)
+    {
+        if (node != nullptr && node->left != nullptr && node->left->balance == node->balance)
+        {
+            Node* left = node->left;
+            this->rotateRight(node);
+            return left;
+        }
+        return node;
+    }
+
+    // Два правых горизонтальных ребра подряд -> левый поворот и подъём уровня
+    Node* split(Node* node)
+    {
+        if (node != nullptr && node->right != nullptr && node->right->right != nullptr &&
+            node->right->right->balance == node->balance)
+        {
+            Node* right = node->right;
+            this->rotateLeft(node);
+            right->balance++;
+            return right;
+        }
+        return node;
+    }
+
+    void afterInsert(Node* node, int)
+    {
+        node->balance = 1;
+        for (Node* n = node->parent; n != nullptr; n = n->parent)
+        {
+            n = skew(n);
+            n = split(n);
+        }
+    }
+
+    // Удаление (Andersson): узел с двумя детьми заменяется преемником -
+    // он всегда на уровне 1. Затем у каждого предка понижается уровень,
+    // если он "висит" над детьми, и выполняются три skew и два split
+    void eraseNode(Node* node)
+    {
+        for (Node* n = this->bstErase(node); n != nullptr; n = n->parent)
+        {
+            int shouldBe = std::min(level(n->left), level(n->right)) + 1;
+            if (shouldBe < n->balance)
+            {
+                n->balance = shouldBe;
+                if (n->right != nullptr && shouldBe < n->right->balance)
+                    n->right->balance = shouldBe;
+            }
+            n = skew(n);
+            skew(n->right);
+            if (n->right != nullptr)
+                skew(n->right->right);
+            n = split(n);
+            split(n->right);
+        }
+    }
+};
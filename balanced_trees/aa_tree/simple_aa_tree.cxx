@@ -1,5 +1,7 @@
 #include <iostream>
 
+#include "../../common/trace.h"
+
 // Узел AA дерева
 struct AANode
 {
@@ -12,11 +14,12 @@ struct AANode
 };
 
 // Класс AA дерева
+template <typename Trace = NoTrace>
 class AATree
 {
     AANode* root;
     AANode* nil;    // Специальный узел-лист
-    bool verbose;
+    Trace verbose;
 
     // Операция skew (выравнивание) - аналог правого поворота
     AANode* skew(AANode* node)
@@ -64,7 +67,9 @@ class AATree
         {
             if (verbose)
                 std::cout << "  Вставка узла " << val << std::endl;
-            return new AANode(val);
+            AANode* created = new AANode(val);
+            created->left = created->right = nil;  // Потомки нового листа - nil, а не nullptr
+            return created;
         }
         
         if (val < node->data)
@@ -193,6 +198,7 @@ public:
     {
         nil = new AANode(0);
         nil->level = 0;
+        nil->left = nil->right = nil;  // skew/split могут обращаться к потомкам nil
         root = nil;
     }
 
@@ -242,7 +248,7 @@ int main()
     std::cout << "  ТЕСТ: AA Tree" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    AATree aa(true);
+    AATree<VerboseTrace> aa(true);
     
     std::cout << "\n--- Вставка элементов ---" << std::endl;
     aa.insert(50);
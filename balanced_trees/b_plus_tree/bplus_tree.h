@@ -0,0 +1,824 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// ========================================================================
+// BPlusTree<Key, Value, Compare, NodeBytes> - B+-ДЕРЕВО ДЛЯ ИНДЕКСОВ В ПАМЯТИ
+// ========================================================================
+// Бинарные деревья (AVL, красно-чёрное, ...) хранят один ключ в узле:
+// поиск среди n ключей - ~log2(n) переходов по указателям, и почти каждый
+// переход - промах кэша. В B+-дереве узел - массив ключей на несколько
+// кэш-линий (NodeBytes, по умолчанию 256 байт = 4 линии, 64 ключа int):
+//   - высота ~log_{B/2..B}(n): для 50 млн ключей int - 5 уровней вместо
+//     ~30 у красно-чёрного дерева;
+//   - внутри узла ключи лежат подряд, их перебор - последовательное
+//     чтение, которое процессор предвыбирает;
+//   - значения хранятся только в листьях, внутренние узлы - указатель на
+//     детей и разделители; листья связаны в список, поэтому диапазонный
+//     запрос - один спуск и затем последовательный проход по листьям;
+//   - память: ~13 байт на пару int -> int64 против ~48 у узла AVL.
+//
+// Поиск внутри узла. Для целых ключей с std::less пустые ячейки массива
+// заполнены максимальным значением ключа - тогда позиция ключа x равна
+// числу ячеек с keys[i] < x, и её можно считать без ветвлений, сразу по
+// нескольку ключей: SSE2 (4 ключа int32 за сравнение), AVX2 (4 ключа
+// int64), для остальных целых - цикл без ветвлений, который компилятор
+// векторизует сам. Для прочих ключей - двоичный поиск std::lower_bound.
+//
+// Инварианты (SLOTS - ёмкость узла в ключах):
+//   - ключи в узле строго возрастают;
+//   - лист (кроме корня) содержит от SLOTS/2 до SLOTS ключей;
+//   - внутренний узел (кроме корня) - от SLOTS/2 - 1 до SLOTS ключей,
+//     у него на одного ребёнка больше, чем ключей;
+//   - разделитель keys[i] внутреннего узла: все ключи поддерева
+//     children[i] меньше него, все ключи children[i + 1] - не меньше;
+//   - все листья на одной глубине.
+//
+// Key и Value должны конструироваться по умолчанию (узел - массивы).
+// Копирование дерева запрещено, перемещение - разрешено.
+// ========================================================================
+
+// Число ключей keys[0..n), меньших x (ключи отсортированы, хвост заполнен
+// максимумом). Общий случай - счёт без ветвлений
+template <typename Key>
+int countKeysLess(const Key* keys, int n, Key x)
+{
+    int count = 0;
+    for (int i = 0; i < n; i++)
+        count += keys[i] < x;
+    return count;
+}
+
+#if defined(__SSE2__)
+// int32: 4 сравнения за инструкцию; результат сравнения (-1 / 0) вычитается
+// из счётчика. n кратно 4, keys выровнен на 16 байт
+inline int countKeysLess(const std::int32_t* keys, int n, std::int32_t x)
+{
+    const __m128i needle = _mm_set1_epi32(x);
+    __m128i counts = _mm_setzero_si128();
+    for (int i = 0; i < n; i += 4)
+    {
+        __m128i block = _mm_load_si128(reinterpret_cast<const __m128i*>(keys + i));
+        counts = _mm_sub_epi32(counts, _mm_cmplt_epi32(block, needle));
+    }
+    counts = _mm_add_epi32(counts, _mm_shuffle_epi32(counts, 0x4E));
+    counts = _mm_add_epi32(counts, _mm_shuffle_epi32(counts, 0xB1));
+    return _mm_cvtsi128_si32(counts);
+}
+#endif
+
+#if defined(__AVX2__)
+// int64: 4 сравнения за инструкцию. n кратно 4, keys выровнен на 32 байта
+inline int countKeysLess(const std::int64_t* keys, int n, std::int64_t x)
+{
+    const __m256i needle = _mm256_set1_epi64x(x);
+    __m256i counts = _mm256_setzero_si256();
+    for (int i = 0; i < n; i += 4)
+    {
+        __m256i block = _mm256_load_si256(reinterpret_cast<const __m256i*>(keys + i));
+        counts = _mm256_sub_epi64(counts, _mm256_cmpgt_epi64(needle, block));
+    }
+    alignas(32) std::int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), counts);
+    return static_cast<int>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+}
+#endif
+
+template <typename Key, typename Value, typename Compare = std::less<Key>, std::size_t NodeBytes = 256>
+class BPlusTree
+{
+    static_assert(NodeBytes % 64 == 0, "узел B+-дерева - целое число кэш-линий");
+
+public:
+    static constexpr int SLOTS = static_cast<int>(std::max<std::size_t>(8, NodeBytes / sizeof(Key)));
+    static constexpr int MIN_LEAF_KEYS = SLOTS / 2;
+    static constexpr int MIN_INNER_KEYS = SLOTS / 2 - 1;
+
+private:
+    // Целые ключи с естественным порядком: хвост узла заполнен максимумом,
+    // поиск в узле - countKeysLess по всем занятым блокам из 8 ключей
+    static constexpr bool PADDED =
+        std::is_integral_v<Key> &&
+        (std::is_same_v<Compare, std::less<Key>> || std::is_same_v<Compare, std::less<>>);
+    static constexpr int MAX_LEVELS = 64;
+
+    struct Node
+    {
+        alignas(64) Key keys[SLOTS];
+        int count = 0;
+        bool leaf;
+
+        explicit Node(bool isLeaf) : leaf(isLeaf)
+        {
+            if constexpr (PADDED)
+                std::fill(keys, keys + SLOTS, std::numeric_limits<Key>::max());
+        }
+    };
+
+    struct Leaf : Node
+    {
+        Value values[SLOTS];
+        Leaf* next = nullptr;
+
+        Leaf() : Node(true) {}
+    };
+
+    struct Inner : Node
+    {
+        Node* children[SLOTS + 1];
+
+        Inner() : Node(false) {}
+    };
+
+    Node* root = nullptr;
+    Leaf* head = nullptr;  // Самый левый лист - начало списка листьев
+    std::size_t itemCount = 0;
+    int levels = 0;
+    Compare compare;
+
+public:
+    // --------------------------------------------------------------------
+    // Итератор по листьям: ключи по возрастанию
+    // --------------------------------------------------------------------
+    template <bool IsConst>
+    class Iterator
+    {
+        using LeafPtr = std::conditional_t<IsConst, const Leaf*, Leaf*>;
+        using ValueRef = std::conditional_t<IsConst, const Value&, Value&>;
+
+        LeafPtr leaf = nullptr;
+        int index = 0;
+
+        friend class BPlusTree;
+        template <bool>
+        friend class Iterator;
+
+        Iterator(LeafPtr leafNode, int position) : leaf(leafNode), index(position)
+        {
+            if (leaf != nullptr && index == leaf->count)
+            {
+                leaf = leaf->next;
+                index = 0;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<const Key, Value>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const Key&, ValueRef>;
+        using pointer = void;
+
+        Iterator() = default;
+
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) : leaf(other.leaf), index(other.index)
+        {
+        }
+
+        const Key& key() const { return leaf->keys[index]; }
+        ValueRef value() const { return leaf->values[index]; }
+        reference operator*() const { return reference(leaf->keys[index], leaf->values[index]); }
+
+        Iterator& operator++()
+        {
+            if (++index == leaf->count)
+            {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return leaf == other.leaf && index == other.index; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    // --------------------------------------------------------------------
+    // Создание и уничтожение
+    // --------------------------------------------------------------------
+    explicit BPlusTree(const Compare& comp = Compare()) : compare(comp)
+    {
+    }
+
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    BPlusTree(BPlusTree&& other) noexcept
+        : root(other.root), head(other.head), itemCount(other.itemCount), levels(other.levels),
+          compare(std::move(other.compare))
+    {
+        other.root = nullptr;
+        other.head = nullptr;
+        other.itemCount = 0;
+        other.levels = 0;
+    }
+
+    BPlusTree& operator=(BPlusTree&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            std::swap(root, other.root);
+            std::swap(head, other.head);
+            std::swap(itemCount, other.itemCount);
+            std::swap(levels, other.levels);
+            compare = std::move(other.compare);
+        }
+        return *this;
+    }
+
+    ~BPlusTree()
+    {
+        destroySubtree(root);
+    }
+
+    void clear()
+    {
+        destroySubtree(root);
+        root = nullptr;
+        head = nullptr;
+        itemCount = 0;
+        levels = 0;
+    }
+
+    std::size_t size() const { return itemCount; }
+    bool empty() const { return itemCount == 0; }
+    int height() const { return levels; }
+
+    iterator begin() { return iterator(head, 0); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(head, 0); }
+    const_iterator end() const { return const_iterator(); }
+
+    // --------------------------------------------------------------------
+    // Поиск
+    // --------------------------------------------------------------------
+    Value* find(const Key& key)
+    {
+        return const_cast<Value*>(std::as_const(*this).find(key));
+    }
+
+    const Value* find(const Key& key) const
+    {
+        if (root == nullptr)
+            return nullptr;
+        const Leaf* leaf = findLeaf(key);
+        int pos = lowerIndex(leaf, key);
+        if (pos < leaf->count && !compare(key, leaf->keys[pos]))
+            return &leaf->values[pos];
+        return nullptr;
+    }
+
+    bool contains(const Key& key) const { return find(key) != nullptr; }
+
+    // Первый ключ, не меньший key - начало диапазонного запроса
+    iterator lowerBound(const Key& key)
+    {
+        if (root == nullptr)
+            return end();
+        Leaf* leaf = const_cast<Leaf*>(findLeaf(key));
+        return iterator(leaf, lowerIndex(leaf, key));
+    }
+
+    const_iterator lowerBound(const Key& key) const
+    {
+        if (root == nullptr)
+            return end();
+        const Leaf* leaf = findLeaf(key);
+        return const_iterator(leaf, lowerIndex(leaf, key));
+    }
+
+    // --------------------------------------------------------------------
+    // Вставка: спуск к листу с запоминанием пути; переполненный узел
+    // делится пополам, разделитель поднимается в родителя
+    // --------------------------------------------------------------------
+    // false - ключ уже есть (значение не меняется)
+    template <typename V>
+    bool insert(const Key& key, V&& value)
+    {
+        if (root == nullptr)
+        {
+            Leaf* leaf = new Leaf();
+            leaf->keys[0] = key;
+            leaf->values[0] = std::forward<V>(value);
+            leaf->count = 1;
+            root = head = leaf;
+            levels = 1;
+            itemCount = 1;
+            return true;
+        }
+
+        Inner* path[MAX_LEVELS];
+        int pathIndex[MAX_LEVELS];
+        int depth = 0;
+        Node* node = root;
+        while (!node->leaf)
+        {
+            Inner* inner = static_cast<Inner*>(node);
+            int i = childIndex(inner, key);
+            path[depth] = inner;
+            pathIndex[depth] = i;
+            depth++;
+            node = inner->children[i];
+        }
+
+        Leaf* leaf = static_cast<Leaf*>(node);
+        int pos = lowerIndex(leaf, key);
+        if (pos < leaf->count && !compare(key, leaf->keys[pos]))
+            return false;
+        itemCount++;
+        if (leaf->count < SLOTS)
+        {
+            insertIntoLeaf(leaf, pos, key, std::forward<V>(value));
+            return true;
+        }
+
+        Leaf* right = splitLeaf(leaf);
+        if (pos <= leaf->count)
+            insertIntoLeaf(leaf, pos, key, std::forward<V>(value));
+        else
+            insertIntoLeaf(right, pos - leaf->count, key, std::forward<V>(value));
+
+        // Подъём разделителя: пока родитель переполнен, делится и он
+        Key separator = right->keys[0];
+        Node* newChild = right;
+        while (depth > 0)
+        {
+            depth--;
+            Inner* parent = path[depth];
+            int i = pathIndex[depth];
+            if (parent->count < SLOTS)
+            {
+                insertIntoInner(parent, i, separator, newChild);
+                return true;
+            }
+            newChild = splitInner(parent, i, separator, newChild);
+        }
+
+        // Поделился корень - дерево растёт вверх
+        Inner* newRoot = new Inner();
+        newRoot->keys[0] = separator;
+        newRoot->children[0] = root;
+        newRoot->children[1] = newChild;
+        newRoot->count = 1;
+        root = newRoot;
+        levels++;
+        return true;
+    }
+
+    // --------------------------------------------------------------------
+    // Удаление: узел, где ключей стало меньше минимума, занимает ключ у
+    // соседа (через разделитель в родителе) или сливается с ним
+    // --------------------------------------------------------------------
+    bool erase(const Key& key)
+    {
+        if (root == nullptr)
+            return false;
+
+        Inner* path[MAX_LEVELS];
+        int pathIndex[MAX_LEVELS];
+        int depth = 0;
+        Node* node = root;
+        while (!node->leaf)
+        {
+            Inner* inner = static_cast<Inner*>(node);
+            int i = childIndex(inner, key);
+            path[depth] = inner;
+            pathIndex[depth] = i;
+            depth++;
+            node = inner->children[i];
+        }
+
+        Leaf* leaf = static_cast<Leaf*>(node);
+        int pos = lowerIndex(leaf, key);
+        if (pos >= leaf->count || compare(key, leaf->keys[pos]))
+            return false;
+        std::move(leaf->keys + pos + 1, leaf->keys + leaf->count, leaf->keys + pos);
+        std::move(leaf->values + pos + 1, leaf->values + leaf->count, leaf->values + pos);
+        leaf->values[leaf->count - 1] = Value();
+        setCount(leaf, leaf->count - 1);
+        itemCount--;
+
+        // Устаревший разделитель (если удалён минимум листа) не мешает:
+        // оставшиеся ключи листа всё равно не меньше него
+        while (depth > 0)
+        {
+            bool underflow = node->leaf ? node->count < MIN_LEAF_KEYS : node->count < MIN_INNER_KEYS;
+            if (!underflow)
+                break;
+            depth--;
+            if (node->leaf)
+                fixLeaf(path[depth], pathIndex[depth]);
+            else
+                fixInner(path[depth], pathIndex[depth]);
+            node = path[depth];
+        }
+
+        if (root->count == 0)
+        {
+            if (root->leaf)
+            {
+                delete static_cast<Leaf*>(root);
+                root = nullptr;
+                head = nullptr;
+                levels = 0;
+            }
+            else
+            {
+                Inner* oldRoot = static_cast<Inner*>(root);
+                root = oldRoot->children[0];
+                delete oldRoot;
+                levels--;
+            }
+        }
+        return true;
+    }
+
+    // --------------------------------------------------------------------
+    // Массовая загрузка из отсортированных пар (key, value)
+    // --------------------------------------------------------------------
+    // Дерево строится снизу вверх за O(n) без поиска и делений узлов:
+    // листья заполняются целиком (последние два выравниваются, чтобы не
+    // нарушить минимум), затем над каждым уровнем строится следующий.
+    // Ключи должны строго возрастать, иначе std::invalid_argument (дерево
+    // при этом не меняется). Прежнее содержимое заменяется
+    template <typename InputIt>
+    void bulkLoad(InputIt first, InputIt last)
+    {
+        std::vector<Node*> level;
+        std::vector<Key> minKeys;  // Минимальный ключ каждого поддерева уровня
+        std::size_t loaded = 0;
+        try
+        {
+            Leaf* leaf = nullptr;
+            for (; first != last; ++first)
+            {
+                const auto& item = *first;
+                if (leaf != nullptr && !compare(leaf->keys[leaf->count - 1], item.first))
+                    throw std::invalid_argument("BPlusTree::bulkLoad: ключи должны строго возрастать");
+                if (leaf == nullptr || leaf->count == SLOTS)
+                {
+                    // Лист принадлежит level с момента добавления: если
+                    // push_back бросит, его удалит unique_ptr
+                    std::unique_ptr<Leaf> fresh(new Leaf());
+                    level.push_back(fresh.get());
+                    if (leaf != nullptr)
+                        leaf->next = fresh.get();
+                    leaf = fresh.release();
+                }
+                leaf->keys[leaf->count] = item.first;
+                leaf->values[leaf->count] = item.second;
+                leaf->count++;
+                loaded++;
+            }
+            if (level.size() >= 2 && leaf->count < MIN_LEAF_KEYS)
+                balanceLastLeaves(static_cast<Leaf*>(level[level.size() - 2]), leaf);
+            for (Node* node : level)
+                minKeys.push_back(node->keys[0]);
+
+            int newLevels = level.empty() ? 0 : 1;
+            while (level.size() > 1)
+            {
+                buildInnerLevel(level, minKeys);
+                newLevels++;
+            }
+
+            clear();
+            root = level.empty() ? nullptr : level[0];
+            head = root == nullptr ? nullptr : leftmostLeaf(root);
+            itemCount = loaded;
+            levels = newLevels;
+        }
+        catch (...)
+        {
+            // level - верхний готовый уровень: листья или корни поддеревьев.
+            // Недостроенный уровень над ним удаляет сам buildInnerLevel
+            for (Node* node : level)
+                destroySubtree(node);
+            throw;
+        }
+    }
+
+private:
+    // --------------------------------------------------------------------
+    // Поиск внутри узла
+    // --------------------------------------------------------------------
+    // Позиция первого ключа, не меньшего key
+    int lowerIndex(const Node* node, const Key& key) const
+    {
+        if constexpr (PADDED)
+            return countKeysLess(node->keys, (node->count + 7) & ~7, key);
+        else
+            return static_cast<int>(std::lower_bound(node->keys, node->keys + node->count, key, compare) - node->keys);
+    }
+
+    // Ребёнок, в поддереве которого должен лежать key: число разделителей <= key
+    int childIndex(const Inner* node, const Key& key) const
+    {
+        int i = lowerIndex(node, key);
+        if (i < node->count && !compare(key, node->keys[i]))
+            i++;
+        return i;
+    }
+
+    const Leaf* findLeaf(const Key& key) const
+    {
+        const Node* node = root;
+        while (!node->leaf)
+        {
+            const Inner* inner = static_cast<const Inner*>(node);
+            node = inner->children[childIndex(inner, key)];
+        }
+        return static_cast<const Leaf*>(node);
+    }
+
+    static Leaf* leftmostLeaf(Node* node)
+    {
+        while (!node->leaf)
+            node = static_cast<Inner*>(node)->children[0];
+        return static_cast<Leaf*>(node);
+    }
+
+    // Новое число ключей; освободившиеся ячейки снова заполняются максимумом
+    static void setCount(Node* node, int newCount)
+    {
+        if constexpr (PADDED)
+        {
+            if (newCount < node->count)
+                std::fill(node->keys + newCount, node->keys + node->count, std::numeric_limits<Key>::max());
+        }
+        node->count = newCount;
+    }
+
+    // --------------------------------------------------------------------
+    // Вставка и деление узлов
+    // --------------------------------------------------------------------
+    template <typename V>
+    static void insertIntoLeaf(Leaf* leaf, int pos, const Key& key, V&& value)
+    {
+        std::move_backward(leaf->keys + pos, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+        std::move_backward(leaf->values + pos, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+        leaf->keys[pos] = key;
+        leaf->values[pos] = std::forward<V>(value);
+        leaf->count++;
+    }
+
+    // Разделитель key и правый ребёнок child встают на позицию pos
+    static void insertIntoInner(Inner* node, int pos, const Key& key, Node* child)
+    {
+        std::move_backward(node->keys + pos, node->keys + node->count, node->keys + node->count + 1);
+        std::move_backward(node->children + pos + 1, node->children + node->count + 1,
+                           node->children + node->count + 2);
+        node->keys[pos] = key;
+        node->children[pos + 1] = child;
+        node->count++;
+    }
+
+    // Верхняя половина ключей уходит в новый правый лист
+    static Leaf* splitLeaf(Leaf* leaf)
+    {
+        Leaf* right = new Leaf();
+        int mid = SLOTS / 2;
+        std::move(leaf->keys + mid, leaf->keys + SLOTS, right->keys);
+        std::move(leaf->values + mid, leaf->values + SLOTS, right->values);
+        std::fill(leaf->values + mid, leaf->values + SLOTS, Value());
+        right->count = SLOTS - mid;
+        setCount(leaf, mid);
+        right->next = leaf->next;
+        leaf->next = right;
+        return right;
+    }
+
+    // Деление полного внутреннего узла со вставкой (separator, child) на
+    // позицию pos. Средний ключ уходит в родителя через separator
+    static Inner* splitInner(Inner* node, int pos, Key& separator, Node* child)
+    {
+        Inner* right = new Inner();
+        int mid = SLOTS / 2;
+        Key up = node->keys[mid];
+        std::move(node->keys + mid + 1, node->keys + SLOTS, right->keys);
+        std::copy(node->children + mid + 1, node->children + SLOTS + 1, right->children);
+        right->count = SLOTS - mid - 1;
+        setCount(node, mid);
+        if (pos <= mid)
+            insertIntoInner(node, pos, separator, child);
+        else
+            insertIntoInner(right, pos - mid - 1, separator, child);
+        separator = up;
+        return right;
+    }
+
+    // --------------------------------------------------------------------
+    // Восстановление после удаления: ребёнок parent->children[i] недополнен
+    // --------------------------------------------------------------------
+    void fixLeaf(Inner* parent, int i)
+    {
+        Leaf* node = static_cast<Leaf*>(parent->children[i]);
+        if (i < parent->count)
+        {
+            Leaf* right = static_cast<Leaf*>(parent->children[i + 1]);
+            if (right->count > MIN_LEAF_KEYS)
+            {
+                // Первый ключ правого соседа переходит в конец узла
+                node->keys[node->count] = right->keys[0];
+                node->values[node->count] = std::move(right->values[0]);
+                node->count++;
+                std::move(right->keys + 1, right->keys + right->count, right->keys);
+                std::move(right->values + 1, right->values + right->count, right->values);
+                right->values[right->count - 1] = Value();
+                setCount(right, right->count - 1);
+                parent->keys[i] = right->keys[0];
+                return;
+            }
+        }
+        if (i > 0)
+        {
+            Leaf* left = static_cast<Leaf*>(parent->children[i - 1]);
+            if (left->count > MIN_LEAF_KEYS)
+            {
+                // Последний ключ левого соседа переходит в начало узла
+                std::move_backward(node->keys, node->keys + node->count, node->keys + node->count + 1);
+                std::move_backward(node->values, node->values + node->count, node->values + node->count + 1);
+                node->keys[0] = left->keys[left->count - 1];
+                node->values[0] = std::move(left->values[left->count - 1]);
+                node->count++;
+                left->values[left->count - 1] = Value();
+                setCount(left, left->count - 1);
+                parent->keys[i - 1] = node->keys[0];
+                return;
+            }
+        }
+        mergeLeaves(parent, i < parent->count ? i : i - 1);
+    }
+
+    // Правый лист children[i + 1] присоединяется к левому children[i]
+    void mergeLeaves(Inner* parent, int i)
+    {
+        Leaf* left = static_cast<Leaf*>(parent->children[i]);
+        Leaf* right = static_cast<Leaf*>(parent->children[i + 1]);
+        std::move(right->keys, right->keys + right->count, left->keys + left->count);
+        std::move(right->values, right->values + right->count, left->values + left->count);
+        left->count += right->count;
+        left->next = right->next;
+        removeFromInner(parent, i);
+        delete right;
+    }
+
+    void fixInner(Inner* parent, int i)
+    {
+        Inner* node = static_cast<Inner*>(parent->children[i]);
+        if (i < parent->count)
+        {
+            Inner* right = static_cast<Inner*>(parent->children[i + 1]);
+            if (right->count > MIN_INNER_KEYS)
+            {
+                // Разделитель спускается в узел, первый ключ соседа - в родителя
+                node->keys[node->count] = parent->keys[i];
+                node->children[node->count + 1] = right->children[0];
+                node->count++;
+                parent->keys[i] = right->keys[0];
+                std::move(right->keys + 1, right->keys + right->count, right->keys);
+                std::copy(right->children + 1, right->children + right->count + 1, right->children);
+                setCount(right, right->count - 1);
+                return;
+            }
+        }
+        if (i > 0)
+        {
+            Inner* left = static_cast<Inner*>(parent->children[i - 1]);
+            if (left->count > MIN_INNER_KEYS)
+            {
+                std::move_backward(node->keys, node->keys + node->count, node->keys + node->count + 1);
+                std::copy_backward(node->children, node->children + node->count + 1,
+                                   node->children + node->count + 2);
+                node->keys[0] = parent->keys[i - 1];
+                node->children[0] = left->children[left->count];
+                node->count++;
+                parent->keys[i - 1] = left->keys[left->count - 1];
+                setCount(left, left->count - 1);
+                return;
+            }
+        }
+        mergeInner(parent, i < parent->count ? i : i - 1);
+    }
+
+    // children[i + 1] присоединяется к children[i], разделитель спускается
+    void mergeInner(Inner* parent, int i)
+    {
+        Inner* left = static_cast<Inner*>(parent->children[i]);
+        Inner* right = static_cast<Inner*>(parent->children[i + 1]);
+        left->keys[left->count] = parent->keys[i];
+        std::move(right->keys, right->keys + right->count, left->keys + left->count + 1);
+        std::copy(right->children, right->children + right->count + 1, left->children + left->count + 1);
+        left->count += right->count + 1;
+        removeFromInner(parent, i);
+        delete right;
+    }
+
+    // Удалить разделитель keys[i] и ребёнка children[i + 1]
+    static void removeFromInner(Inner* node, int i)
+    {
+        std::move(node->keys + i + 1, node->keys + node->count, node->keys + i);
+        std::copy(node->children + i + 2, node->children + node->count + 1, node->children + i + 1);
+        setCount(node, node->count - 1);
+    }
+
+    // --------------------------------------------------------------------
+    // Массовая загрузка
+    // --------------------------------------------------------------------
+    // Предпоследний лист полон, последний недополнен: ключи делятся поровну
+    static void balanceLastLeaves(Leaf* prev, Leaf* last)
+    {
+        int total = prev->count + last->count;
+        int moveCount = total / 2 - last->count;
+        std::move_backward(last->keys, last->keys + last->count, last->keys + last->count + moveCount);
+        std::move_backward(last->values, last->values + last->count, last->values + last->count + moveCount);
+        std::move(prev->keys + prev->count - moveCount, prev->keys + prev->count, last->keys);
+        std::move(prev->values + prev->count - moveCount, prev->values + prev->count, last->values);
+        last->count += moveCount;
+        setCount(prev, prev->count - moveCount);
+    }
+
+    // Уровень из k = ceil(m / (SLOTS + 1)) внутренних узлов над m детьми;
+    // дети делятся поровну, поэтому в каждом узле не меньше SLOTS / 2 детей
+    static void buildInnerLevel(std::vector<Node*>& level, std::vector<Key>& minKeys)
+    {
+        std::size_t m = level.size();
+        std::size_t k = (m + SLOTS) / (SLOTS + 1);
+        std::vector<Node*> parents;
+        std::vector<Key> parentMinKeys;
+        parents.reserve(k);
+        parentMinKeys.reserve(k);
+        std::size_t next = 0;
+        try
+        {
+            for (std::size_t p = 0; p < k; p++)
+            {
+                std::size_t children = m / k + (p < m % k ? 1 : 0);
+                parents.push_back(new Inner());  // Место зарезервировано - не бросает
+                Inner* inner = static_cast<Inner*>(parents.back());
+                for (std::size_t c = 0; c < children; c++, next++)
+                {
+                    inner->children[c] = level[next];
+                    if (c > 0)
+                        inner->keys[c - 1] = minKeys[next];
+                }
+                inner->count = static_cast<int>(children) - 1;
+                parentMinKeys.push_back(minKeys[next - children]);
+            }
+        }
+        catch (...)
+        {
+            // Дети по-прежнему в level (их удалит bulkLoad) - удаляем только
+            // сами новые узлы, без поддеревьев
+            for (Node* node : parents)
+                delete static_cast<Inner*>(node);
+            throw;
+        }
+        level.swap(parents);
+        minKeys.swap(parentMinKeys);
+    }
+
+    static void destroySubtree(Node* node)
+    {
+        if (node == nullptr)
+            return;
+        if (node->leaf)
+        {
+            delete static_cast<Leaf*>(node);
+            return;
+        }
+        Inner* inner = static_cast<Inner*>(node);
+        for (int i = 0; i <= inner->count; i++)
+            destroySubtree(inner->children[i]);
+        delete inner;
+    }
+};
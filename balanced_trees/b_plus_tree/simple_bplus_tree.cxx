@@ -0,0 +1,76 @@
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "bplus_tree.h"
+
+// Пример: индекс "номер заказа -> сумма" на B+-дереве.
+// Узел 64 байта (16 ключей int) - чтобы на небольших данных было видно
+// несколько уровней; для реальных индексов - значение по умолчанию (256)
+int main()
+{
+    std::cout << "========================================" << std::endl;
+    std::cout << "  ТЕСТ: B+-дерево" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    using Index = BPlusTree<int, std::int64_t, std::less<int>, 64>;
+    std::cout << "Ключей в узле: " << Index::SLOTS << std::endl;
+
+    std::cout << "\n--- Массовая загрузка 1000 отсортированных пар ---" << std::endl;
+    std::vector<std::pair<int, std::int64_t>> orders;
+    for (int id = 0; id < 1000; id++)
+        orders.emplace_back(id * 10, id * 100);
+    Index index;
+    index.bulkLoad(orders.begin(), orders.end());
+    std::cout << "Размер: " << index.size() << ", высота: " << index.height() << std::endl;
+
+    std::cout << "\n--- Поиск ---" << std::endl;
+    for (int id : {420, 425})
+    {
+        const std::int64_t* amount = index.find(id);
+        std::cout << "Заказ " << id << ": ";
+        if (amount != nullptr)
+            std::cout << "сумма " << *amount << std::endl;
+        else
+            std::cout << "не найден" << std::endl;
+    }
+
+    std::cout << "\n--- Вставка и удаление ---" << std::endl;
+    std::cout << "insert(425): " << (index.insert(425, 4250) ? "вставлен" : "уже есть") << std::endl;
+    std::cout << "insert(420): " << (index.insert(420, 0) ? "вставлен" : "уже есть") << std::endl;
+    int removed = 0;
+    for (int id = 0; id < 5000; id += 20)
+        removed += index.erase(id);
+    std::cout << "Удалены заказы 0, 20, ..., 4980: " << removed << ", размер: " << index.size()
+              << ", высота: " << index.height() << std::endl;
+
+    std::cout << "\n--- Диапазонный запрос [400, 480] по связанным листьям ---" << std::endl;
+    for (auto it = index.lowerBound(400); it != index.end() && it.key() <= 480; ++it)
+        std::cout << it.key() << ":" << it.value() << " ";
+    std::cout << std::endl;
+
+    std::cout << "\n--- Ключи int64: метки времени в микросекундах ---" << std::endl;
+    // Поиск в узле - AVX2, если сборка с -march=native на процессоре с AVX2
+    BPlusTree<std::int64_t, int> events;
+    const std::int64_t start = 1700000000000000LL;
+    for (int i = 0; i < 10000; i++)
+        events.insert(start + std::int64_t(i) * 1000, i);
+    std::cout << "Размер: " << events.size() << ", высота: " << events.height() << std::endl;
+    std::cout << "Событие в start + 4 200 000: " << *events.find(start + 4200000)
+              << ", в start + 4 200 001: " << (events.find(start + 4200001) ? "есть" : "нет") << std::endl;
+#if defined(__AVX2__)
+    std::cout << "Поиск в узле: AVX2" << std::endl;
+#else
+    std::cout << "Поиск в узле: скалярный цикл (сборка без AVX2)" << std::endl;
+#endif
+
+    std::cout << "\n\n=== ВЫВОД ===" << std::endl;
+    std::cout << "B+-дерево:" << std::endl;
+    std::cout << "- Много ключей в узле размером в несколько кэш-линий" << std::endl;
+    std::cout << "- Высота O(log_B n), поиск в узле - SIMD-сравнения" << std::endl;
+    std::cout << "- Значения только в листьях, листья связаны в список" << std::endl;
+    std::cout << "- Массовая загрузка отсортированных данных за O(n)" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../../common/tree_map.h"
+
+// ========================================================================
+// ScapegoatMap<Key, Value, Compare, Allocator> - СЛОВАРЬ НА SCAPEGOAT-ДЕРЕВЕ
+// ========================================================================
+// Интерфейс - как у std::map (см. common/tree_map.h). Узлы не хранят
+// данных балансировки. Если новый лист оказался глубже log_{1/alpha}(n),
+// на пути к корню ищется "козёл отпущения" - первый предок, у которого
+// поддерево ребёнка больше alpha * размер поддерева предка, и его
+// поддерево перестраивается в идеально сбалансированное. После удалений,
+// когда n < alpha * (максимальный размер), перестраивается всё дерево.
+//
+// В отличие от учебного simple_scapegoat.cxx, размеры поддеревьев
+// считаются только при поиске козла отпущения (размер ребёнка уже
+// известен, считается лишь поддерево брата) - вставка O(log n)
+// амортизированно, а не O(n).
+// ========================================================================
+
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>, typename Augment = NoAugment>
+class ScapegoatMap
+    : public TreeMapBase<ScapegoatMap<Key, Value, Compare, Allocator, Augment>, Key, Value, Compare, Allocator,
+                         NoBalance, Augment>
+{
+protected:
+    using Base = TreeMapBase<ScapegoatMap, Key, Value, Compare, Allocator, NoBalance, Augment>;
+    using Node = typename Base::Node;
+    friend Base;
+
+    double alpha = 0.7;              // 0.5 < alpha < 1: меньше - ниже дерево, чаще перестройки
+    std::size_t maxSize = 0;         // Наибольший размер с последней полной перестройки
+    std::vector<Node*> rebuildBuffer;
+
+public:
+    using Base::Base;
+
+    explicit ScapegoatMap(double alphaValue, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : Base(comp, alloc), alpha(alphaValue)
+    {
+    }
+
+protected:
+    // Число узлов поддерева: обход по родительским указателям без стека
+    // (с Augment - готовый размер в узле)
+    static std::size_t subtreeSize(const Node* top)
+    {
+        if (top == nullptr)
+            return 0;
+        if constexpr (Base::AUGMENTED)
+            return top->size;
+        std::size_t size = 0;
+        const Node* node = top;
+        const Node* prev = top->parent;
+        while (node != top->parent)
+        {
+            const Node* next;
+            if (prev == node->parent)
+            {
+                size++;
+                next = node->left != nullptr ? node->left : (node->right != nullptr ? node->right : node->parent);
+            }
+            else if (prev == node->left && node->right != nullptr)
+                next = node->right;
+            else
+                next = node->parent;
+            prev = node;
+            node = next;
+        }
+        return size;
+    }
+
+    // Построение идеально сбалансированного дерева из rebuildBuffer[lo..hi]
+    Node* buildBalanced(std::ptrdiff_t lo, std::ptrdiff_t hi, Node* parent)
+    {
+        if (lo > hi)
+            return nullptr;
+        std::ptrdiff_t mid = lo + (hi - lo) / 2;
+        Node* node = rebuildBuffer[mid];
+        node->parent = parent;
+        node->left = buildBalanced(lo, mid - 1, node);
+        node->right = buildBalanced(mid + 1, hi, node);
+        Base::pull(node);
+        return node;
+    }
+
+    // Перестроить поддерево top из size узлов (узлы перевешиваются)
+    void rebuild(Node* top, std::size_t size)
+    {
+        rebuildBuffer.clear();
+        rebuildBuffer.reserve(size);
+        Node* node = treeMinimum(top);
+        for (std::size_t i = 0; i < size; i++)
+        {
+            rebuildBuffer.push_back(node);
+            node = treeSuccessor(node);
+        }
+        Node* parent = top->parent;
+        Node* newTop = buildBalanced(0, static_cast<std::ptrdiff_t>(size) - 1, parent);
+        this->replaceChild(parent, top, newTop);
+    }
+
+    void afterInsert(Node* node, int depth)
+    {
+        std::size_t size = this->nodeCount;
+        maxSize = std::max(maxSize, size);
+        if (depth <= std::log(static_cast<double>(size)) / std::log(1.0 / alpha))
+            return;
+        // Поднимаемся, пока поддерево ребёнка не окажется "слишком тяжёлым"
+        std::size_t childSize = 1;
+        Node* child = node;
+        for (Node* p = node->parent; p != nullptr; child = p, p = p->parent)
+        {
+            Node* sibling = p->left == child ? p->right : p->left;
+            std::size_t parentSize = childSize + 1 + subtreeSize(sibling);
+            if (childSize > alpha * parentSize)
+            {
+                rebuild(p, parentSize);
+                return;
+            }
+            childSize = parentSize;
+        }
+    }
+
+    void eraseNode(Node* node)
+    {
+        this->bstErase(node);
+        std::size_t size = this->nodeCount - 1;  // Счётчик уменьшается после eraseNode
+        if (size < alpha * maxSize)
+        {
+            if (size > 0)
+                rebuild(this->root, size);
+            maxSize = size;
+        }
+    }
+};
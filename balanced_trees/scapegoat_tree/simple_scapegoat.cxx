@@ -1,6 +1,8 @@
 #include <iostream>
 #include <vector>
 
+#include "../../common/trace.h"
+
 // Узел Scapegoat дерева
 struct ScapegoatNode
 {
@@ -12,11 +14,12 @@ struct ScapegoatNode
 };
 
 // Класс Scapegoat дерева
+template <typename Trace = NoTrace>
 class ScapegoatTree
 {
     ScapegoatNode* root;
     double alpha;      // Параметр балансировки (0.5 < alpha < 1)
-    bool verbose;
+    Trace verbose;
 
     // Подсчет размера поддерева
     int size(ScapegoatNode* node)
@@ -198,7 +201,7 @@ int main()
     std::cout << "  ТЕСТ: Scapegoat Tree" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    ScapegoatTree scapegoat(0.67, true);
+    ScapegoatTree<VerboseTrace> scapegoat(0.67, true);
     
     std::cout << "\n--- Вставка элементов ---" << std::endl;
     scapegoat.insert(50);
@@ -0,0 +1,461 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ========================================================================
+// ImplicitTreap<T> - ПОСЛЕДОВАТЕЛЬНОСТЬ НА ДЕКАРТОВОМ ДЕРЕВЕ С НЕЯВНЫМ
+// КЛЮЧОМ (rope)
+// ========================================================================
+// В simple_treap.cxx split и merge работают по ключу. Здесь ключа нет:
+// "ключ" узла - его позиция, то есть число элементов левее. Она не
+// хранится, а вычисляется по размерам поддеревьев, поэтому вставка в
+// середину не сдвигает остальные элементы.
+//
+//   split(t, k)   - первые k элементов и остальные: спуск по размерам
+//   merge(l, r)   - l целиком перед r: корень - узел с большим приоритетом
+//
+// Всё остальное - комбинации двух операций за ожидаемое O(log n):
+//   insert(pos, x)    = merge(merge(split(pos).left, x), split(pos).right)
+//   erase / cut       = три части, средняя удаляется или возвращается
+//   insert(pos, rope) и append - вклейка целой последовательности
+//
+// Ленивые метки. reverse(first, last) и add(first, last, delta) не
+// обходят диапазон: вырезанная средняя часть получает метку в корне, и
+// метка спускается к детям (push) только когда через узел идёт split или
+// merge. Метка в узле означает "узел уже изменён, детям ещё предстоит".
+// Чтение (at, forEach) меток не трогает, а накапливает их по пути вниз,
+// поэтому оно const.
+//
+// add доступен только для арифметических T: у других типов поле метки в
+// узле не хранится.
+// ========================================================================
+
+template <typename T, bool Arithmetic = std::is_arithmetic_v<T>>
+struct ImplicitTreapAddTag
+{
+    T pendingAdd{};
+};
+
+template <typename T>
+struct ImplicitTreapAddTag<T, false>
+{
+};
+
+template <typename T>
+class ImplicitTreap
+{
+    static constexpr bool HAS_ADD = std::is_arithmetic_v<T>;
+
+    struct Node : ImplicitTreapAddTag<T>
+    {
+        T value;
+        Node* left = nullptr;
+        Node* right = nullptr;
+        std::size_t size = 1;
+        std::uint32_t priority;
+        bool pendingReverse = false;
+
+        Node(const T& v, std::uint32_t p) : value(v), priority(p) {}
+        Node(T&& v, std::uint32_t p) : value(std::move(v)), priority(p) {}
+    };
+
+    Node* root = nullptr;
+    std::uint64_t priorityState = 0x2545F4914F6CDD1DULL;
+
+public:
+    ImplicitTreap() = default;
+
+    // Построение за O(n): узлы идут слева направо, правый край дерева -
+    // стек, новый узел забирает с него всех с меньшим приоритетом
+    template <typename InputIt>
+    ImplicitTreap(InputIt first, InputIt last)
+    {
+        std::vector<Node*> rightSpine;
+        for (; first != last; ++first)
+        {
+            Node* node = new Node(*first, nextPriority());
+            Node* lastPopped = nullptr;
+            while (!rightSpine.empty() && rightSpine.back()->priority < node->priority)
+            {
+                lastPopped = rightSpine.back();
+                rightSpine.pop_back();
+                update(lastPopped);
+            }
+            node->left = lastPopped;
+            if (!rightSpine.empty())
+                rightSpine.back()->right = node;
+            rightSpine.push_back(node);
+        }
+        // Корень - дно стека; размеры правого края считаются снизу вверх
+        if (!rightSpine.empty())
+            root = rightSpine.front();
+        while (!rightSpine.empty())
+        {
+            update(rightSpine.back());
+            rightSpine.pop_back();
+        }
+    }
+
+    ImplicitTreap(const ImplicitTreap& other) : root(clone(other.root)), priorityState(other.priorityState) {}
+
+    ImplicitTreap(ImplicitTreap&& other) noexcept
+        : root(std::exchange(other.root, nullptr)), priorityState(other.priorityState)
+    {
+    }
+
+    ImplicitTreap& operator=(ImplicitTreap other) noexcept
+    {
+        std::swap(root, other.root);
+        std::swap(priorityState, other.priorityState);
+        return *this;
+    }
+
+    ~ImplicitTreap() { destroy(root); }
+
+    std::size_t size() const { return sizeOf(root); }
+    bool empty() const { return root == nullptr; }
+
+    void clear()
+    {
+        destroy(root);
+        root = nullptr;
+    }
+
+    // --------------------------------------------------------------------
+    // Чтение
+    // --------------------------------------------------------------------
+    T at(std::size_t pos) const
+    {
+        checkIndex(pos, size());
+        const Node* node = root;
+        bool reversed = false;
+        T added{};
+        while (true)
+        {
+            const Node* left = reversed ? node->right : node->left;
+            const Node* right = reversed ? node->left : node->right;
+            std::size_t leftSize = sizeOf(left);
+            if (pos == leftSize)
+                return withAdd(node->value, added);
+            reversed ^= node->pendingReverse;
+            if constexpr (HAS_ADD)
+                added += node->pendingAdd;
+            if (pos < leftSize)
+                node = left;
+            else
+            {
+                pos -= leftSize + 1;
+                node = right;
+            }
+        }
+    }
+
+    T operator[](std::size_t pos) const { return at(pos); }
+
+    // visit(value) для всех элементов по порядку
+    template <typename Visit>
+    void forEach(Visit visit) const
+    {
+        struct Frame
+        {
+            const Node* node;
+            bool reversed;
+            T added;
+        };
+        std::vector<Frame> stack;
+        const Node* node = root;
+        bool reversed = false;
+        T added{};
+        while (node != nullptr || !stack.empty())
+        {
+            while (node != nullptr)
+            {
+                stack.push_back({node, reversed, added});
+                bool childReversed = reversed ^ node->pendingReverse;
+                T childAdded = added;
+                if constexpr (HAS_ADD)
+                    childAdded += node->pendingAdd;
+                node = reversed ? node->right : node->left;
+                reversed = childReversed;
+                added = childAdded;
+            }
+            Frame frame = stack.back();
+            stack.pop_back();
+            visit(withAdd(frame.node->value, frame.added));
+            reversed = frame.reversed ^ frame.node->pendingReverse;
+            added = frame.added;
+            if constexpr (HAS_ADD)
+                added += frame.node->pendingAdd;
+            node = frame.reversed ? frame.node->left : frame.node->right;
+        }
+    }
+
+    std::vector<T> toVector() const
+    {
+        std::vector<T> result;
+        result.reserve(size());
+        forEach([&](const T& value) { result.push_back(value); });
+        return result;
+    }
+
+    // --------------------------------------------------------------------
+    // Изменение (все позиции - с нуля, диапазоны - полуоткрытые)
+    // --------------------------------------------------------------------
+    void set(std::size_t pos, const T& value)
+    {
+        checkIndex(pos, size());
+        Node* node = root;
+        while (true)
+        {
+            push(node);
+            std::size_t leftSize = sizeOf(node->left);
+            if (pos == leftSize)
+            {
+                node->value = value;
+                return;
+            }
+            if (pos < leftSize)
+                node = node->left;
+            else
+            {
+                pos -= leftSize + 1;
+                node = node->right;
+            }
+        }
+    }
+
+    void insert(std::size_t pos, const T& value)
+    {
+        checkPosition(pos, size());
+        Node* node = new Node(value, nextPriority());
+        auto [left, right] = split(root, pos);
+        root = merge(merge(left, node), right);
+    }
+
+    void pushBack(const T& value) { root = merge(root, new Node(value, nextPriority())); }
+
+    // Вклеить всю other перед позицией pos (other становится пустой)
+    void insert(std::size_t pos, ImplicitTreap&& other)
+    {
+        checkPosition(pos, size());
+        if (&other == this)
+            return;
+        auto [left, right] = split(root, pos);
+        root = merge(merge(left, std::exchange(other.root, nullptr)), right);
+    }
+
+    // Конкатенация: other дописывается в конец
+    void append(ImplicitTreap&& other) { insert(size(), std::move(other)); }
+
+    void erase(std::size_t pos)
+    {
+        checkIndex(pos, size());
+        erase(pos, pos + 1);
+    }
+
+    void erase(std::size_t first, std::size_t last) { destroy(extract(first, last)); }
+
+    // Вырезать [first, last) в отдельную последовательность
+    ImplicitTreap cut(std::size_t first, std::size_t last)
+    {
+        ImplicitTreap result;
+        result.root = extract(first, last);
+        result.priorityState = priorityState ^ 0x9E3779B97F4A7C15ULL;
+        return result;
+    }
+
+    // Оставить первые pos элементов, остальные вернуть
+    ImplicitTreap splitAt(std::size_t pos) { return cut(pos, size()); }
+
+    void reverse(std::size_t first, std::size_t last)
+    {
+        withRange(first, last, [](Node* middle) { applyReverse(middle); });
+    }
+
+    // Прибавить delta ко всем элементам [first, last)
+    void add(std::size_t first, std::size_t last, const T& delta)
+    {
+        static_assert(HAS_ADD, "add доступен только для арифметических типов");
+        withRange(first, last, [&delta](Node* middle) { applyAdd(middle, delta); });
+    }
+
+    // Высота дерева - для проверки балансировки
+    int height() const { return heightOf(root); }
+
+private:
+    std::uint32_t nextPriority()
+    {
+        std::uint64_t z = (priorityState += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return static_cast<std::uint32_t>((z ^ (z >> 31)) >> 32);
+    }
+
+    static std::size_t sizeOf(const Node* node) { return node == nullptr ? 0 : node->size; }
+
+    static void update(Node* node) { node->size = 1 + sizeOf(node->left) + sizeOf(node->right); }
+
+    static T withAdd(const T& value, const T& added)
+    {
+        if constexpr (HAS_ADD)
+            return static_cast<T>(value + added);
+        else
+            return value;
+    }
+
+    // Метки применяются к узлу сразу, детям - откладываются
+    static void applyReverse(Node* node)
+    {
+        if (node == nullptr)
+            return;
+        std::swap(node->left, node->right);
+        node->pendingReverse = !node->pendingReverse;
+    }
+
+    static void applyAdd(Node* node, const T& delta)
+    {
+        if constexpr (HAS_ADD)
+        {
+            if (node == nullptr)
+                return;
+            node->value += delta;
+            node->pendingAdd += delta;
+        }
+    }
+
+    static void push(Node* node)
+    {
+        if (node->pendingReverse)
+        {
+            applyReverse(node->left);
+            applyReverse(node->right);
+            node->pendingReverse = false;
+        }
+        if constexpr (HAS_ADD)
+        {
+            if (node->pendingAdd != T())
+            {
+                applyAdd(node->left, node->pendingAdd);
+                applyAdd(node->right, node->pendingAdd);
+                node->pendingAdd = T();
+            }
+        }
+    }
+
+    // Первые count элементов - в first, остальные - в second
+    static std::pair<Node*, Node*> split(Node* node, std::size_t count)
+    {
+        if (node == nullptr)
+            return {nullptr, nullptr};
+        push(node);
+        std::size_t leftSize = sizeOf(node->left);
+        if (count <= leftSize)
+        {
+            auto [left, rest] = split(node->left, count);
+            node->left = rest;
+            update(node);
+            return {left, node};
+        }
+        auto [rest, right] = split(node->right, count - leftSize - 1);
+        node->right = rest;
+        update(node);
+        return {node, right};
+    }
+
+    static Node* merge(Node* left, Node* right)
+    {
+        if (left == nullptr)
+            return right;
+        if (right == nullptr)
+            return left;
+        if (left->priority > right->priority)
+        {
+            push(left);
+            left->right = merge(left->right, right);
+            update(left);
+            return left;
+        }
+        push(right);
+        right->left = merge(left, right->left);
+        update(right);
+        return right;
+    }
+
+    // Вынуть [first, last) из дерева
+    Node* extract(std::size_t first, std::size_t last)
+    {
+        checkRange(first, last, size());
+        auto [left, rest] = split(root, first);
+        auto [middle, right] = split(rest, last - first);
+        root = merge(left, right);
+        return middle;
+    }
+
+    template <typename Apply>
+    void withRange(std::size_t first, std::size_t last, Apply apply)
+    {
+        checkRange(first, last, size());
+        auto [left, rest] = split(root, first);
+        auto [middle, right] = split(rest, last - first);
+        apply(middle);
+        root = merge(merge(left, middle), right);
+    }
+
+    static void checkIndex(std::size_t pos, std::size_t count)
+    {
+        if (pos >= count)
+            throw std::out_of_range("ImplicitTreap: позиция за концом последовательности");
+    }
+
+    static void checkPosition(std::size_t pos, std::size_t count)
+    {
+        if (pos > count)
+            throw std::out_of_range("ImplicitTreap: позиция вставки за концом последовательности");
+    }
+
+    static void checkRange(std::size_t first, std::size_t last, std::size_t count)
+    {
+        if (first > last || last > count)
+            throw std::out_of_range("ImplicitTreap: неверный диапазон");
+    }
+
+    static Node* clone(const Node* node)
+    {
+        if (node == nullptr)
+            return nullptr;
+        Node* copy = new Node(*node);
+        copy->left = clone(node->left);
+        copy->right = clone(node->right);
+        return copy;
+    }
+
+    static void destroy(Node* node)
+    {
+        std::vector<Node*> stack;
+        if (node != nullptr)
+            stack.push_back(node);
+        while (!stack.empty())
+        {
+            node = stack.back();
+            stack.pop_back();
+            if (node->left != nullptr)
+                stack.push_back(node->left);
+            if (node->right != nullptr)
+                stack.push_back(node->right);
+            delete node;
+        }
+    }
+
+    static int heightOf(const Node* node)
+    {
+        if (node == nullptr)
+            return 0;
+        return 1 + std::max(heightOf(node->left), heightOf(node->right));
+    }
+};
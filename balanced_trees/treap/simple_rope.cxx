@@ -0,0 +1,73 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "implicit_treap.h"
+
+template <typename T>
+void printSequence(const std::string& title, const ImplicitTreap<T>& sequence)
+{
+    std::cout << title << ": ";
+    sequence.forEach([](const T& value) { std::cout << value << " "; });
+    std::cout << std::endl;
+}
+
+// Пример: буфер строк журнала, который правят в середине - вставка
+// блока, перенос фрагмента, разворот, сдвиг временных меток. Ни одна
+// операция не копирует хвост буфера, как это делал бы std::vector
+int main()
+{
+    std::cout << "========================================" << std::endl;
+    std::cout << "  ТЕСТ: декартово дерево с неявным ключом" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    std::cout << "\n--- Последовательность 0..9 ---" << std::endl;
+    std::vector<int> initial = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    ImplicitTreap<int> numbers(initial.begin(), initial.end());
+    printSequence("Исходная", numbers);
+
+    numbers.insert(3, 100);
+    printSequence("insert(3, 100)", numbers);
+
+    numbers.erase(0, 2);
+    printSequence("erase(0, 2)", numbers);
+
+    numbers.reverse(2, 7);
+    printSequence("reverse(2, 7)", numbers);
+
+    numbers.add(0, 4, 10);
+    printSequence("add(0, 4, 10)", numbers);
+
+    std::cout << "at(3) = " << numbers.at(3) << ", размер " << numbers.size() << std::endl;
+
+    std::cout << "\n--- Перенос фрагмента журнала ---" << std::endl;
+    ImplicitTreap<std::string> log;
+    for (const char* line : {"start", "connect", "request", "response", "disconnect", "stop"})
+        log.pushBack(line);
+    printSequence("Журнал", log);
+
+    ImplicitTreap<std::string> session = log.cut(1, 5);
+    printSequence("cut(1, 5)", session);
+    printSequence("Остаток", log);
+
+    log.insert(1, std::move(session));
+    printSequence("Вклеено обратно", log);
+
+    ImplicitTreap<std::string> tail;
+    tail.pushBack("restart");
+    log.append(std::move(tail));
+    printSequence("append", log);
+
+    std::cout << "\n--- Высота на 1 000 000 элементов ---" << std::endl;
+    std::vector<int> big(1000000);
+    ImplicitTreap<int> large(big.begin(), big.end());
+    std::cout << "Высота: " << large.height() << " (ожидаемо около 3 ln n = 41)" << std::endl;
+
+    std::cout << "\n\n=== ВЫВОД ===" << std::endl;
+    std::cout << "Декартово дерево с неявным ключом:" << std::endl;
+    std::cout << "- Позиция элемента - размер левого поддерева, ключи не хранятся" << std::endl;
+    std::cout << "- Вставка, удаление, вырезание и склейка - split/merge за O(log n)" << std::endl;
+    std::cout << "- Разворот и прибавление на отрезке - ленивые метки в корне отрезка" << std::endl;
+
+    return 0;
+}
@@ -2,6 +2,8 @@
 #include <cstdlib>
 #include <ctime>
 
+#include "../../common/trace.h"
+
 // Узел Treap (комбинация BST и кучи)
 struct TreapNode
 {
@@ -14,10 +16,11 @@ struct TreapNode
 };
 
 // Класс Treap
+template <typename Trace = NoTrace>
 class Treap
 {
     TreapNode* root;
-    bool verbose;
+    Trace verbose;
 
     // Разделение дерева на два по ключу
     void split(TreapNode* node, int key, TreapNode*& left, TreapNode*& right)
@@ -227,7 +230,7 @@ int main()
     std::cout << "  ТЕСТ: Treap (Декартово дерево)" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    Treap treap(true);
+    Treap<VerboseTrace> treap(true);
     
     std::cout << "\n--- Вставка элементов ---" << std::endl;
     treap.insert(50);
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "../../common/tree_join.h"
+
+// ========================================================================
+// TreapMap<Key, Value, Compare, Allocator> - СЛОВАРЬ НА ДЕКАРТОВОМ ДЕРЕВЕ
+// ========================================================================
+// Интерфейс - как у std::map (см. common/tree_map.h). По ключам - дерево
+// поиска, по случайным приоритетам - max-куча. Новый лист поднимается
+// поворотами, пока его приоритет больше родительского; удаляемый узел
+// опускается поворотами (наверх идёт ребёнок с большим приоритетом), пока
+// не станет листом или узлом с одним ребёнком. Ожидаемая высота O(log n).
+// Приоритеты - из SplitMix64 с фиксированным начальным значением, поэтому
+// форма дерева воспроизводима от запуска к запуску.
+//
+// Массовое построение, split / join, операции над множествами и пакетные
+// insertBatch / eraseBatch (в том числе параллельные) - из
+// common/tree_join.h; здесь только join по приоритетам.
+// ========================================================================
+
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>, typename Augment = NoAugment>
+class TreapMap
+    : public JoinableTreeMap<TreapMap<Key, Value, Compare, Allocator, Augment>, Key, Value, Compare, Allocator,
+                             std::uint32_t, Augment>
+{
+protected:
+    using Base = JoinableTreeMap<TreapMap, Key, Value, Compare, Allocator, std::uint32_t, Augment>;
+    using Node = typename Base::Node;
+    friend Base;
+    friend typename Base::MapBase;
+
+    std::uint64_t priorityState = 0x2545F4914F6CDD1DULL;
+
+public:
+    using Base::Base;
+
+protected:
+    std::uint32_t nextPriority()
+    {
+        std::uint64_t z = (priorityState += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return static_cast<std::uint32_t>((z ^ (z >> 31)) >> 32);
+    }
+
+    void afterInsert(Node* node, int)
+    {
+        node->balance = nextPriority();
+        while (node->parent != nullptr && node->parent->balance < node->balance)
+        {
+            if (node == node->parent->left)
+                this->rotateRight(node->parent);
+            else
+                this->rotateLeft(node->parent);
+        }
+    }
+
+    void eraseNode(Node* node)
+    {
+        while (node->left != nullptr && node->right != nullptr)
+        {
+            if (node->left->balance > node->right->balance)
+                this->rotateRight(node);
+            else
+                this->rotateLeft(node);
+        }
+        this->spliceOut(node);
+    }
+
+    // --------------------------------------------------------------------
+    // Join для common/tree_join.h
+    // --------------------------------------------------------------------
+    void prepareNode(Node* node) { node->balance = nextPriority(); }
+
+    // mid встаёт там, где его приоритет не меньше приоритетов корней:
+    // иначе спуск по правому краю left или левому краю right - у кого
+    // корень приоритетнее. Глубина спуска - ожидаемо O(log n); в split
+    // и bulkLoad mid обычно приоритетнее обоих и join стоит O(1)
+    Node* joinNodes(Node* left, Node* mid, Node* right)
+    {
+        bool leftAbove = left != nullptr && left->balance > mid->balance;
+        bool rightAbove = right != nullptr && right->balance > mid->balance;
+        if (!leftAbove && !rightAbove)
+            return Base::link(left, mid, right);
+        if (leftAbove && (!rightAbove || left->balance > right->balance))
+        {
+            Node* rest = left->right;
+            if (rest != nullptr)
+                rest->parent = nullptr;
+            Base::setRight(left, joinNodes(rest, mid, right));
+            return left;
+        }
+        Node* rest = right->left;
+        if (rest != nullptr)
+            rest->parent = nullptr;
+        Base::setLeft(right, joinNodes(left, mid, rest));
+        return right;
+    }
+};
@@ -0,0 +1,435 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// ========================================================================
+// ОБВЯЗКА БЕНЧМАРКОВ (в стиле Google Benchmark, без зависимостей)
+// ========================================================================
+// Бенчмарк - функция void(BenchmarkState&): подготовка данных, затем цикл
+//
+//   while (state.keepRunning())
+//   {
+//       ... измеряемая операция ...
+//   }
+//   state.setItemsProcessed(state.iterations() * n);
+//
+// keepRunning повторяет тело, пока не наберётся --min-time секунд (и не
+// меньше MIN_ITERATIONS раз). Подготовка выполняется один раз и в замер
+// не входит; pauseTiming / resumeTiming исключают части итерации.
+//
+// Каждый случай запускается в отдельном процессе (fork): пиковая память
+// (ru_maxrss) и состояние кучи одного случая не влияют на другие.
+// Аппаратные счётчики (циклы, инструкции, промахи кэша и предсказателя)
+// читаются через perf_event_open, если ядро разрешает (иначе пропускаются:
+// см. /proc/sys/kernel/perf_event_paranoid).
+//
+// Параметры командной строки:
+//   --filter=подстрока   только случаи, в имени которых она есть
+//   --min-time=секунды   (0.5) время замера одного случая
+//   --json=файл          результаты в JSON для отслеживания регрессий
+//   --list               только перечислить случаи
+// ========================================================================
+
+const std::int64_t MIN_ITERATIONS = 3;
+
+// Стек потока, в котором выполняется случай (память выделяется по мере использования)
+const std::size_t CASE_STACK_BYTES = std::size_t(1) << 30;
+
+// Не дать компилятору выбросить вычисление, результат которого не используется
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+// ------------------------------------------------------------------------
+// Аппаратные счётчики
+// ------------------------------------------------------------------------
+class PerfCounters
+{
+    struct Event
+    {
+        const char* name;
+        std::uint64_t config;
+    };
+
+    static constexpr int NUM_EVENTS = 4;
+    const Event events[NUM_EVENTS] = {
+        {"cycles", PERF_COUNT_HW_CPU_CYCLES},
+        {"instructions", PERF_COUNT_HW_INSTRUCTIONS},
+        {"cache_misses", PERF_COUNT_HW_CACHE_MISSES},
+        {"branch_misses", PERF_COUNT_HW_BRANCH_MISSES},
+    };
+    int fds[NUM_EVENTS] = {-1, -1, -1, -1};
+
+public:
+    // Открыть до создания рабочих потоков: inherit учитывает и их
+    PerfCounters()
+    {
+        for (int i = 0; i < NUM_EVENTS; i++)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = events[i].config;
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fds[i] = static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fds[i] < 0)
+            {
+                close();
+                return;
+            }
+        }
+    }
+
+    ~PerfCounters() { close(); }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return fds[0] >= 0; }
+
+    void close()
+    {
+        for (int& fd : fds)
+        {
+            if (fd >= 0)
+                ::close(fd);
+            fd = -1;
+        }
+    }
+
+    void reset()
+    {
+        for (int fd : fds)
+        {
+            if (fd >= 0)
+                ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        }
+    }
+
+    void enable(bool on)
+    {
+        for (int fd : fds)
+        {
+            if (fd >= 0)
+                ::ioctl(fd, on ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    void readInto(std::map<std::string, double>& out) const
+    {
+        for (int i = 0; i < NUM_EVENTS; i++)
+        {
+            std::uint64_t value = 0;
+            if (fds[i] >= 0 && ::read(fds[i], &value, sizeof(value)) == sizeof(value))
+                out[events[i].name] = static_cast<double>(value);
+        }
+    }
+};
+
+// ------------------------------------------------------------------------
+// Состояние одного случая
+// ------------------------------------------------------------------------
+class BenchmarkState
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<std::int64_t> arguments;
+    double minSeconds;
+    PerfCounters& perf;
+
+    std::int64_t iterationCount = 0;
+    std::int64_t items = 0;
+    bool started = false;
+    bool paused = false;
+    Clock::time_point resumedAt;
+    double elapsed = 0; // Секунды замеренного времени
+
+public:
+    std::map<std::string, double> counters; // Свои величины бенчмарка (попадают в отчёт)
+
+    BenchmarkState(std::vector<std::int64_t> args, double minTime, PerfCounters& counters)
+        : arguments(std::move(args)), minSeconds(minTime), perf(counters)
+    {
+    }
+
+    std::int64_t range(std::size_t i) const { return arguments.at(i); }
+
+    // true - выполнить ещё одну итерацию
+    bool keepRunning()
+    {
+        if (!started)
+        {
+            started = true;
+            perf.reset();
+            resumeTiming();
+            return true;
+        }
+        iterationCount++;
+        if (iterationCount >= MIN_ITERATIONS && elapsed + (paused ? 0 : secondsSinceResume()) >= minSeconds)
+        {
+            pauseTiming();
+            return false;
+        }
+        return true;
+    }
+
+    void pauseTiming()
+    {
+        if (paused)
+            return;
+        perf.enable(false);
+        elapsed += secondsSinceResume();
+        paused = true;
+    }
+
+    void resumeTiming()
+    {
+        paused = false;
+        resumedAt = Clock::now();
+        perf.enable(true);
+    }
+
+    void setItemsProcessed(std::int64_t n) { items = n; }
+
+    std::int64_t iterations() const { return iterationCount; }
+    std::int64_t itemsProcessed() const { return items; }
+    double seconds() const { return elapsed; }
+
+private:
+    double secondsSinceResume() const { return std::chrono::duration<double>(Clock::now() - resumedAt).count(); }
+};
+
+// ------------------------------------------------------------------------
+// Реестр и запуск
+// ------------------------------------------------------------------------
+class BenchmarkRegistry
+{
+    struct Case
+    {
+        std::string name;
+        std::function<void(BenchmarkState&)> body;
+        std::vector<std::int64_t> args;
+    };
+
+    std::vector<Case> cases;
+
+    static std::string jsonNumber(double value)
+    {
+        std::ostringstream s;
+        s << std::setprecision(10) << value;
+        return s.str();
+    }
+
+    // Выполняется в дочернем процессе: строка таблицы в stdout, объект JSON в fd
+    static void runCase(const Case& c, double minTime, int resultFd)
+    {
+        PerfCounters perf;
+        BenchmarkState state(c.args, minTime, perf);
+        // Учебные деревья рекурсивны (destroyTree по вырожденному пути
+        // глубиной n), поэтому случай выполняется в потоке с большим стеком
+        struct Job
+        {
+            const Case* c;
+            BenchmarkState* state;
+        } job{&c, &state};
+        pthread_attr_t attr;
+        ::pthread_attr_init(&attr);
+        ::pthread_attr_setstacksize(&attr, CASE_STACK_BYTES);
+        pthread_t thread;
+        ::pthread_create(&thread, &attr, [](void* arg) -> void* {
+            Job* j = static_cast<Job*>(arg);
+            j->c->body(*j->state);
+            return nullptr;
+        }, &job);
+        ::pthread_join(thread, nullptr);
+        ::pthread_attr_destroy(&attr);
+        perf.readInto(state.counters);
+
+        rusage usage;
+        ::getrusage(RUSAGE_SELF, &usage);
+        const double nsPerIteration = state.seconds() * 1e9 / std::max<std::int64_t>(1, state.iterations());
+        const double itemsPerSecond = state.seconds() > 0 ? state.itemsProcessed() / state.seconds() : 0;
+
+        std::ostringstream row;
+        row << std::left << std::setw(44) << c.name << std::right << std::setw(14) << std::fixed
+            << std::setprecision(0) << nsPerIteration << std::setw(10) << state.iterations() << std::setw(14)
+            << std::setprecision(3) << itemsPerSecond / 1e6 << std::setw(10) << usage.ru_maxrss / 1024;
+        if (state.itemsProcessed() > 0)
+            row << "   " << std::setprecision(1) << state.seconds() * 1e9 / state.itemsProcessed() << " ns/item";
+        auto ipc = state.counters.find("instructions");
+        auto cycles = state.counters.find("cycles");
+        if (ipc != state.counters.end() && cycles != state.counters.end() && cycles->second > 0)
+            row << "   IPC " << std::setprecision(2) << ipc->second / cycles->second;
+        std::cout << row.str() << std::endl;
+
+        std::ostringstream json;
+        json << "    {\n"
+             << "      \"name\": \"" << c.name << "\",\n"
+             << "      \"iterations\": " << state.iterations() << ",\n"
+             << "      \"real_time\": " << jsonNumber(nsPerIteration) << ",\n"
+             << "      \"time_unit\": \"ns\",\n"
+             << "      \"items_per_second\": " << jsonNumber(itemsPerSecond) << ",\n"
+             << "      \"peak_rss_kb\": " << usage.ru_maxrss;
+        for (const auto& kv : state.counters)
+            json << ",\n      \"" << kv.first << "\": " << jsonNumber(kv.second);
+        json << "\n    }";
+        std::string text = json.str();
+        const char* p = text.data();
+        std::size_t left = text.size();
+        while (left > 0)
+        {
+            ssize_t written = ::write(resultFd, p, left);
+            if (written <= 0)
+                break;
+            p += written;
+            left -= static_cast<std::size_t>(written);
+        }
+    }
+
+    // Запуск в дочернем процессе; пустая строка - случай завершился аварийно
+    static std::string runIsolated(const Case& c, double minTime)
+    {
+        int pipeFds[2];
+        if (::pipe(pipeFds) != 0)
+            return "";
+        std::cout.flush();
+        pid_t child = ::fork();
+        if (child == 0)
+        {
+            ::close(pipeFds[0]);
+            runCase(c, minTime, pipeFds[1]);
+            ::close(pipeFds[1]);
+            std::cout.flush();
+            ::_exit(0);
+        }
+        ::close(pipeFds[1]);
+        std::string result;
+        char buffer[4096];
+        ssize_t n;
+        while ((n = ::read(pipeFds[0], buffer, sizeof(buffer))) > 0)
+            result.append(buffer, static_cast<std::size_t>(n));
+        ::close(pipeFds[0]);
+        int status = 0;
+        ::waitpid(child, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            std::cout << std::left << std::setw(44) << c.name << " ОШИБКА (процесс завершился аварийно)" << std::endl;
+            return "";
+        }
+        return result;
+    }
+
+public:
+    // Случай name/arg0/arg1... для каждого набора аргументов
+    void add(const std::string& name, std::function<void(BenchmarkState&)> body,
+             const std::vector<std::vector<std::int64_t>>& argSets = {{}})
+    {
+        for (const auto& args : argSets)
+        {
+            std::string full = name;
+            for (std::int64_t a : args)
+                full += "/" + std::to_string(a);
+            cases.push_back({full, body, args});
+        }
+    }
+
+    int run(int argc, char* argv[])
+    {
+        std::string filter, jsonPath;
+        double minTime = 0.5;
+        bool listOnly = false;
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            if (arg.rfind("--filter=", 0) == 0)
+                filter = arg.substr(9);
+            else if (arg.rfind("--min-time=", 0) == 0)
+                minTime = std::atof(arg.c_str() + 11);
+            else if (arg.rfind("--json=", 0) == 0)
+                jsonPath = arg.substr(7);
+            else if (arg == "--list")
+                listOnly = true;
+            else
+            {
+                std::cerr << "Неизвестный параметр: " << arg
+                          << " (--filter=, --min-time=, --json=, --list)\n";
+                return 1;
+            }
+        }
+
+        {
+            PerfCounters probe;
+            std::cout << "Потоков: " << std::thread::hardware_concurrency() << ", аппаратные счётчики: "
+                      << (probe.available() ? "есть" : "недоступны") << "\n\n";
+        }
+        // Ширина колонок - пробелами: setw считает байты, а не буквы кириллицы
+        std::cout << std::left << std::setw(44) << "Benchmark"
+                  << "       нс/итер      итер       Мэлем/с   RSS, МБ\n"
+                  << std::string(92, '-') << "\n";
+
+        std::vector<std::string> results;
+        bool failed = false;
+        for (const Case& c : cases)
+        {
+            if (!filter.empty() && c.name.find(filter) == std::string::npos)
+                continue;
+            if (listOnly)
+            {
+                std::cout << c.name << "\n";
+                continue;
+            }
+            std::string json = runIsolated(c, minTime);
+            if (json.empty())
+                failed = true;
+            else
+                results.push_back(json);
+        }
+
+        if (!jsonPath.empty())
+        {
+            std::ofstream out(jsonPath);
+            char date[32];
+            std::time_t now = std::time(nullptr);
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+            PerfCounters probe;
+            out << "{\n  \"context\": {\n"
+                << "    \"date\": \"" << date << "\",\n"
+                << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+                << "    \"perf_counters\": " << (probe.available() ? "true" : "false") << ",\n"
+                << "    \"min_time\": " << minTime << "\n  },\n  \"benchmarks\": [\n";
+            for (std::size_t i = 0; i < results.size(); i++)
+                out << results[i] << (i + 1 < results.size() ? ",\n" : "\n");
+            out << "  ]\n}\n";
+            std::cout << "\nJSON: " << jsonPath << "\n";
+        }
+        return failed ? 1 : 0;
+    }
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// ========================================================================
+// ПОРЯДКИ КЛЮЧЕЙ ДЛЯ БЕНЧМАРКОВ СЛОВАРЕЙ И ДЕРЕВЬЕВ
+// ========================================================================
+//   random     - случайная перестановка 0..n-1
+//   sequential - по возрастанию (худший случай для несбалансированного BST)
+//   zipf       - запросы по закону Ципфа (s = 1): немногие ключи
+//                запрашиваются часто - здесь выигрывает splay-дерево
+// ========================================================================
+
+enum class KeyOrder
+{
+    Random,
+    Sequential,
+    Zipf
+};
+
+const char* keyOrderName(KeyOrder order)
+{
+    switch (order)
+    {
+    case KeyOrder::Random:     return "random";
+    case KeyOrder::Sequential: return "sequential";
+    default:                   return "zipf";
+    }
+}
+
+// n ключей из 0..n-1 в заданном порядке (seed фиксирован)
+std::vector<int> makeKeys(int n, KeyOrder order)
+{
+    std::vector<int> keys(n);
+    std::mt19937_64 rng(1);
+    if (order == KeyOrder::Zipf)
+    {
+        // Ранг r выбирается с вероятностью ~ 1/r; ранги - случайные ключи
+        std::vector<double> cdf(n);
+        double sum = 0;
+        for (int r = 0; r < n; r++)
+        {
+            sum += 1.0 / (r + 1);
+            cdf[r] = sum;
+        }
+        std::vector<int> keyOfRank(n);
+        std::iota(keyOfRank.begin(), keyOfRank.end(), 0);
+        std::shuffle(keyOfRank.begin(), keyOfRank.end(), rng);
+        std::uniform_real_distribution<double> u(0.0, sum);
+        for (int& k : keys)
+        {
+            int rank = static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), u(rng)) - cdf.begin());
+            k = keyOfRank[std::min(rank, n - 1)];
+        }
+        return keys;
+    }
+    std::iota(keys.begin(), keys.end(), 0);
+    if (order == KeyOrder::Random)
+        std::shuffle(keys.begin(), keys.end(), rng);
+    return keys;
+}
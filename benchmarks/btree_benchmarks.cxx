@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench_harness.h"
+#include "bench_keys.h"
+#include "../avl_tree/avl_map.h"
+#include "../red_black_tree/rbtree_map.h"
+#include "../balanced_trees/b_plus_tree/bplus_tree.h"
+
+// Учебные деревья - как в tree_benchmarks.cxx
+#define main simple_avl_main
+#include "../avl_tree/simple_avl.cxx"
+#undef main
+#define main simple_rbtree_main
+#include "../red_black_tree/simple_rbtree.cxx"
+#undef main
+
+// ========================================================================
+// БЕНЧМАРКИ B+-ДЕРЕВА ПРОТИВ БИНАРНЫХ ДЕРЕВЬЕВ
+// ========================================================================
+// Имя случая: дерево/операция/n, ключи int (случайная перестановка).
+//   bplus           - BPlusTree<int, int64> (узел 256 байт, 64 ключа)
+//   bplus64         - BPlusTree<int64, int64> (32 ключа, поиск в узле -
+//                     AVX2, если он включён; только insert и find)
+//   avl_map, rbtree_map - AVLMap / RBTreeMap<int, int64>
+//   avl, rbtree     - учебные AVLTree<> / RedBlackTree<> (только int)
+// Операции:
+//   insert    - построение из n ключей в случайном порядке
+//   bulk_load - построение из n отсортированных пар (только bplus)
+//   find      - n поисков в случайном порядке
+//   scan      - n / 16 запросов: первый ключ >= x и ещё 15 следующих
+// Элемент (items) - одна операция (для scan - один посещённый ключ).
+// ========================================================================
+
+using Sizes = std::vector<std::vector<std::int64_t>>;
+const Sizes BTREE_SIZES = {{1 << 16}, {1 << 20}, {1 << 22}};
+const int SCAN_LENGTH = 16;
+
+using BPlus = BPlusTree<int, std::int64_t>;
+using BPlus64 = BPlusTree<std::int64_t, std::int64_t>;
+
+template <typename Tree>
+constexpr bool IS_BPLUS = std::is_same_v<Tree, BPlus> || std::is_same_v<Tree, BPlus64>;
+
+// Единый способ наполнить, найти и просканировать для всех деревьев
+template <typename Tree>
+void insertKey(Tree& tree, int key)
+{
+    if constexpr (IS_BPLUS<Tree>)
+        tree.insert(key, std::int64_t(key));
+    else if constexpr (std::is_same_v<Tree, AVLTree<>> || std::is_same_v<Tree, RedBlackTree<>>)
+        tree.insert(key);
+    else
+        tree.try_emplace(key, key);
+}
+
+template <typename Tree>
+bool findKey(Tree& tree, int key)
+{
+    if constexpr (IS_BPLUS<Tree>)
+        return tree.find(key) != nullptr;
+    else if constexpr (std::is_same_v<Tree, AVLTree<>> || std::is_same_v<Tree, RedBlackTree<>>)
+        return tree.search(key);
+    else
+        return tree.find(key) != tree.end();
+}
+
+template <typename Tree>
+std::int64_t scanFrom(Tree& tree, int start)
+{
+    std::int64_t sum = 0;
+    if constexpr (std::is_same_v<Tree, BPlus>)
+    {
+        auto it = tree.lowerBound(start);
+        for (int i = 0; i < SCAN_LENGTH && it != tree.end(); i++, ++it)
+            sum += it.value();
+    }
+    else
+    {
+        auto it = tree.lower_bound(start);
+        for (int i = 0; i < SCAN_LENGTH && it != tree.end(); i++, ++it)
+            sum += it->second;
+    }
+    return sum;
+}
+
+template <typename Tree>
+void addInsertFind(BenchmarkRegistry& registry, const std::string& name)
+{
+    registry.add(name + "/insert", [](BenchmarkState& state) {
+        const std::vector<int> keys = makeKeys(static_cast<int>(state.range(0)), KeyOrder::Random);
+        while (state.keepRunning())
+        {
+            auto tree = std::make_unique<Tree>();
+            for (int k : keys)
+                insertKey(*tree, k);
+            state.pauseTiming();
+            tree.reset();
+            state.resumeTiming();
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+    }, BTREE_SIZES);
+
+    registry.add(name + "/find", [](BenchmarkState& state) {
+        const int n = static_cast<int>(state.range(0));
+        Tree tree;
+        for (int k : makeKeys(n, KeyOrder::Random))
+            insertKey(tree, k);
+        std::vector<int> queries = makeKeys(n, KeyOrder::Random);
+        std::reverse(queries.begin(), queries.end());
+        while (state.keepRunning())
+        {
+            int found = 0;
+            for (int k : queries)
+                found += findKey(tree, k);
+            doNotOptimize(found);
+        }
+        state.setItemsProcessed(state.iterations() * n);
+    }, BTREE_SIZES);
+}
+
+template <typename Tree>
+void addScan(BenchmarkRegistry& registry, const std::string& name)
+{
+    registry.add(name + "/scan", [](BenchmarkState& state) {
+        const int n = static_cast<int>(state.range(0));
+        Tree tree;
+        for (int k : makeKeys(n, KeyOrder::Random))
+            insertKey(tree, k);
+        std::vector<int> starts = makeKeys(n, KeyOrder::Random);
+        starts.resize(n / SCAN_LENGTH);
+        while (state.keepRunning())
+        {
+            std::int64_t sum = 0;
+            for (int start : starts)
+                sum += scanFrom(tree, start);
+            doNotOptimize(sum);
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::int64_t>(starts.size()) * SCAN_LENGTH);
+    }, BTREE_SIZES);
+}
+
+void addBulkLoad(BenchmarkRegistry& registry)
+{
+    registry.add("bplus/bulk_load", [](BenchmarkState& state) {
+        const int n = static_cast<int>(state.range(0));
+        std::vector<std::pair<int, std::int64_t>> items;
+        items.reserve(n);
+        for (int k = 0; k < n; k++)
+            items.emplace_back(k, k);
+        while (state.keepRunning())
+        {
+            auto tree = std::make_unique<BPlus>();
+            tree->bulkLoad(items.begin(), items.end());
+            state.pauseTiming();
+            state.counters["height"] = tree->height();
+            tree.reset();
+            state.resumeTiming();
+        }
+        state.setItemsProcessed(state.iterations() * n);
+    }, BTREE_SIZES);
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkRegistry registry;
+    addInsertFind<BPlus>(registry, "bplus");
+    addBulkLoad(registry);
+    addScan<BPlus>(registry, "bplus");
+    addInsertFind<BPlus64>(registry, "bplus64");
+    addInsertFind<AVLMap<int, std::int64_t>>(registry, "avl_map");
+    addScan<AVLMap<int, std::int64_t>>(registry, "avl_map");
+    addInsertFind<RBTreeMap<int, std::int64_t>>(registry, "rbtree_map");
+    addScan<RBTreeMap<int, std::int64_t>>(registry, "rbtree_map");
+    addInsertFind<AVLTree<>>(registry, "avl");
+    addInsertFind<RedBlackTree<>>(registry, "rbtree");
+    return registry.run(argc, argv);
+}
@@ -0,0 +1,117 @@
+#include <string>
+#include <vector>
+
+#include "bench_harness.h"
+#include "../graph_common/csr_graph.h"
+#include "../graph_common/stream_generators.h"
+#include "../graph_common/thread_pool.h"
+#include "../bfs/csr_bfs.h"
+#include "../bfs/parallel_bfs.h"
+#include "../dfs/csr_dfs.h"
+#include "../dijkstra/csr_dijkstra.h"
+#include "../dijkstra/delta_stepping.h"
+#include "../prim/csr_prim.h"
+#include "../kruskal/filter_kruskal.h"
+#include "../boruvka/parallel_boruvka.h"
+#include "../floyd_warshall/parallel_apsp.h"
+
+// ========================================================================
+// БЕНЧМАРКИ ГРАФОВЫХ АЛГОРИТМОВ
+// ========================================================================
+// Имя случая: алгоритм/распределение/logV. Распределения (потоковые
+// генераторы graph_common/stream_generators.h, seed = 1):
+//   grid - дорожная решётка (большой диаметр, степень 4)
+//   rmat - Kronecker-граф Graph500 (степенное распределение степеней)
+//   er   - Эрдёш-Реньи, средняя степень 16
+//   geo  - случайный геометрический граф, средняя степень 8
+// Все графы неориентированные, веса [1, 255] (у решётки и геометрического -
+// длины рёбер). Элемент (items) - запись CSR: Мэлем/с = млн рёбер в секунду.
+// ========================================================================
+
+struct TestGraph
+{
+    std::vector<WeightedEdge> edges; // Каждое ребро один раз
+    CSRGraph graph;
+};
+
+TestGraph makeGraph(const std::string& distribution, int logV, ThreadPool& pool)
+{
+    EdgeList list;
+    if (distribution == "grid")
+        list = collectEdges(GridStream(1 << (logV / 2), 1), pool);
+    else if (distribution == "rmat")
+        list = collectEdges(RMATStream(logV, 8, 1, 255, true), pool);
+    else if (distribution == "er")
+        list = collectEdges(ErdosRenyiStream(1 << logV, 8LL << logV, 1, 255), pool);
+    else
+        list = collectEdges(GeometricStream(1 << logV, 8, 1), pool);
+
+    TestGraph result;
+    result.graph = CSRGraph::fromEdgeList(list.vertexCount, list.edges, true);
+    result.edges = std::move(list.edges);
+    return result;
+}
+
+const std::vector<std::string> DISTRIBUTIONS = {"grid", "rmat", "er", "geo"};
+const std::vector<std::vector<std::int64_t>> SIZES = {{14}, {18}};
+
+// Бенчмарк алгоритма на CSR: run(граф, pool, state) выполняется в цикле замера
+template <typename Run>
+void addGraphBenchmark(BenchmarkRegistry& registry, const std::string& name, Run run,
+                       const std::vector<std::vector<std::int64_t>>& sizes = SIZES)
+{
+    for (const std::string& distribution : DISTRIBUTIONS)
+    {
+        registry.add(name + "/" + distribution, [=](BenchmarkState& state) {
+            ThreadPool pool;
+            TestGraph t = makeGraph(distribution, static_cast<int>(state.range(0)), pool);
+            while (state.keepRunning())
+            {
+                run(t, pool, state);
+            }
+            state.setItemsProcessed(state.iterations() * t.graph.edgeCount());
+            state.counters["vertices"] = t.graph.vertexCount();
+            state.counters["edges"] = static_cast<double>(t.graph.edgeCount());
+        }, sizes);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkRegistry registry;
+
+    addGraphBenchmark(registry, "bfs", [](TestGraph& t, ThreadPool&, BenchmarkState&) {
+        doNotOptimize(csrBFS(t.graph, 0));
+    });
+    addGraphBenchmark(registry, "parallel_bfs", [](TestGraph& t, ThreadPool& pool, BenchmarkState&) {
+        doNotOptimize(parallelBFS(t.graph, 0, pool));
+    });
+    addGraphBenchmark(registry, "dfs", [](TestGraph& t, ThreadPool&, BenchmarkState&) {
+        doNotOptimize(csrDFS(t.graph, 0));
+    });
+    addGraphBenchmark(registry, "dijkstra", [](TestGraph& t, ThreadPool&, BenchmarkState&) {
+        doNotOptimize(csrDijkstra(t.graph, 0, DijkstraQueue::Auto));
+    });
+    addGraphBenchmark(registry, "delta_stepping", [](TestGraph& t, ThreadPool& pool, BenchmarkState&) {
+        doNotOptimize(deltaStepping(t.graph, 0, pool));
+    });
+    addGraphBenchmark(registry, "prim", [](TestGraph& t, ThreadPool&, BenchmarkState&) {
+        doNotOptimize(csrPrim(t.graph, 0, PrimQueue::Auto));
+    });
+    // Filter-Kruskal переставляет рёбра: каждой итерации - свежая копия
+    addGraphBenchmark(registry, "kruskal", [](TestGraph& t, ThreadPool& pool, BenchmarkState& state) {
+        state.pauseTiming();
+        std::vector<WeightedEdge> edges = t.edges;
+        state.resumeTiming();
+        doNotOptimize(filterKruskal(t.graph.vertexCount(), edges, pool));
+    });
+    addGraphBenchmark(registry, "boruvka", [](TestGraph& t, ThreadPool& pool, BenchmarkState&) {
+        doNotOptimize(parallelBoruvka(t.graph.vertexCount(), t.edges, pool));
+    });
+    // Матрица V x V: только небольшие графы
+    addGraphBenchmark(registry, "apsp", [](TestGraph& t, ThreadPool& pool, BenchmarkState&) {
+        doNotOptimize(parallelAPSP(t.graph, pool));
+    }, {{8}, {10}});
+
+    return registry.run(argc, argv);
+}
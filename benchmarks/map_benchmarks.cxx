@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench_harness.h"
+#include "bench_keys.h"
+#include "../avl_tree/avl_map.h"
+#include "../red_black_tree/rbtree_map.h"
+#include "../splay_tree/splay_map.h"
+#include "../balanced_trees/aa_tree/aa_map.h"
+#include "../balanced_trees/scapegoat_tree/scapegoat_map.h"
+#include "../balanced_trees/treap/treap_map.h"
+
+// ========================================================================
+// БЕНЧМАРКИ УПОРЯДОЧЕННЫХ СЛОВАРЕЙ ПРОТИВ std::map
+// ========================================================================
+// Имя случая: словарь/операция/порядок/n. Все словари - int -> int64,
+// одинаковый интерфейс (common/tree_map.h), поэтому код случая общий.
+//   insert - построение словаря из n ключей (освобождение вне замера)
+//   find   - n поисков в словаре из n ключей
+//   scan   - n / 16 диапазонных запросов: lower_bound и 16 шагов итератора
+//   erase  - удаление всех n ключей в случайном порядке
+// Порядки ключей (random, sequential, zipf) - bench_keys.h.
+// Элемент (items) - одна операция (для scan - один посещённый элемент).
+// ========================================================================
+
+using Sizes = std::vector<std::vector<std::int64_t>>;
+const Sizes MAP_SIZES = {{1 << 10}, {1 << 16}, {1 << 20}};
+const int SCAN_LENGTH = 16;
+
+template <typename Map>
+void fillMap(Map& map, const std::vector<int>& keys)
+{
+    for (int k : keys)
+        map.try_emplace(k, k);
+}
+
+template <typename Map>
+void addMapBenchmarks(BenchmarkRegistry& registry, const std::string& name)
+{
+    for (KeyOrder order : {KeyOrder::Random, KeyOrder::Sequential})
+    {
+        registry.add(name + "/insert/" + keyOrderName(order), [order](BenchmarkState& state) {
+            const std::vector<int> keys = makeKeys(static_cast<int>(state.range(0)), order);
+            while (state.keepRunning())
+            {
+                auto map = std::make_unique<Map>();
+                fillMap(*map, keys);
+                state.pauseTiming();
+                map.reset();
+                state.resumeTiming();
+            }
+            state.setItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+        }, MAP_SIZES);
+    }
+
+    for (KeyOrder order : {KeyOrder::Random, KeyOrder::Zipf})
+    {
+        registry.add(name + "/find/" + keyOrderName(order), [order](BenchmarkState& state) {
+            const int n = static_cast<int>(state.range(0));
+            Map map;
+            fillMap(map, makeKeys(n, KeyOrder::Random));
+            const std::vector<int> queries = makeKeys(n, order);
+            while (state.keepRunning())
+            {
+                std::int64_t sum = 0;
+                for (int k : queries)
+                {
+                    auto it = map.find(k);
+                    if (it != map.end())
+                        sum += it->second;
+                }
+                doNotOptimize(sum);
+            }
+            state.setItemsProcessed(state.iterations() * n);
+        }, MAP_SIZES);
+    }
+
+    registry.add(name + "/scan/random", [](BenchmarkState& state) {
+        const int n = static_cast<int>(state.range(0));
+        Map map;
+        fillMap(map, makeKeys(n, KeyOrder::Random));
+        std::vector<int> starts = makeKeys(n, KeyOrder::Random);
+        starts.resize(n / SCAN_LENGTH);
+        while (state.keepRunning())
+        {
+            std::int64_t sum = 0;
+            for (int start : starts)
+            {
+                auto it = map.lower_bound(start);
+                for (int i = 0; i < SCAN_LENGTH && it != map.end(); i++, ++it)
+                    sum += it->second;
+            }
+            doNotOptimize(sum);
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::int64_t>(starts.size()) * SCAN_LENGTH);
+    }, MAP_SIZES);
+
+    registry.add(name + "/erase/random", [](BenchmarkState& state) {
+        const int n = static_cast<int>(state.range(0));
+        const std::vector<int> keys = makeKeys(n, KeyOrder::Random);
+        std::vector<int> victims = keys;
+        std::reverse(victims.begin(), victims.end());
+        while (state.keepRunning())
+        {
+            state.pauseTiming();
+            auto map = std::make_unique<Map>();
+            fillMap(*map, keys);
+            state.resumeTiming();
+            for (int k : victims)
+                map->erase(k);
+        }
+        state.setItemsProcessed(state.iterations() * n);
+    }, MAP_SIZES);
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkRegistry registry;
+    addMapBenchmarks<std::map<int, std::int64_t>>(registry, "std_map");
+    addMapBenchmarks<AVLMap<int, std::int64_t>>(registry, "avl");
+    addMapBenchmarks<RBTreeMap<int, std::int64_t>>(registry, "rbtree");
+    addMapBenchmarks<SplayMap<int, std::int64_t>>(registry, "splay");
+    addMapBenchmarks<AAMap<int, std::int64_t>>(registry, "aa");
+    addMapBenchmarks<ScapegoatMap<int, std::int64_t>>(registry, "scapegoat");
+    addMapBenchmarks<TreapMap<int, std::int64_t>>(registry, "treap");
+    return registry.run(argc, argv);
+}
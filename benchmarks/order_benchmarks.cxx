@@ -0,0 +1,150 @@
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench_harness.h"
+#include "bench_keys.h"
+#include "../avl_tree/avl_map.h"
+#include "../red_black_tree/rbtree_map.h"
+#include "../balanced_trees/aa_tree/aa_map.h"
+#include "../balanced_trees/treap/treap_map.h"
+
+// ========================================================================
+// БЕНЧМАРКИ ПОРЯДКОВЫХ СТАТИСТИК И СВОДОК (Augment в common/tree_map.h)
+// ========================================================================
+// Имя случая: словарь/операция/способ/n, ключи int (случайная перестановка).
+//   insert/plain, insert/augmented - построение словаря без и с
+//                        ValueSum<int64> (цена пересчёта размеров и сумм)
+//   rank/walk          - std::distance(begin(), lower_bound(x)): O(n)
+//   rank/augmented     - rank(x): O(log n)
+//   select/walk        - std::next(begin(), k)
+//   select/augmented   - select(k)
+//   sum/walk           - сумма значений с ключами из [x, x + n / 8) обходом
+//   sum/augmented      - aggregate(x, x + n / 8)
+// Способ walk - O(n) на запрос, поэтому только n = 2^16 и WALK_QUERIES
+// запросов за итерацию. Элемент (items) - вставка или запрос.
+// ========================================================================
+
+using Sizes = std::vector<std::vector<std::int64_t>>;
+const Sizes ORDER_SIZES = {{1 << 16}, {1 << 20}};
+const Sizes WALK_SIZES = {{1 << 16}};
+const int QUERIES = 256;
+const int WALK_QUERIES = 16;
+
+template <template <typename, typename, typename, typename, typename> class Tree, typename Augment>
+using OrderMap = Tree<int, std::int64_t, std::less<int>, std::allocator<std::pair<const int, std::int64_t>>, Augment>;
+
+template <typename Map>
+void fill(Map& map, int n)
+{
+    for (int k : makeKeys(n, KeyOrder::Random))
+        map.try_emplace(k, k % 1000);
+}
+
+template <template <typename, typename, typename, typename, typename> class Tree>
+void addOrderBenchmarks(BenchmarkRegistry& registry, const std::string& name)
+{
+    using Plain = OrderMap<Tree, NoAugment>;
+    using Augmented = OrderMap<Tree, ValueSum<std::int64_t>>;
+
+    registry.add(name + "/insert/plain", [](BenchmarkState& state) {
+        const int n = static_cast<int>(state.range(0));
+        while (state.keepRunning())
+        {
+            auto map = std::make_unique<Plain>();
+            fill(*map, n);
+            state.pauseTiming();
+            map.reset();
+            state.resumeTiming();
+        }
+        state.setItemsProcessed(state.iterations() * n);
+    }, ORDER_SIZES);
+
+    registry.add(name + "/insert/augmented", [](BenchmarkState& state) {
+        const int n = static_cast<int>(state.range(0));
+        while (state.keepRunning())
+        {
+            auto map = std::make_unique<Augmented>();
+            fill(*map, n);
+            state.pauseTiming();
+            map.reset();
+            state.resumeTiming();
+        }
+        state.setItemsProcessed(state.iterations() * n);
+    }, ORDER_SIZES);
+
+    for (bool augmented : {false, true})
+    {
+        const std::string way = augmented ? "/augmented" : "/walk";
+        const Sizes& sizes = augmented ? ORDER_SIZES : WALK_SIZES;
+        const int queryCount = augmented ? QUERIES : WALK_QUERIES;
+        registry.add(name + "/rank" + way, [augmented, queryCount](BenchmarkState& state) {
+            const int n = static_cast<int>(state.range(0));
+            Augmented map;
+            fill(map, n);
+            std::vector<int> queries = makeKeys(n, KeyOrder::Random);
+            queries.resize(queryCount);
+            while (state.keepRunning())
+            {
+                std::size_t total = 0;
+                for (int q : queries)
+                    total += augmented ? map.rank(q)
+                                       : static_cast<std::size_t>(std::distance(map.begin(), map.lower_bound(q)));
+                doNotOptimize(total);
+            }
+            state.setItemsProcessed(state.iterations() * queryCount);
+        }, sizes);
+
+        registry.add(name + "/select" + way, [augmented, queryCount](BenchmarkState& state) {
+            const int n = static_cast<int>(state.range(0));
+            Augmented map;
+            fill(map, n);
+            std::vector<int> queries = makeKeys(n, KeyOrder::Random);
+            queries.resize(queryCount);
+            while (state.keepRunning())
+            {
+                std::int64_t total = 0;
+                for (int q : queries)
+                    total += augmented ? map.select(q)->first : std::next(map.begin(), q)->first;
+                doNotOptimize(total);
+            }
+            state.setItemsProcessed(state.iterations() * queryCount);
+        }, sizes);
+
+        registry.add(name + "/sum" + way, [augmented, queryCount](BenchmarkState& state) {
+            const int n = static_cast<int>(state.range(0));
+            Augmented map;
+            fill(map, n);
+            std::vector<int> queries = makeKeys(n, KeyOrder::Random);
+            queries.resize(queryCount);
+            while (state.keepRunning())
+            {
+                std::int64_t total = 0;
+                for (int q : queries)
+                {
+                    if (augmented)
+                        total += map.aggregate(q, q + n / 8);
+                    else
+                    {
+                        for (auto it = map.lower_bound(q); it != map.end() && it->first < q + n / 8; ++it)
+                            total += it->second;
+                    }
+                }
+                doNotOptimize(total);
+            }
+            state.setItemsProcessed(state.iterations() * queryCount);
+        }, sizes);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkRegistry registry;
+    addOrderBenchmarks<AVLMap>(registry, "avl");
+    addOrderBenchmarks<RBTreeMap>(registry, "rbtree");
+    addOrderBenchmarks<AAMap>(registry, "aa");
+    addOrderBenchmarks<TreapMap>(registry, "treap");
+    return registry.run(argc, argv);
+}
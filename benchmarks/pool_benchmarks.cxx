@@ -0,0 +1,107 @@
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench_harness.h"
+#include "bench_keys.h"
+#include "../common/node_pool.h"
+#include "../avl_tree/avl_map.h"
+#include "../red_black_tree/rbtree_map.h"
+#include "../splay_tree/splay_map.h"
+#include "../balanced_trees/aa_tree/aa_map.h"
+#include "../balanced_trees/scapegoat_tree/scapegoat_map.h"
+#include "../balanced_trees/treap/treap_map.h"
+
+// ========================================================================
+// БЕНЧМАРКИ ПУЛА УЗЛОВ: PoolAllocator ПРОТИВ ГЛОБАЛЬНОГО РАСПРЕДЕЛИТЕЛЯ
+// ========================================================================
+// Имя случая: словарь/распределитель/операция/n, распределитель -
+// global (std::allocator) или pool (PoolAllocator, common/node_pool.h).
+//   insert  - построение словаря из n случайных ключей
+//   churn   - в словаре n ключей; n раз удалить самый старый ключ и
+//             вставить новый (скользящее окно по 2n случайным ключам)
+//   destroy - уничтожение словаря из n ключей (построение вне замера);
+//             с пулом словари из tree_map.h отдают слябы без обхода
+// Элемент (items) - одна операция (для churn - пара удаление + вставка).
+// ========================================================================
+
+using Sizes = std::vector<std::vector<std::int64_t>>;
+const Sizes POOL_SIZES = {{1 << 10}, {1 << 16}, {1 << 20}};
+
+using Pair = std::pair<const int, std::int64_t>;
+
+template <typename Map>
+void addPoolBenchmarks(BenchmarkRegistry& registry, const std::string& name)
+{
+    registry.add(name + "/insert", [](BenchmarkState& state) {
+        const std::vector<int> keys = makeKeys(static_cast<int>(state.range(0)), KeyOrder::Random);
+        while (state.keepRunning())
+        {
+            auto map = std::make_unique<Map>();
+            for (int k : keys)
+                map->try_emplace(k, k);
+            state.pauseTiming();
+            map.reset();
+            state.resumeTiming();
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+    }, POOL_SIZES);
+
+    registry.add(name + "/churn", [](BenchmarkState& state) {
+        const int n = static_cast<int>(state.range(0));
+        const std::vector<int> keys = makeKeys(2 * n, KeyOrder::Random);
+        Map map;
+        for (int i = 0; i < n; i++)
+            map.try_emplace(keys[i], keys[i]);
+        int oldest = 0;  // Окно живых ключей: keys[oldest .. oldest + n) по модулю 2n
+        while (state.keepRunning())
+        {
+            for (int i = 0; i < n; i++)
+            {
+                map.erase(keys[oldest]);
+                int fresh = keys[(oldest + n) % (2 * n)];
+                map.try_emplace(fresh, fresh);
+                oldest = (oldest + 1) % (2 * n);
+            }
+        }
+        state.setItemsProcessed(state.iterations() * n);
+    }, POOL_SIZES);
+
+    registry.add(name + "/destroy", [](BenchmarkState& state) {
+        const std::vector<int> keys = makeKeys(static_cast<int>(state.range(0)), KeyOrder::Random);
+        while (state.keepRunning())
+        {
+            state.pauseTiming();
+            auto map = std::make_unique<Map>();
+            for (int k : keys)
+                map->try_emplace(k, k);
+            state.resumeTiming();
+            map.reset();
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+    }, POOL_SIZES);
+}
+
+// Оба варианта словаря: с глобальным распределителем и с пулом
+template <template <typename, typename, typename, typename> class Map>
+void addMapPair(BenchmarkRegistry& registry, const std::string& name)
+{
+    addPoolBenchmarks<Map<int, std::int64_t, std::less<int>, std::allocator<Pair>>>(registry, name + "/global");
+    addPoolBenchmarks<Map<int, std::int64_t, std::less<int>, PoolAllocator<Pair>>>(registry, name + "/pool");
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkRegistry registry;
+    addMapPair<std::map>(registry, "std_map");
+    addMapPair<AVLMap>(registry, "avl");
+    addMapPair<RBTreeMap>(registry, "rbtree");
+    addMapPair<SplayMap>(registry, "splay");
+    addMapPair<AAMap>(registry, "aa");
+    addMapPair<ScapegoatMap>(registry, "scapegoat");
+    addMapPair<TreapMap>(registry, "treap");
+    return registry.run(argc, argv);
+}
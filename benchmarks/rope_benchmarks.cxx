@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_harness.h"
+#include "../balanced_trees/treap/implicit_treap.h"
+
+// ========================================================================
+// БЕНЧМАРКИ ПРАВКИ ПОСЛЕДОВАТЕЛЬНОСТИ: ImplicitTreap ПРОТИВ std::vector
+// ========================================================================
+// Имя случая: структура/операция/n, последовательность из n чисел int.
+// За итерацию выполняется EDITS правок в случайных местах; размер
+// последовательности между правками не меняется.
+//   edit       - вставка элемента и удаление элемента
+//   move_block - перенос отрезка длины n / 64 в другое место
+//   reverse    - разворот отрезка длины n / 8
+//   add        - прибавление к отрезку длины n / 8
+//   at         - чтение элемента по позиции (здесь vector вне конкуренции)
+// Элемент (items) - правка или чтение.
+// ========================================================================
+
+using Sizes = std::vector<std::vector<std::int64_t>>;
+const Sizes ROPE_SIZES = {{1 << 16}, {1 << 20}};
+const int EDITS = 256;
+
+struct Edit
+{
+    std::size_t first;
+    std::size_t second;
+};
+
+// Пары случайных позиций: начало отрезка длины span и место вставки
+std::vector<Edit> makeEdits(std::size_t n, std::size_t span)
+{
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<std::size_t> from(0, n - span);
+    std::uniform_int_distribution<std::size_t> to(0, n - span);
+    std::vector<Edit> edits(EDITS);
+    for (Edit& edit : edits)
+        edit = {from(rng), to(rng)};
+    return edits;
+}
+
+std::vector<int> makeSequence(std::size_t n)
+{
+    std::vector<int> values(n);
+    for (std::size_t i = 0; i < n; i++)
+        values[i] = static_cast<int>(i);
+    return values;
+}
+
+struct VectorSequence
+{
+    std::vector<int> values;
+
+    explicit VectorSequence(const std::vector<int>& init) : values(init) {}
+
+    void edit(const Edit& e)
+    {
+        values.insert(values.begin() + static_cast<std::ptrdiff_t>(e.first), static_cast<int>(e.second));
+        values.erase(values.begin() + static_cast<std::ptrdiff_t>(e.second));
+    }
+
+    void moveBlock(const Edit& e, std::size_t span)
+    {
+        auto first = values.begin() + static_cast<std::ptrdiff_t>(e.first);
+        std::vector<int> block(first, first + static_cast<std::ptrdiff_t>(span));
+        values.erase(first, first + static_cast<std::ptrdiff_t>(span));
+        values.insert(values.begin() + static_cast<std::ptrdiff_t>(e.second), block.begin(), block.end());
+    }
+
+    void reverse(const Edit& e, std::size_t span)
+    {
+        auto first = values.begin() + static_cast<std::ptrdiff_t>(e.first);
+        std::reverse(first, first + static_cast<std::ptrdiff_t>(span));
+    }
+
+    void add(const Edit& e, std::size_t span)
+    {
+        for (std::size_t i = e.first; i < e.first + span; i++)
+            values[i] += 1;
+    }
+
+    int at(std::size_t pos) const { return values[pos]; }
+};
+
+struct RopeSequence
+{
+    ImplicitTreap<int> values;
+
+    explicit RopeSequence(const std::vector<int>& init) : values(init.begin(), init.end()) {}
+
+    void edit(const Edit& e)
+    {
+        values.insert(e.first, static_cast<int>(e.second));
+        values.erase(e.second);
+    }
+
+    void moveBlock(const Edit& e, std::size_t span)
+    {
+        ImplicitTreap<int> block = values.cut(e.first, e.first + span);
+        values.insert(e.second, std::move(block));
+    }
+
+    void reverse(const Edit& e, std::size_t span) { values.reverse(e.first, e.first + span); }
+
+    void add(const Edit& e, std::size_t span) { values.add(e.first, e.first + span, 1); }
+
+    int at(std::size_t pos) const { return values.at(pos); }
+};
+
+template <typename Sequence>
+void addRopeBenchmarks(BenchmarkRegistry& registry, const std::string& name)
+{
+    registry.add(name + "/edit", [](BenchmarkState& state) {
+        const std::size_t n = static_cast<std::size_t>(state.range(0));
+        Sequence sequence(makeSequence(n));
+        const std::vector<Edit> edits = makeEdits(n, 1);
+        while (state.keepRunning())
+        {
+            for (const Edit& e : edits)
+                sequence.edit(e);
+        }
+        doNotOptimize(sequence.at(n / 2));
+        state.setItemsProcessed(state.iterations() * EDITS);
+    }, ROPE_SIZES);
+
+    registry.add(name + "/move_block", [](BenchmarkState& state) {
+        const std::size_t n = static_cast<std::size_t>(state.range(0));
+        const std::size_t span = n / 64;
+        Sequence sequence(makeSequence(n));
+        const std::vector<Edit> edits = makeEdits(n, span);
+        while (state.keepRunning())
+        {
+            for (const Edit& e : edits)
+                sequence.moveBlock(e, span);
+        }
+        doNotOptimize(sequence.at(n / 2));
+        state.setItemsProcessed(state.iterations() * EDITS);
+    }, ROPE_SIZES);
+
+    registry.add(name + "/reverse", [](BenchmarkState& state) {
+        const std::size_t n = static_cast<std::size_t>(state.range(0));
+        const std::size_t span = n / 8;
+        Sequence sequence(makeSequence(n));
+        const std::vector<Edit> edits = makeEdits(n, span);
+        while (state.keepRunning())
+        {
+            for (const Edit& e : edits)
+                sequence.reverse(e, span);
+        }
+        doNotOptimize(sequence.at(n / 2));
+        state.setItemsProcessed(state.iterations() * EDITS);
+    }, ROPE_SIZES);
+
+    registry.add(name + "/add", [](BenchmarkState& state) {
+        const std::size_t n = static_cast<std::size_t>(state.range(0));
+        const std::size_t span = n / 8;
+        Sequence sequence(makeSequence(n));
+        const std::vector<Edit> edits = makeEdits(n, span);
+        while (state.keepRunning())
+        {
+            for (const Edit& e : edits)
+                sequence.add(e, span);
+        }
+        doNotOptimize(sequence.at(n / 2));
+        state.setItemsProcessed(state.iterations() * EDITS);
+    }, ROPE_SIZES);
+
+    registry.add(name + "/at", [](BenchmarkState& state) {
+        const std::size_t n = static_cast<std::size_t>(state.range(0));
+        const Sequence sequence(makeSequence(n));
+        const std::vector<Edit> edits = makeEdits(n, 1);
+        while (state.keepRunning())
+        {
+            std::int64_t total = 0;
+            for (const Edit& e : edits)
+                total += sequence.at(e.first);
+            doNotOptimize(total);
+        }
+        state.setItemsProcessed(state.iterations() * EDITS);
+    }, ROPE_SIZES);
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkRegistry registry;
+    addRopeBenchmarks<VectorSequence>(registry, "vector");
+    addRopeBenchmarks<RopeSequence>(registry, "rope");
+    return registry.run(argc, argv);
+}
@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench_harness.h"
+#include "bench_keys.h"
+#include "../avl_tree/avl_map.h"
+#include "../red_black_tree/rbtree_map.h"
+#include "../balanced_trees/treap/treap_map.h"
+
+// ========================================================================
+// БЕНЧМАРКИ МАССОВОГО ПОСТРОЕНИЯ И ОПЕРАЦИЙ НА JOIN (common/tree_join.h)
+// ========================================================================
+// Имя случая: словарь/операция/способ/n.
+//   build/insert    - n вставок ключей по возрастанию (поворот на каждой)
+//   build/bulk_load - bulkLoad из того же отсортированного массива
+//   build/hint      - std::map::emplace_hint(end()) - ориентир (только std_map)
+//   union/loop      - try_emplace каждого ключа B в A
+//   union/join      - A.unionWith(B)
+//   snapshot/loop, snapshot/join - то же, но |B| = n / 64: вливание
+//                     небольшого "ночного снимка" в большой словарь
+//   intersect/loop  - новый словарь из ключей A, найденных в B
+//   intersect/join  - A.intersectWith(B)
+//   subtract/loop   - erase каждого ключа B из A
+//   subtract/join   - A.subtract(B)
+//   split_join      - splitFrom(середина) и join обратно
+//   batch_insert/loop - try_emplace n / 4 пар в случайном порядке
+//   batch_insert/join - insertBatch тех же пар
+//   batch_erase/loop  - erase n / 4 ключей в случайном порядке
+//   batch_erase/join  - eraseBatch тех же ключей
+// В A и B по n случайных ключей из 0..1.5n (пересечение - около трети).
+// Подготовка копий A и B - вне замера. Операции на join используют пул
+// потоков на все ядра. Элемент (items) - ключ A и B (для build - ключ,
+// для batch - ключ пакета). Пакет - n / 4 ключей из 0..3n/8, около
+// двух третей из них уже есть в A.
+// ========================================================================
+
+using Sizes = std::vector<std::vector<std::int64_t>>;
+const Sizes SETOP_SIZES = {{1 << 16}, {1 << 20}};
+const int SNAPSHOT_RATIO = 64;
+const int BATCH_RATIO = 4;
+
+ThreadPool& benchPool()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+// n случайных различных ключей из 0..1.5n, отсортированные пары (ключ, значение)
+std::vector<std::pair<int, std::int64_t>> makeSortedItems(int n, unsigned salt)
+{
+    std::vector<int> universe = makeKeys(n + n / 2, KeyOrder::Random);
+    std::rotate(universe.begin(), universe.begin() + salt % universe.size(), universe.end());
+    universe.resize(n);
+    std::sort(universe.begin(), universe.end());
+    std::vector<std::pair<int, std::int64_t>> items;
+    items.reserve(n);
+    for (int k : universe)
+        items.emplace_back(k, k);
+    return items;
+}
+
+enum class SetCase
+{
+    Union,
+    Snapshot,
+    Intersect,
+    Subtract
+};
+
+template <typename Map>
+void addSetCase(BenchmarkRegistry& registry, const std::string& name, const std::string& opName, SetCase op,
+                bool useJoin)
+{
+    registry.add(name + "/" + opName + "/" + (useJoin ? "join" : "loop"), [op, useJoin](BenchmarkState& state) {
+        const int n = static_cast<int>(state.range(0));
+        const int m = op == SetCase::Snapshot ? n / SNAPSHOT_RATIO : n;
+        Map sourceA;
+        Map sourceB;
+        const auto itemsA = makeSortedItems(n, 0);
+        const auto itemsB = makeSortedItems(m, 12345);
+        sourceA.bulkLoad(itemsA.begin(), itemsA.end());
+        sourceB.bulkLoad(itemsB.begin(), itemsB.end());
+        std::size_t resultSize = 0;
+        while (state.keepRunning())
+        {
+            state.pauseTiming();
+            auto a = std::make_unique<Map>(sourceA);
+            auto b = std::make_unique<Map>(sourceB);
+            state.resumeTiming();
+            if (useJoin)
+            {
+                if (op == SetCase::Union || op == SetCase::Snapshot)
+                    a->unionWith(std::move(*b), benchPool());
+                else if (op == SetCase::Intersect)
+                    a->intersectWith(std::move(*b), benchPool());
+                else
+                    a->subtract(std::move(*b), benchPool());
+            }
+            else if (op == SetCase::Union || op == SetCase::Snapshot)
+            {
+                for (const auto& kv : *b)
+                    a->try_emplace(kv.first, kv.second);
+            }
+            else if (op == SetCase::Intersect)
+            {
+                auto kept = std::make_unique<Map>();
+                for (const auto& kv : *a)
+                    if (b->contains(kv.first))
+                        kept->insert(kv);
+                a.swap(kept);
+                state.pauseTiming();
+                kept.reset();
+                state.resumeTiming();
+            }
+            else
+            {
+                for (const auto& kv : *b)
+                    a->erase(kv.first);
+            }
+            resultSize = a->size();
+            state.pauseTiming();
+            a.reset();
+            b.reset();
+            state.resumeTiming();
+        }
+        state.counters["result_size"] = static_cast<double>(resultSize);
+        state.setItemsProcessed(state.iterations() * static_cast<std::int64_t>(n + m));
+    }, SETOP_SIZES);
+}
+
+template <typename Map>
+void addBatchCase(BenchmarkRegistry& registry, const std::string& name, bool erase, bool useJoin)
+{
+    const std::string opName = erase ? "/batch_erase/" : "/batch_insert/";
+    registry.add(name + opName + (useJoin ? "join" : "loop"), [erase, useJoin](BenchmarkState& state) {
+        const int n = static_cast<int>(state.range(0));
+        const auto items = makeSortedItems(n, 0);
+        Map source;
+        source.bulkLoad(items.begin(), items.end());
+        // Пакет в случайном порядке
+        auto batch = makeSortedItems(n / BATCH_RATIO, 12345);
+        std::shuffle(batch.begin(), batch.end(), std::mt19937_64(1));
+        std::vector<int> batchKeys;
+        for (const auto& kv : batch)
+            batchKeys.push_back(kv.first);
+        std::size_t resultSize = 0;
+        while (state.keepRunning())
+        {
+            state.pauseTiming();
+            auto map = std::make_unique<Map>(source);
+            state.resumeTiming();
+            if (erase && useJoin)
+                map->eraseBatch(batchKeys.begin(), batchKeys.end(), benchPool());
+            else if (erase)
+            {
+                for (int k : batchKeys)
+                    map->erase(k);
+            }
+            else if (useJoin)
+                map->insertBatch(batch.begin(), batch.end(), benchPool());
+            else
+            {
+                for (const auto& kv : batch)
+                    map->try_emplace(kv.first, kv.second);
+            }
+            resultSize = map->size();
+            state.pauseTiming();
+            map.reset();
+            state.resumeTiming();
+        }
+        state.counters["result_size"] = static_cast<double>(resultSize);
+        state.setItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch.size()));
+    }, SETOP_SIZES);
+}
+
+template <typename Map>
+void addSetopBenchmarks(BenchmarkRegistry& registry, const std::string& name)
+{
+    registry.add(name + "/build/insert", [](BenchmarkState& state) {
+        const auto items = makeSortedItems(static_cast<int>(state.range(0)), 0);
+        while (state.keepRunning())
+        {
+            auto map = std::make_unique<Map>();
+            for (const auto& kv : items)
+                map->try_emplace(kv.first, kv.second);
+            state.pauseTiming();
+            map.reset();
+            state.resumeTiming();
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::int64_t>(items.size()));
+    }, SETOP_SIZES);
+
+    registry.add(name + "/build/bulk_load", [](BenchmarkState& state) {
+        const auto items = makeSortedItems(static_cast<int>(state.range(0)), 0);
+        while (state.keepRunning())
+        {
+            auto map = std::make_unique<Map>();
+            map->bulkLoad(items.begin(), items.end());
+            state.pauseTiming();
+            map.reset();
+            state.resumeTiming();
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::int64_t>(items.size()));
+    }, SETOP_SIZES);
+
+    for (bool useJoin : {false, true})
+    {
+        addSetCase<Map>(registry, name, "union", SetCase::Union, useJoin);
+        addSetCase<Map>(registry, name, "snapshot", SetCase::Snapshot, useJoin);
+        addSetCase<Map>(registry, name, "intersect", SetCase::Intersect, useJoin);
+        addSetCase<Map>(registry, name, "subtract", SetCase::Subtract, useJoin);
+        addBatchCase<Map>(registry, name, false, useJoin);
+        addBatchCase<Map>(registry, name, true, useJoin);
+    }
+
+    registry.add(name + "/split_join", [](BenchmarkState& state) {
+        const int n = static_cast<int>(state.range(0));
+        const auto items = makeSortedItems(n, 0);
+        Map map;
+        map.bulkLoad(items.begin(), items.end());
+        const int middle = items[items.size() / 2].first;
+        while (state.keepRunning())
+        {
+            Map upper = map.splitFrom(middle);
+            map.join(std::move(upper));
+        }
+        state.setItemsProcessed(state.iterations());
+    }, SETOP_SIZES);
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkRegistry registry;
+    registry.add("std_map/build/hint", [](BenchmarkState& state) {
+        const auto items = makeSortedItems(static_cast<int>(state.range(0)), 0);
+        while (state.keepRunning())
+        {
+            auto map = std::make_unique<std::map<int, std::int64_t>>();
+            for (const auto& kv : items)
+                map->emplace_hint(map->end(), kv);
+            state.pauseTiming();
+            map.reset();
+            state.resumeTiming();
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::int64_t>(items.size()));
+    }, SETOP_SIZES);
+    addSetopBenchmarks<AVLMap<int, std::int64_t>>(registry, "avl");
+    addSetopBenchmarks<RBTreeMap<int, std::int64_t>>(registry, "rbtree");
+    addSetopBenchmarks<TreapMap<int, std::int64_t>>(registry, "treap");
+    return registry.run(argc, argv);
+}
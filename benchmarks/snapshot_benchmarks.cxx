@@ -0,0 +1,139 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "bench_harness.h"
+#include "bench_keys.h"
+#include "../red_black_tree/persistent_rbtree.h"
+#include "../red_black_tree/rbtree_map.h"
+
+// ========================================================================
+// БЕНЧМАРКИ ЧТЕНИЯ ПОД НАГРУЗКОЙ ПИСАТЕЛЯ
+// ========================================================================
+// Имя случая: схема/n/читателей. Словарь из n ключей int; каждый
+// читатель выполняет LOOKUPS поисков, а писатель всё это время в
+// отдельном потоке меняет значения пакетами по BATCH ключей с паузой
+// WRITE_PAUSE между пакетами (сервис, где чтений намного больше записей).
+//   rwlock   - RBTreeMap под std::shared_mutex: читатель берёт общую
+//              блокировку на каждый поиск, писатель - исключительную на пакет
+//   snapshot - PersistentRBTree: читатель открывает снимок на каждый поиск,
+//              писатель публикует пакет через commit
+// Элемент (items) - поиск; счётчик commits - пакетов писателя за итерацию.
+// ========================================================================
+
+using Sizes = std::vector<std::vector<std::int64_t>>;
+const Sizes SNAPSHOT_SIZES = {{1 << 16, 1}, {1 << 16, 4}, {1 << 20, 1}, {1 << 20, 4}};
+const int LOOKUPS = 1 << 16;
+const int BATCH = 64;
+const std::chrono::microseconds WRITE_PAUSE(100);
+
+class LockedMap
+{
+    RBTreeMap<int, std::int64_t> map;
+    mutable std::shared_mutex mutex;
+
+public:
+    bool contains(int key) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return map.find(key) != map.end();
+    }
+
+    template <typename It>
+    void applyBatch(It first, It last, std::int64_t value)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        for (; first != last; ++first)
+            map.insert_or_assign(*first, value);
+    }
+};
+
+class SnapshotMap
+{
+    PersistentRBTree<int, std::int64_t> tree;
+
+public:
+    using Reader = PersistentRBTree<int, std::int64_t>::Reader;
+
+    Reader reader() { return tree.reader(); }
+
+    static bool contains(Reader& reader, int key) { return reader.snapshot().contains(key); }
+
+    template <typename It>
+    void applyBatch(It first, It last, std::int64_t value)
+    {
+        for (; first != last; ++first)
+            tree.insert(*first, value);
+        tree.commit();
+    }
+};
+
+template <typename Map>
+void addReadersCase(BenchmarkRegistry& registry, const std::string& name)
+{
+    registry.add(name, [](BenchmarkState& state) {
+        const int n = static_cast<int>(state.range(0));
+        const int readerCount = static_cast<int>(state.range(1));
+        const std::vector<int> keys = makeKeys(n, KeyOrder::Random);
+        Map map;
+        map.applyBatch(keys.begin(), keys.end(), 0);
+
+        std::int64_t commits = 0;
+        while (state.keepRunning())
+        {
+            std::atomic<bool> stop(false);
+            std::thread writer([&]() {
+                std::size_t offset = 0;
+                std::int64_t value = 1;
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    if (offset + BATCH > keys.size())
+                        offset = 0;
+                    map.applyBatch(keys.begin() + offset, keys.begin() + offset + BATCH, value++);
+                    offset += BATCH;
+                    commits++;
+                    std::this_thread::sleep_for(WRITE_PAUSE);
+                }
+            });
+            std::vector<std::thread> readers;
+            for (int r = 0; r < readerCount; r++)
+            {
+                readers.emplace_back([&, r]() {
+                    int found = 0;
+                    if constexpr (std::is_same_v<Map, SnapshotMap>)
+                    {
+                        SnapshotMap::Reader reader = map.reader();
+                        for (int i = 0; i < LOOKUPS; i++)
+                            found += SnapshotMap::contains(reader, keys[(i * 7 + r) % keys.size()]);
+                    }
+                    else
+                    {
+                        for (int i = 0; i < LOOKUPS; i++)
+                            found += map.contains(keys[(i * 7 + r) % keys.size()]);
+                    }
+                    doNotOptimize(found);
+                });
+            }
+            for (std::thread& reader : readers)
+                reader.join();
+            stop = true;
+            writer.join();
+        }
+        state.counters["commits"] = static_cast<double>(commits) / static_cast<double>(state.iterations());
+        state.setItemsProcessed(state.iterations() * static_cast<std::int64_t>(readerCount) * LOOKUPS);
+    }, SNAPSHOT_SIZES);
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkRegistry registry;
+    addReadersCase<LockedMap>(registry, "rwlock");
+    addReadersCase<SnapshotMap>(registry, "snapshot");
+    return registry.run(argc, argv);
+}
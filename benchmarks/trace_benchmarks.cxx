@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <climits>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_harness.h"
+#include "../common/trace.h"
+
+// Учебные файлы подключаются как есть. Dijkstra и Kruskal объявляют
+// одноимённые Graph и Edge, поэтому каждый помещён в своё пространство имён
+// (стандартные заголовки и trace.h уже подключены выше и повторно не
+// раскрываются); демонстрационные main() переименованы
+namespace dijkstra_demo
+{
+#define main simple_dijkstra_main
+#include "../dijkstra/simple_dijkstra.cxx"
+#undef main
+}
+namespace kruskal_demo
+{
+#define main simple_kruskal_main
+#include "../kruskal/simple_kruskal.cxx"
+#undef main
+}
+#define main simple_avl_main
+#include "../avl_tree/simple_avl.cxx"
+#undef main
+
+// ========================================================================
+// ЦЕНА ТРАССИРОВКИ В ГОРЯЧИХ ЦИКЛАХ
+// ========================================================================
+// Имя случая: trace/алгоритм/режим/n. Оба режима ничего не печатают:
+//   runtime_flag - VerboseTrace(false): код трассировки скомпилирован,
+//                  во внутренних циклах проверяется флаг (поведение до
+//                  введения политик)
+//   compiled_out - NoTrace: проверки и код трассировки удалены компилятором
+// Разница между режимами - цена проверок и раздутого трассировкой кода
+// (хуже встраивание, больше давление на регистры и кэш инструкций).
+//
+// Dijkstra и Kruskal печатают итоговый ответ без условия - на время замера
+// std::cout отключается (пустой буфер: operator<< сразу выходит).
+// ========================================================================
+
+// Случайный связный граф: цепочка 0-1-...-(n-1) и ещё 7n случайных рёбер
+template <typename Graph>
+void fillRandomGraph(Graph& g, int n, std::mt19937_64& rng)
+{
+    std::uniform_int_distribution<int> vertex(0, n - 1), weight(1, 100);
+    for (int v = 1; v < n; v++)
+        g.addEdge(v - 1, v, weight(rng));
+    for (long long i = 0; i < 7LL * n; i++)
+        g.addEdge(vertex(rng), vertex(rng), weight(rng));
+}
+
+// Отключение std::cout на время цикла замера
+class MuteCout
+{
+    std::streambuf* saved;
+
+public:
+    MuteCout() : saved(std::cout.rdbuf(nullptr)) {}
+    ~MuteCout()
+    {
+        std::cout.rdbuf(saved);
+        std::cout.clear();
+    }
+};
+
+template <typename Trace>
+void benchDijkstra(BenchmarkState& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    std::mt19937_64 rng(1);
+    {
+        MuteCout mute;
+        while (state.keepRunning())
+        {
+            // Учебный граф хранит расстояния внутри - каждой итерации свой
+            state.pauseTiming();
+            dijkstra_demo::Graph<Trace> g(n, false);
+            fillRandomGraph(g, n, rng);
+            state.resumeTiming();
+            g.dijkstra(0);
+        }
+    }
+    state.setItemsProcessed(state.iterations() * 8LL * n);
+}
+
+template <typename Trace>
+void benchKruskal(BenchmarkState& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    std::mt19937_64 rng(1);
+    {
+        MuteCout mute;
+        while (state.keepRunning())
+        {
+            state.pauseTiming();
+            kruskal_demo::Graph<Trace> g(n, false);
+            fillRandomGraph(g, n, rng);
+            state.resumeTiming();
+            g.kruskal();
+        }
+    }
+    state.setItemsProcessed(state.iterations() * 8LL * n);
+}
+
+template <typename Trace>
+void benchUnionFind(BenchmarkState& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    std::vector<std::pair<int, int>> pairs(2 * static_cast<std::size_t>(n));
+    for (auto& p : pairs)
+        p = {vertex(rng), vertex(rng)};
+    while (state.keepRunning())
+    {
+        kruskal_demo::UnionFind<Trace> uf(n, false);
+        int merged = 0;
+        for (const auto& p : pairs)
+            merged += uf.unite(p.first, p.second);
+        doNotOptimize(merged);
+    }
+    state.setItemsProcessed(state.iterations() * static_cast<std::int64_t>(pairs.size()));
+}
+
+template <typename Trace>
+void benchAVLInsert(BenchmarkState& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    std::vector<int> keys(n);
+    for (int i = 0; i < n; i++)
+        keys[i] = i;
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(1));
+    while (state.keepRunning())
+    {
+        auto tree = std::make_unique<AVLTree<Trace>>(false);
+        for (int k : keys)
+            tree->insert(k);
+        state.pauseTiming();
+        tree.reset();
+        state.resumeTiming();
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// Пара случаев runtime_flag / compiled_out для одного алгоритма
+void addTracePair(BenchmarkRegistry& registry, const std::string& name, void (*runtimeFlag)(BenchmarkState&),
+                  void (*compiledOut)(BenchmarkState&), const std::vector<std::vector<std::int64_t>>& sizes)
+{
+    registry.add("trace/" + name + "/runtime_flag", runtimeFlag, sizes);
+    registry.add("trace/" + name + "/compiled_out", compiledOut, sizes);
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkRegistry registry;
+    const std::vector<std::vector<std::int64_t>> sizes = {{1 << 12}, {1 << 16}};
+    addTracePair(registry, "dijkstra", benchDijkstra<VerboseTrace>, benchDijkstra<NoTrace>, sizes);
+    addTracePair(registry, "kruskal", benchKruskal<VerboseTrace>, benchKruskal<NoTrace>, sizes);
+    addTracePair(registry, "union_find", benchUnionFind<VerboseTrace>, benchUnionFind<NoTrace>, sizes);
+    addTracePair(registry, "avl_insert", benchAVLInsert<VerboseTrace>, benchAVLInsert<NoTrace>, sizes);
+    return registry.run(argc, argv);
+}
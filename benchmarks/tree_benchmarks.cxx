@@ -0,0 +1,128 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench_harness.h"
+#include "bench_keys.h"
+
+// Учебные деревья подключаются как есть; их демонстрационные main()
+// переименованы, чтобы не конфликтовать с main() бенчмарка. Замеряются
+// варианты с вырезанной трассировкой (NoTrace, common/trace.h)
+#define main simple_avl_main
+#include "../avl_tree/simple_avl.cxx"
+#undef main
+#define main simple_rbtree_main
+#include "../red_black_tree/simple_rbtree.cxx"
+#undef main
+#define main simple_splay_main
+#include "../splay_tree/simple_splay.cxx"
+#undef main
+#define main simple_aa_tree_main
+#include "../balanced_trees/aa_tree/simple_aa_tree.cxx"
+#undef main
+#define main simple_scapegoat_main
+#include "../balanced_trees/scapegoat_tree/simple_scapegoat.cxx"
+#undef main
+#define main simple_treap_main
+#include "../balanced_trees/treap/simple_treap.cxx"
+#undef main
+
+// ========================================================================
+// БЕНЧМАРКИ ДЕРЕВЬЕВ ПОИСКА
+// ========================================================================
+// Имя случая: дерево/операция/распределение/n. Операции:
+//   insert - построение дерева из n ключей (освобождение вне замера)
+//   search - n поисков в дереве из n ключей
+//   remove - удаление всех n ключей (только у деревьев с remove)
+// Порядки ключей (random, sequential, zipf) - bench_keys.h.
+// Элемент (items) - одна операция над ключом.
+// ========================================================================
+
+using Sizes = std::vector<std::vector<std::int64_t>>;
+const Sizes TREE_SIZES = {{1 << 10}, {1 << 16}, {1 << 20}};
+// Учебное scapegoat-дерево пересчитывает размеры поддеревьев на каждой
+// вставке (O(n) на операцию) - большие n заняли бы часы
+const Sizes SCAPEGOAT_SIZES = {{1 << 10}, {1 << 13}};
+
+template <typename Tree>
+void addInsert(BenchmarkRegistry& registry, const std::string& name, KeyOrder order, const Sizes& sizes)
+{
+    registry.add(name + "/insert/" + keyOrderName(order), [order](BenchmarkState& state) {
+        const std::vector<int> keys = makeKeys(static_cast<int>(state.range(0)), order);
+        while (state.keepRunning())
+        {
+            auto tree = std::make_unique<Tree>();
+            for (int k : keys)
+                tree->insert(k);
+            state.pauseTiming();
+            tree.reset();
+            state.resumeTiming();
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+    }, sizes);
+}
+
+template <typename Tree>
+void addSearch(BenchmarkRegistry& registry, const std::string& name, KeyOrder order, const Sizes& sizes)
+{
+    registry.add(name + "/search/" + keyOrderName(order), [order](BenchmarkState& state) {
+        const int n = static_cast<int>(state.range(0));
+        Tree tree;
+        for (int k : makeKeys(n, KeyOrder::Random))
+            tree.insert(k);
+        const std::vector<int> queries = makeKeys(n, order);
+        while (state.keepRunning())
+        {
+            for (int k : queries)
+            {
+                bool found = tree.search(k);
+                doNotOptimize(found);
+            }
+        }
+        state.setItemsProcessed(state.iterations() * n);
+    }, sizes);
+}
+
+template <typename Tree>
+void addRemove(BenchmarkRegistry& registry, const std::string& name, KeyOrder order, const Sizes& sizes)
+{
+    registry.add(name + "/remove/" + keyOrderName(order), [order](BenchmarkState& state) {
+        const int n = static_cast<int>(state.range(0));
+        const std::vector<int> keys = makeKeys(n, KeyOrder::Random);
+        const std::vector<int> victims = makeKeys(n, order);
+        while (state.keepRunning())
+        {
+            state.pauseTiming();
+            auto tree = std::make_unique<Tree>();
+            for (int k : keys)
+                tree->insert(k);
+            state.resumeTiming();
+            for (int k : victims)
+                tree->remove(k);
+        }
+        state.setItemsProcessed(state.iterations() * n);
+    }, sizes);
+}
+
+template <typename Tree, bool hasRemove>
+void addTree(BenchmarkRegistry& registry, const std::string& name, const Sizes& sizes = TREE_SIZES)
+{
+    addInsert<Tree>(registry, name, KeyOrder::Random, sizes);
+    addInsert<Tree>(registry, name, KeyOrder::Sequential, sizes);
+    addSearch<Tree>(registry, name, KeyOrder::Random, sizes);
+    addSearch<Tree>(registry, name, KeyOrder::Zipf, sizes);
+    if constexpr (hasRemove)
+        addRemove<Tree>(registry, name, KeyOrder::Random, sizes);
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkRegistry registry;
+    addTree<AVLTree<>, true>(registry, "avl");
+    addTree<RedBlackTree<>, false>(registry, "rbtree");
+    addTree<SplayTree<>, true>(registry, "splay");
+    addTree<AATree<>, true>(registry, "aa");
+    addTree<ScapegoatTree<>, false>(registry, "scapegoat", SCAPEGOAT_SIZES);
+    addTree<Treap<>, true>(registry, "treap");
+    return registry.run(argc, argv);
+}
@@ -0,0 +1,119 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "csr_bfs.h"
+#include "parallel_bfs.h"
+#include "../graph_common/graph_generators.h"
+#include "../graph_common/text_columns.h"
+
+// ========================================================================
+// МАСШТАБИРУЕМОСТЬ ПАРАЛЛЕЛЬНОГО BFS НА R-MAT ГРАФАХ
+// ========================================================================
+// Неориентированный R-MAT граф (2^scale вершин, 16 * 2^scale рёбер,
+// параметры Graph500). Сравниваем последовательный csrBFS и
+// ParallelBFS с оптимизацией направления на 1, 2, 4, ... потоках.
+// Результат проверяется: расстояния совпадают с последовательным BFS,
+// а parent[v] - сосед v уровнем выше.
+//
+// Запуск: ./bfs_benchmark [scale] (по умолчанию 18 => 262144 вершин)
+// ========================================================================
+
+bool validate(const CSRGraph& g, const BFSResult& expected, const BFSResult& actual, int source)
+{
+    if (expected.distance != actual.distance)
+        return false;
+    for (int v = 0; v < g.vertexCount(); v++)
+    {
+        if (v == source || actual.distance[v] == -1)
+            continue;
+        int p = actual.parent[v];
+        if (p < 0 || actual.distance[p] != actual.distance[v] - 1)
+            return false;
+        bool adjacent = false;
+        for (int u : g.neighbors(p))
+        {
+            if (u == v)
+            {
+                adjacent = true;
+                break;
+            }
+        }
+        if (!adjacent)
+            return false;
+    }
+    return true;
+}
+
+template <typename Func>
+double bestOfMs(int runs, Func&& f)
+{
+    double best = 1e18;
+    for (int r = 0; r < runs; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+int main(int argc, char* argv[])
+{
+    int scale = (argc > 1) ? std::atoi(argv[1]) : 18;
+    int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  ПАРАЛЛЕЛЬНЫЙ BFS (R-MAT, ядер: " << cores << ")" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    CSRGraph g = CSRGraph::fromEdgeList(1 << scale, generateRMAT(scale, 16, 1), true);
+    std::cout << "V = " << g.vertexCount() << ", E = " << g.edgeCount() / 2 << " (неориентированных)" << std::endl;
+
+    // Источник - вершина максимальной степени (гарантированно в большой компоненте)
+    int source = 0;
+    for (int v = 1; v < g.vertexCount(); v++)
+    {
+        if (g.degree(v) > g.degree(source))
+            source = v;
+    }
+
+    BFSResult expected;
+    double serialMs = bestOfMs(3, [&]() { expected = csrBFS(g, source); });
+    std::int64_t reachedEdges = 0;
+    for (int v = 0; v < g.vertexCount(); v++)
+    {
+        if (expected.distance[v] != -1)
+            reachedEdges += g.degree(v);
+    }
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Последовательный csrBFS: " << serialMs << " мс, "
+              << reachedEdges / 2 / serialMs / 1000.0 << " MTEPS\n" << std::endl;
+
+    std::cout << alignLeft("Потоки", 10) << alignRight("мс", 12) << alignRight("MTEPS", 12)
+              << alignRight("ускорение", 12) << "   уровни TD/BU" << std::endl;
+
+    std::vector<int> threadCounts;
+    for (int t = 1; t < cores; t *= 2)
+        threadCounts.push_back(t);
+    threadCounts.push_back(cores);
+
+    for (int threads : threadCounts)
+    {
+        ThreadPool pool(threads);
+        ParallelBFS bfs(g, g, pool);
+        BFSResult actual;
+        double ms = bestOfMs(3, [&]() { actual = bfs.run(source); });
+        std::cout << std::left << std::setw(10) << threads << std::right
+                  << std::setw(12) << ms
+                  << std::setw(12) << reachedEdges / 2 / ms / 1000.0
+                  << std::setw(11) << serialMs / ms << "x"
+                  << "   " << bfs.topDownLevels << "/" << bfs.bottomUpLevels
+                  << (validate(g, expected, actual, source) ? "   ✓" : "   ✗ ОШИБКА") << std::endl;
+    }
+    return 0;
+}
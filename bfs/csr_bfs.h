@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+
+#include "../graph_common/csr_graph.h"
+
+// BFS на CSR-графе (тот же алгоритм, что и Graph::BFS в simple_bfs.cxx,
+// но без вывода и с плотным хранением рёбер).
+//
+// Вместо std::queue используется обычный вектор с указателем головы:
+// каждая вершина попадает в очередь ровно один раз, поэтому V элементов
+// достаточно, а чтение идёт строго последовательно.
+
+struct BFSResult
+{
+    std::vector<int> distance; // Уровень вершины (-1 = недостижима)
+    std::vector<int> parent;   // Родитель в дереве обхода (-1 у корня и недостижимых)
+    std::vector<int> order;    // Порядок посещения вершин
+};
+
+inline BFSResult csrBFS(const CSRGraph& g, int startVertex)
+{
+    const int V = g.vertexCount();
+    BFSResult result;
+    result.distance.assign(V, -1);
+    result.parent.assign(V, -1);
+    result.order.reserve(V);
+
+    std::vector<int>& queue = result.order; // Очередь и есть порядок посещения
+    std::size_t head = 0;
+
+    result.distance[startVertex] = 0;
+    queue.push_back(startVertex);
+
+    while (head < queue.size())
+    {
+        int u = queue[head++];
+        int nextLevel = result.distance[u] + 1;
+        for (int v : g.neighbors(u))
+        {
+            if (result.distance[v] == -1)
+            {
+                result.distance[v] = nextLevel;
+                result.parent[v] = u;
+                queue.push_back(v);
+            }
+        }
+    }
+    return result;
+}
@@ -1,6 +1,8 @@
 #include <iostream>
 #include <queue>
 
+#include "../common/trace.h"
+
 // Узел бинарного дерева поиска
 struct TreeNode
 {
@@ -12,10 +14,11 @@ struct TreeNode
 };
 
 // Класс бинарного дерева поиска (BST)
+template <typename Trace = NoTrace>
 class BinarySearchTree
 {
     TreeNode* root;
-    bool verbose;
+    Trace verbose;
 
     // Вспомогательная функция для рекурсивного удаления
     void destroyTree(TreeNode* node)
@@ -251,7 +254,7 @@ int main()
     std::cout << "  ТЕСТ 1: Базовые операции BST" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    BinarySearchTree bst1(true);
+    BinarySearchTree<VerboseTrace> bst1(true);
     
     std::cout << "\n--- Вставка элементов ---" << std::endl;
     bst1.insert(50);
@@ -280,7 +283,7 @@ int main()
     std::cout << "  ТЕСТ 2: Несбалансированное дерево" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    BinarySearchTree bst2(false);
+    BinarySearchTree<> bst2(false);
     // Вставляем в порядке возрастания - получаем вырожденное дерево
     std::cout << "Вставка в порядке возрастания (1, 2, 3, 4, 5, 6, 7):" << std::endl;
     for (int i = 1; i <= 7; i++)
@@ -0,0 +1,108 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "parallel_boruvka.h"
+#include "../prim/csr_prim.h"
+#include "../graph_common/text_columns.h"
+
+// ========================================================================
+// МАСШТАБИРУЕМОСТЬ ПАРАЛЛЕЛЬНОГО АЛГОРИТМА БОРУВКИ
+// ========================================================================
+// Связный граф-решётка side x side со случайными весами [1, 1000] плюс
+// side² случайных "дальних" рёбер. Вес MST сравнивается с последовательным
+// csrPrim (для связного графа вес MST единственен).
+//
+// Запуск: ./boruvka_benchmark [side] (по умолчанию 1000 => 10^6 вершин)
+// ========================================================================
+
+std::vector<WeightedEdge> makeGrid(int side, std::uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> weight(1, 1000);
+    const int V = side * side;
+    std::uniform_int_distribution<int> vertex(0, V - 1);
+
+    std::vector<WeightedEdge> edges;
+    edges.reserve(static_cast<std::size_t>(V) * 3);
+    for (int r = 0; r < side; r++)
+    {
+        for (int c = 0; c < side; c++)
+        {
+            int v = r * side + c;
+            if (c + 1 < side)
+                edges.push_back({v, v + 1, weight(rng)});
+            if (r + 1 < side)
+                edges.push_back({v, v + side, weight(rng)});
+        }
+    }
+    for (int i = 0; i < V; i++)
+    {
+        edges.push_back({vertex(rng), vertex(rng), weight(rng)});
+    }
+    return edges;
+}
+
+template <typename Func>
+double bestOfMs(int runs, Func&& f)
+{
+    double best = 1e18;
+    for (int r = 0; r < runs; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+int main(int argc, char* argv[])
+{
+    int side = (argc > 1) ? std::atoi(argv[1]) : 1000;
+    int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const int V = side * side;
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  ПАРАЛЛЕЛЬНЫЙ БОРУВКА (ядер: " << cores << ")" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    std::vector<WeightedEdge> edges = makeGrid(side, 1);
+    std::cout << "V = " << V << ", E = " << edges.size() << std::endl;
+
+    CSRGraph g = CSRGraph::fromEdgeList(V, edges, true);
+    PrimResult prim;
+    double primMs = bestOfMs(3, [&]() { prim = csrPrim(g, 0); });
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Последовательный csrPrim: " << primMs << " мс, вес MST " << prim.totalWeight << "\n" << std::endl;
+
+    std::cout << alignLeft("Потоки", 10) << alignRight("мс", 12) << "   ускорение   итераций" << std::endl;
+
+    std::vector<int> threadCounts;
+    for (int t = 1; t < cores; t *= 2)
+        threadCounts.push_back(t);
+    threadCounts.push_back(cores);
+
+    double singleMs = 0;
+    for (int threads : threadCounts)
+    {
+        ThreadPool pool(threads);
+        ParallelBoruvka boruvka(V, edges, pool);
+        MSTResult result;
+        double ms = bestOfMs(3, [&]() { result = boruvka.run(); });
+        if (threads == 1)
+            singleMs = ms;
+        bool ok = result.totalWeight == prim.totalWeight && result.components == 1 &&
+                  static_cast<int>(result.edges.size()) == V - 1;
+        std::cout << std::left << std::setw(10) << threads << std::right
+                  << std::setw(12) << ms
+                  << std::setw(11) << singleMs / ms << "x"
+                  << std::setw(11) << boruvka.rounds
+                  << (ok ? "   ✓" : "   ✗ ОШИБКА") << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "../graph_common/concurrent_union_find.h"
+#include "../graph_common/csr_graph.h"
+#include "../graph_common/mst_result.h"
+#include "../graph_common/thread_pool.h"
+
+// ========================================================================
+// ПАРАЛЛЕЛЬНЫЙ АЛГОРИТМ БОРУВКИ
+// ========================================================================
+// Graph::boruvka из simple_boruvka.cxx в каждой итерации:
+//   - последовательно просматривает ВСЕ рёбра, даже давно ставшие
+//     внутренними рёбрами компонент;
+//   - пересчитывает компоненты заново (getComponentCount - проход по V).
+//
+// Здесь итерация состоит из трёх параллельных фаз (между фазами - барьер):
+//
+//   1. Дешёвые рёбра. Каждый поток берёт кусок списка живых рёбер,
+//      находит корни концов и атомарным минимумом обновляет cheapest[]
+//      обоих корней. Ключ - 64-битное число (вес << 32 | номер ребра):
+//      одна CAS сравнивает и вес, и номер, а различные номера дают
+//      строгий порядок рёбер даже при равных весах - поэтому выбранные
+//      рёбра никогда не образуют цикл.
+//   2. Слияние. Для каждого живого корня его дешёвое ребро объединяет
+//      компоненты через ConcurrentUnionFind. Если два корня выбрали одно
+//      и то же ребро, unite удастся только у одного - ребро попадёт в MST
+//      ровно один раз. Количество компонент уменьшается на число удачных
+//      unite (счётчики по потокам), без пересчёта по всем вершинам.
+//   3. Сжатие. Из списка рёбер выбрасываются рёбра, ставшие внутренними
+//      (их концы уже в одной компоненте), из списка корней - вершины,
+//      переставшие быть корнями. Следующая итерация работает только
+//      с тем, что осталось.
+//
+// Число компонент хотя бы вдвое уменьшается за итерацию => O(log V) итераций.
+// Граф задаётся списком неориентированных рёбер (каждое ребро один раз).
+// ========================================================================
+
+class ParallelBoruvka
+{
+    static constexpr std::uint64_t NO_EDGE = ~0ULL;
+
+    const int numVertices;
+    const std::vector<WeightedEdge>& edges;
+    ThreadPool& pool;
+
+    ConcurrentUnionFind uf;
+    std::vector<std::atomic<std::uint64_t>> cheapest; // Ключ дешёвого ребра корня
+    std::vector<int> liveEdges, liveEdgesNext;        // Номера межкомпонентных рёбер
+    std::vector<int> roots, rootsNext;                // Текущие корни компонент
+    std::vector<char> selected;                       // selected[e] = 1 => ребро в MST
+
+    // Счётчики по потокам, выровненные на кэш-линию (без false sharing)
+    struct alignas(64) ThreadCounter
+    {
+        std::int64_t value = 0;
+    };
+    std::vector<ThreadCounter> counters;
+    std::vector<std::int64_t> blockCounts;
+
+    // Вес (со сдвигом знака, чтобы отрицательные веса сравнивались как
+    // беззнаковые) в старших 32 битах, номер ребра - в младших
+    static std::uint64_t edgeKey(int weight, int e)
+    {
+        std::uint32_t biased = static_cast<std::uint32_t>(weight) ^ 0x80000000u;
+        return (static_cast<std::uint64_t>(biased) << 32) | static_cast<std::uint32_t>(e);
+    }
+
+    static void atomicMin(std::atomic<std::uint64_t>& target, std::uint64_t value)
+    {
+        std::uint64_t current = target.load(std::memory_order_relaxed);
+        while (value < current &&
+               !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // Параллельная фильтрация in -> out с сохранением порядка: подсчёт по
+    // блокам, префиксные суммы по блокам, раскладка по блокам
+    template <typename Predicate>
+    void compact(const std::vector<int>& in, std::vector<int>& out, Predicate keep)
+    {
+        const std::int64_t n = static_cast<std::int64_t>(in.size());
+        const std::int64_t block = 4096;
+        const std::int64_t numBlocks = (n + block - 1) / block;
+        blockCounts.assign(numBlocks + 1, 0);
+
+        pool.parallelFor(0, numBlocks, [&](std::int64_t b) {
+            std::int64_t count = 0;
+            for (std::int64_t i = b * block; i < std::min(n, (b + 1) * block); i++)
+            {
+                count += keep(in[i]) ? 1 : 0;
+            }
+            blockCounts[b + 1] = count;
+        });
+        for (std::int64_t b = 0; b < numBlocks; b++)
+        {
+            blockCounts[b + 1] += blockCounts[b];
+        }
+
+        out.resize(static_cast<std::size_t>(blockCounts[numBlocks]));
+        pool.parallelFor(0, numBlocks, [&](std::int64_t b) {
+            std::int64_t pos = blockCounts[b];
+            for (std::int64_t i = b * block; i < std::min(n, (b + 1) * block); i++)
+            {
+                if (keep(in[i]))
+                    out[pos++] = in[i];
+            }
+        });
+    }
+
+public:
+    ParallelBoruvka(int V, const std::vector<WeightedEdge>& edgeList, ThreadPool& threadPool)
+        : numVertices(V), edges(edgeList), pool(threadPool), uf(V), cheapest(V),
+          selected(edgeList.size(), 0), counters(threadPool.threadCount())
+    {
+        if (edgeList.size() >= 0xFFFFFFFFull)
+            throw std::length_error("ParallelBoruvka: номер ребра не помещается в 32 бита");
+        for (const WeightedEdge& e : edgeList)
+        {
+            if (e.source < 0 || e.source >= V || e.destination < 0 || e.destination >= V)
+                throw std::out_of_range("ParallelBoruvka: вершина ребра вне диапазона [0, V)");
+        }
+    }
+
+    // Статистика последнего запуска
+    int rounds = 0;
+
+    MSTResult run()
+    {
+        const std::int64_t E = static_cast<std::int64_t>(edges.size());
+
+        liveEdges.resize(static_cast<std::size_t>(E));
+        pool.parallelFor(0, E, [&](std::int64_t e) {
+            liveEdges[e] = static_cast<int>(e);
+            selected[e] = 0;
+        }, 4096);
+        roots.resize(numVertices);
+        pool.parallelFor(0, numVertices, [&](std::int64_t v) {
+            roots[v] = static_cast<int>(v);
+            uf.makeSet(static_cast<int>(v));
+            cheapest[v].store(NO_EDGE, std::memory_order_relaxed);
+        }, 4096);
+
+        std::int64_t components = numVertices;
+        rounds = 0;
+
+        while (!liveEdges.empty())
+        {
+            rounds++;
+
+            // Фаза 1: дешёвое ребро каждой компоненты
+            pool.parallelFor(0, static_cast<std::int64_t>(liveEdges.size()), [&](std::int64_t i) {
+                int e = liveEdges[i];
+                int ru = uf.find(edges[e].source);
+                int rv = uf.find(edges[e].destination);
+                if (ru == rv)
+                    return;
+                std::uint64_t key = edgeKey(edges[e].weight, e);
+                atomicMin(cheapest[ru], key);
+                atomicMin(cheapest[rv], key);
+            }, 1024);
+
+            // Фаза 2: слияние по дешёвым рёбрам
+            pool.parallelFor(0, static_cast<std::int64_t>(roots.size()), [&](std::int64_t i) {
+                int r = roots[i];
+                std::uint64_t key = cheapest[r].load(std::memory_order_relaxed);
+                cheapest[r].store(NO_EDGE, std::memory_order_relaxed);
+                if (key == NO_EDGE)
+                    return;
+                int e = static_cast<int>(key & 0xFFFFFFFFu);
+                if (uf.unite(edges[e].source, edges[e].destination))
+                {
+                    selected[e] = 1;
+                    counters[pool.currentThreadIndex()].value++;
+                }
+            }, 256);
+
+            std::int64_t merged = 0;
+            for (ThreadCounter& c : counters)
+            {
+                merged += c.value;
+                c.value = 0;
+            }
+            components -= merged;
+
+            // Фаза 3: выбрасываем внутренние рёбра и бывшие корни.
+            // После барьера лес не меняется, find только укорачивает пути.
+            compact(liveEdges, liveEdgesNext, [&](int e) {
+                return uf.find(edges[e].source) != uf.find(edges[e].destination);
+            });
+            liveEdges.swap(liveEdgesNext);
+            compact(roots, rootsNext, [&](int r) { return uf.find(r) == r; });
+            roots.swap(rootsNext);
+        }
+
+        MSTResult result;
+        result.components = static_cast<int>(components);
+        result.edges.reserve(static_cast<std::size_t>(numVertices - components));
+        for (std::int64_t e = 0; e < E; e++)
+        {
+            if (selected[e])
+            {
+                result.edges.push_back(edges[e]);
+                result.totalWeight += edges[e].weight;
+            }
+        }
+        return result;
+    }
+};
+
+// Однократный запуск
+inline MSTResult parallelBoruvka(int V, const std::vector<WeightedEdge>& edges, ThreadPool& pool)
+{
+    ParallelBoruvka boruvka(V, edges, pool);
+    return boruvka.run();
+}
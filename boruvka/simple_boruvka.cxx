@@ -3,6 +3,8 @@
 #include <climits>
 #include <iomanip>
 
+#include "../common/trace.h"
+
 // Структура для представления ребра графа
 struct Edge
 {
@@ -12,11 +14,12 @@ struct Edge
 };
 
 // Класс для Union-Find (Disjoint Set Union) - структура данных для компонентов связности
+template <typename Trace = NoTrace>
 class UnionFind
 {
     std::vector<int> parent; // Родитель каждой вершины
     std::vector<int> rank;   // Ранг для оптимизации (ранг дерева)
-    bool verbose;             // Режим детального вывода
+    Trace verbose;            // Режим детального вывода
 
 public:
     // Конструктор: создаем структуру для V вершин
@@ -135,12 +138,13 @@ public:
 };
 
 // Класс для представления неориентированного взвешенного графа
+template <typename Trace = NoTrace>
 class Graph
 {
     int numVertices;              // Количество вершин
     std::vector<Edge> edges;     // Список всех рёбер
     std::vector<std::vector<Edge>> adj; // Список смежности (для поиска минимальных рёбер)
-    bool verbose;                 // Режим детального вывода
+    Trace verbose;                // Режим детального вывода
 
 public:
     // Конструктор: создаем граф с заданным количеством вершин
@@ -183,7 +187,7 @@ public:
         std::cout << "  - Повторяет, пока не останется один компонент\n" << std::endl;
         
         // Инициализируем Union-Find структуру
-        UnionFind uf(numVertices, verbose);
+        UnionFind<Trace> uf(numVertices, static_cast<bool>(verbose));
         
         std::vector<Edge> mstEdges; // Рёбра MST для финального вывода
         int totalWeight = 0;
@@ -343,7 +347,7 @@ int main()
     //     2
     //     |
     //     3
-    Graph g1(4, true);
+    Graph<VerboseTrace> g1(4, true);
     g1.addEdge(0, 1, 1);
     g1.addEdge(0, 2, 4);
     g1.addEdge(1, 2, 2);
@@ -354,7 +358,7 @@ int main()
     std::cout << "  ТЕСТ 2: Полный граф K4" << std::endl;
     std::cout << "========================================" << std::endl;
     // Тест 2: Полный граф (все вершины соединены)
-    Graph g2(4, true);
+    Graph<VerboseTrace> g2(4, true);
     g2.addEdge(0, 1, 10);
     g2.addEdge(0, 2, 6);
     g2.addEdge(0, 3, 5);
@@ -368,7 +372,7 @@ int main()
     std::cout << "========================================" << std::endl;
     // Тест 3: Линейная цепь (уже является деревом)
     // 0 --2-- 1 --3-- 2 --1-- 3 --4-- 4
-    Graph g3(5, true);
+    Graph<VerboseTrace> g3(5, true);
     g3.addEdge(0, 1, 2);
     g3.addEdge(1, 2, 3);
     g3.addEdge(2, 3, 1);
@@ -390,7 +394,7 @@ int main()
     //      1  6  4
     //       \ | /
     //         6
-    Graph g4(7, true);
+    Graph<VerboseTrace> g4(7, true);
     g4.addEdge(0, 1, 2);
     g4.addEdge(0, 2, 5);
     g4.addEdge(0, 3, 3);
@@ -405,7 +409,7 @@ int main()
     std::cout << "  ТЕСТ 5: Большой граф (без детального вывода)" << std::endl;
     std::cout << "========================================" << std::endl;
     // Тест 5: Большой граф
-    Graph g5(9, false);
+    Graph<> g5(9, false);
     g5.addEdge(0, 1, 4);
     g5.addEdge(0, 7, 8);
     g5.addEdge(1, 2, 8);
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+// ========================================================================
+// ОСВОБОЖДЕНИЕ ПАМЯТИ ПО ЭПОХАМ (epoch-based reclamation, Fraser)
+// ========================================================================
+// Читатели обходят структуру без блокировок, а писатель заменяет её части
+// новыми. Старую часть нельзя удалить сразу: читатель мог прочитать
+// указатель на неё мгновением раньше. Эпохи отвечают на вопрос "когда
+// уже можно":
+//
+//   global        - номер текущей эпохи (растёт на 1)
+//   слот читателя - эпоха, в которой читатель вошёл в критическую секцию
+//                   (pin), или 0, если читатель сейчас вне её
+//
+//   pin()    - читатель записывает в свой слот текущую global; только
+//              после этого он читает указатели структуры
+//   retire() - писатель, уже убравший объект из структуры, откладывает
+//              его удаление с пометкой "эпоха E = global"
+//   collect()- если все активные читатели уже в эпохе global, её можно
+//              сдвинуть: global + 1. Объекты с пометкой E удаляются, когда
+//              global >= E + 2: каждый читатель, который мог их видеть
+//              (вошёл в эпоху <= E), к этому моменту вышел из секции.
+//
+// Все операции над global и слотами - seq_cst: запись в слот в pin и
+// проверка слотов в collect упорядочены, поэтому читатель, прочитавший
+// эпоху E + 1, видит и убранный до её начала указатель.
+//
+// Писатель (retire, collect) - один поток. Слотов фиксированное число,
+// каждый читающий поток занимает свой через Participant.
+// ========================================================================
+
+class EpochDomain
+{
+    struct alignas(64) Slot // Отдельная кэш-линия: читатели не мешают друг другу
+    {
+        std::atomic<std::uint64_t> epoch{0};
+        std::atomic<bool> taken{false};
+    };
+
+    struct Retired
+    {
+        std::uint64_t epoch;
+        std::function<void()> reclaim;
+    };
+
+    std::atomic<std::uint64_t> global{1};
+    std::unique_ptr<Slot[]> slots;
+    int slotCount;
+    std::deque<Retired> limbo; // Отложенные удаления по возрастанию эпохи
+
+public:
+    // --------------------------------------------------------------------
+    // Участник (читающий поток) - владеет слотом
+    // --------------------------------------------------------------------
+    class Participant
+    {
+        EpochDomain* domain = nullptr;
+        Slot* slot = nullptr;
+        int depth = 0; // Вложенные pin() не сбрасывают эпоху
+
+    public:
+        Participant() = default;
+
+        explicit Participant(EpochDomain& owner) : domain(&owner), slot(owner.takeSlot()) {}
+
+        Participant(Participant&& other) noexcept
+            : domain(std::exchange(other.domain, nullptr)), slot(std::exchange(other.slot, nullptr)),
+              depth(std::exchange(other.depth, 0))
+        {
+        }
+
+        Participant& operator=(Participant&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                domain = std::exchange(other.domain, nullptr);
+                slot = std::exchange(other.slot, nullptr);
+                depth = std::exchange(other.depth, 0);
+            }
+            return *this;
+        }
+
+        Participant(const Participant&) = delete;
+        Participant& operator=(const Participant&) = delete;
+
+        ~Participant() { release(); }
+
+        void pin()
+        {
+            if (depth++ == 0)
+                slot->epoch.store(domain->global.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        }
+
+        void unpin()
+        {
+            if (--depth == 0)
+                slot->epoch.store(0, std::memory_order_release);
+        }
+
+        bool pinned() const { return depth > 0; }
+
+    private:
+        void release()
+        {
+            if (slot == nullptr)
+                return;
+            slot->epoch.store(0, std::memory_order_release);
+            slot->taken.store(false, std::memory_order_release);
+            slot = nullptr;
+            domain = nullptr;
+            depth = 0;
+        }
+    };
+
+    // Критическая секция читателя на время жизни объекта
+    class Guard
+    {
+        Participant& participant;
+
+    public:
+        explicit Guard(Participant& owner) : participant(owner) { participant.pin(); }
+        ~Guard() { participant.unpin(); }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    };
+
+    explicit EpochDomain(int maxParticipants = 128)
+        : slots(new Slot[static_cast<std::size_t>(maxParticipants)]), slotCount(maxParticipants)
+    {
+    }
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    // Участников к этому моменту уже нет: всё отложенное удаляется
+    ~EpochDomain() { drain(); }
+
+    Participant participant() { return Participant(*this); }
+
+    // --------------------------------------------------------------------
+    // Операции писателя
+    // --------------------------------------------------------------------
+    // reclaim вызывается, когда ни один читатель не может видеть объект
+    void retire(std::function<void()> reclaim)
+    {
+        limbo.push_back({global.load(std::memory_order_seq_cst), std::move(reclaim)});
+    }
+
+    // Сдвинуть эпоху, если можно, и выполнить созревшие удаления.
+    // Возвращает число выполненных reclaim
+    std::size_t collect()
+    {
+        tryAdvance();
+        std::uint64_t now = global.load(std::memory_order_relaxed);
+        std::size_t done = 0;
+        while (!limbo.empty() && limbo.front().epoch + 2 <= now)
+        {
+            std::function<void()> reclaim = std::move(limbo.front().reclaim);
+            limbo.pop_front();
+            reclaim();
+            done++;
+        }
+        return done;
+    }
+
+    // Выполнить все отложенные удаления (читателей быть не должно)
+    void drain()
+    {
+        while (!limbo.empty())
+        {
+            std::function<void()> reclaim = std::move(limbo.front().reclaim);
+            limbo.pop_front();
+            reclaim();
+        }
+    }
+
+    std::uint64_t epoch() const { return global.load(std::memory_order_relaxed); }
+    std::size_t pending() const { return limbo.size(); }
+
+private:
+    Slot* takeSlot()
+    {
+        for (int i = 0; i < slotCount; i++)
+        {
+            bool expected = false;
+            if (!slots[i].taken.load(std::memory_order_relaxed) &&
+                slots[i].taken.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                return &slots[i];
+        }
+        throw std::runtime_error("EpochDomain: все слоты участников заняты");
+    }
+
+    void tryAdvance()
+    {
+        std::uint64_t current = global.load(std::memory_order_seq_cst);
+        for (int i = 0; i < slotCount; i++)
+        {
+            std::uint64_t seen = slots[i].epoch.load(std::memory_order_seq_cst);
+            if (seen != 0 && seen != current)
+                return;
+        }
+        global.store(current + 1, std::memory_order_seq_cst);
+    }
+};
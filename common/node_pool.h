@@ -0,0 +1,266 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ========================================================================
+// ПУЛ УЗЛОВ: СЛЯБЫ, СПИСОК СВОБОДНЫХ БЛОКОВ И МАССОВОЕ ОСВОБОЖДЕНИЕ
+// ========================================================================
+// Деревья выделяют память под каждый узел отдельно (new AVLNode(val),
+// new RBNode(val), ...), а освобождают рекурсивным обходом destroyTree.
+// Глобальный распределитель универсален: он ищет блок подходящего
+// размера, хранит служебный заголовок, синхронизирует потоки. Узлы
+// дерева же все одного размера, поэтому их выгоднее нарезать из больших
+// кусков памяти (слябов):
+//   - выделение - снятие блока со списка свободных или сдвиг указателя
+//     в текущем слябе, освобождение - запись блока в голову списка;
+//   - удалённые узлы переиспользуются следующими вставками (память не
+//     возвращается системе и не дробится);
+//   - соседние по времени создания узлы лежат рядом в памяти;
+//   - release() отдаёт все слябы разом - O(число слябов), без обхода
+//     дерева. Деструкторы узлов при этом не вызываются: это допустимо,
+//     если узлы тривиально разрушаемы или уже разрушены.
+// Размер слябов растёт вдвое (от 16 блоков до ~256 КБ), так что маленькие
+// деревья не занимают лишнего, а у больших слябов немного.
+//
+// Пул не потокобезопасен: один пул - одно дерево (или один поток).
+//
+//   NodePool pool(sizeof(AVLNode), alignof(AVLNode));
+//   AVLNode* node = pool.create<AVLNode>(42);   // вместо new AVLNode(42)
+//   pool.destroy(node);                         // вместо delete node
+//   pool.release();                             // вместо destroyTree(root)
+// ========================================================================
+
+class NodePool
+{
+public:
+    static constexpr std::size_t FIRST_SLAB_BLOCKS = 16;
+    static constexpr std::size_t MAX_SLAB_BYTES = std::size_t(1) << 18;
+
+    // blockSize = 0 - размер блока задаётся позже через setBlockSize
+    explicit NodePool(std::size_t blockSize = 0, std::size_t alignment = alignof(std::max_align_t))
+    {
+        if (blockSize != 0)
+            setBlockSize(blockSize, alignment);
+    }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    ~NodePool()
+    {
+        release();
+    }
+
+    // Размер блока можно задать только до первого выделения
+    void setBlockSize(std::size_t size, std::size_t alignment)
+    {
+        assert(slabs.empty());
+        // В свободном блоке хранится указатель на следующий свободный
+        blockAlign = std::max(alignment, alignof(FreeBlock));
+        blockBytes = std::max(size, sizeof(FreeBlock));
+        blockBytes = (blockBytes + blockAlign - 1) / blockAlign * blockAlign;
+    }
+
+    // Подходит ли блок пула для объекта такого размера и выравнивания
+    bool fits(std::size_t size, std::size_t alignment) const
+    {
+        return blockBytes != 0 && size <= blockBytes && alignment <= blockAlign;
+    }
+
+    void* allocate()
+    {
+        assert(blockBytes != 0);
+        liveBlocks++;
+        if (freeList != nullptr)
+        {
+            FreeBlock* block = freeList;
+            freeList = block->next;
+            return block;
+        }
+        if (bumpNext == bumpEnd)
+            addSlab();
+        void* block = bumpNext;
+        bumpNext += blockBytes;
+        return block;
+    }
+
+    void deallocate(void* block)
+    {
+        liveBlocks--;
+        FreeBlock* freed = static_cast<FreeBlock*>(block);
+        freed->next = freeList;
+        freeList = freed;
+    }
+
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        assert(fits(sizeof(T), alignof(T)));
+        void* block = allocate();
+        try
+        {
+            return ::new (block) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(block);
+            throw;
+        }
+    }
+
+    template <typename T>
+    void destroy(T* object)
+    {
+        object->~T();
+        deallocate(object);
+    }
+
+    // Массовое освобождение: все блоки пула становятся недействительными
+    void release()
+    {
+        for (Slab& slab : slabs)
+            ::operator delete(slab.memory, std::align_val_t(blockAlign));
+        slabs.clear();
+        freeList = nullptr;
+        bumpNext = bumpEnd = nullptr;
+        liveBlocks = 0;
+        capacityBlocks = 0;
+    }
+
+    std::size_t blockSize() const { return blockBytes; }
+    std::size_t slabCount() const { return slabs.size(); }
+    std::size_t capacity() const { return capacityBlocks; }  // Блоков во всех слябах
+    std::size_t inUse() const { return liveBlocks; }         // Выделено и не освобождено
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct Slab
+    {
+        void* memory;
+        std::size_t blocks;
+    };
+
+    void addSlab()
+    {
+        std::size_t blocks = slabs.empty() ? FIRST_SLAB_BLOCKS : slabs.back().blocks * 2;
+        blocks = std::max<std::size_t>(1, std::min(blocks, MAX_SLAB_BYTES / blockBytes));
+        slabs.reserve(slabs.size() + 1);
+        void* memory = ::operator new(blocks * blockBytes, std::align_val_t(blockAlign));
+        slabs.push_back({memory, blocks});
+        bumpNext = static_cast<char*>(memory);
+        bumpEnd = bumpNext + blocks * blockBytes;
+        capacityBlocks += blocks;
+    }
+
+    std::size_t blockBytes = 0;
+    std::size_t blockAlign = alignof(std::max_align_t);
+    FreeBlock* freeList = nullptr;
+    char* bumpNext = nullptr;  // Ещё не выданная часть последнего сляба
+    char* bumpEnd = nullptr;
+    std::vector<Slab> slabs;
+    std::size_t liveBlocks = 0;
+    std::size_t capacityBlocks = 0;
+};
+
+// ========================================================================
+// PoolAllocator<T> - РАСПРЕДЕЛИТЕЛЬ STL ПОВЕРХ NodePool
+// ========================================================================
+// Подставляется в словари из common/tree_map.h и в std::map:
+//
+//   using Alloc = PoolAllocator<std::pair<const int, long>>;
+//   AVLMap<int, long, std::less<int>, Alloc> m;
+//   std::map<int, long, std::less<int>, Alloc> s;
+//
+// Контейнер переназначает (rebind) распределитель на тип своего узла;
+// размер блока берётся из первого выделения одного объекта - это и есть
+// узел. Выделения массивов (n > 1) и объектов крупнее блока идут в
+// глобальный operator new.
+//
+// Копии распределителя разделяют пул (так требует стандарт: память,
+// выделенная одной копией, освобождается другой). Перемещение - тоже
+// копия, иначе перемещённый контейнер остался бы без пула. Копия
+// контейнера получает новый пул (select_on_container_copy_construction).
+//
+// Если распределитель словаря - единственный владелец пула (ownsPool),
+// словарь при уничтожении и clear() отдаёт пул целиком (releasePool)
+// вместо обхода всех узлов.
+// ========================================================================
+
+template <typename T>
+class PoolAllocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = PoolAllocator<U>;
+    };
+
+    PoolAllocator() : pool(std::make_shared<NodePool>())
+    {
+    }
+
+    PoolAllocator(const PoolAllocator&) = default;
+    PoolAllocator& operator=(const PoolAllocator&) = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) : pool(other.pool)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if (n == 1)
+        {
+            if (pool->blockSize() == 0)
+                pool->setBlockSize(sizeof(T), alignof(T));
+            if (pool->fits(sizeof(T), alignof(T)))
+                return static_cast<T*>(pool->allocate());
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        if (n == 1 && pool->fits(sizeof(T), alignof(T)))
+            pool->deallocate(p);
+        else
+            ::operator delete(p, std::align_val_t(alignof(T)));
+    }
+
+    PoolAllocator select_on_container_copy_construction() const
+    {
+        return PoolAllocator();
+    }
+
+    bool ownsPool() const { return pool.use_count() == 1; }
+    void releasePool() { pool->release(); }
+    const NodePool& nodePool() const { return *pool; }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const { return pool == other.pool; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& other) const { return pool != other.pool; }
+
+private:
+    template <typename U>
+    friend class PoolAllocator;
+
+    std::shared_ptr<NodePool> pool;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+// ========================================================================
+// ПОЛИТИКИ ТРАССИРОВКИ УЧЕБНЫХ АЛГОРИТМОВ
+// ========================================================================
+// Учебные классы (Graph, UnionFind, AVLTree, ...) печатают каждый шаг,
+// проверяя флаг verbose прямо во внутренних циклах. Флаг - параметр шаблона:
+//
+//   Graph<VerboseTrace> g(6, true);   // учебный режим: печать шагов
+//   Graph<> g(6);                      // рабочий режим (NoTrace)
+//
+// В классе поле объявлено как "Trace verbose;", а проверки остаются
+// обычными "if (verbose)". У NoTrace преобразование в bool - constexpr
+// false, поэтому компилятор удаляет ветку целиком: вывод, строки и вызовы
+// print* (например, printPriorityQueue, копирующий всю очередь). В рабочем
+// режиме в горячем цикле не остаётся ни проверки, ни кода трассировки.
+// ========================================================================
+
+// Трассировка скомпилирована, печать включается флагом во время выполнения
+struct VerboseTrace
+{
+    bool enabled;
+
+    VerboseTrace(bool on = true) : enabled(on) {}
+
+    explicit operator bool() const { return enabled; }
+};
+
+// Трассировка вырезана при компиляции (аргумент конструктора игнорируется,
+// чтобы оба режима создавались одинаково)
+struct NoTrace
+{
+    constexpr NoTrace(bool = false) {}
+
+    constexpr explicit operator bool() const { return false; }
+};
@@ -0,0 +1,699 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "tree_map.h"
+#include "../graph_common/thread_pool.h"
+
+// ========================================================================
+// JOIN-ОПЕРАЦИИ НАД СЛОВАРЯМИ: МАССОВОЕ ПОСТРОЕНИЕ, SPLIT, ОБЪЕДИНЕНИЕ
+// ========================================================================
+// Всё строится на одной операции, своей для каждого вида дерева:
+//
+//   join(L, k, R) - дерево из L, узла k и R, где все ключи L < k < все
+//   ключи R. Стоимость O(|h(L) - h(R)| + 1): по правому краю более
+//   высокого дерева спускаемся до поддерева высоты второго, подвешиваем
+//   туда k и восстанавливаем баланс на обратном пути.
+//     AVLMap    - сравниваются высоты (join by rank)
+//     RBTreeMap - сравниваются чёрные высоты (join by black height)
+//     TreapMap  - сравниваются приоритеты: k опускается по краю того
+//                 дерева, чей корень приоритетнее (ожидаемо O(log n))
+//
+// Остальное - общее (Blelloch, Ferizovic, Sun, "Just Join for Parallel
+// Ordered Sets"):
+//   split(T, key)   - O(log n): рекурсивно по пути к key, поддеревья
+//                     с другой стороны собираются обратно через join
+//   join2(L, R)     - join без среднего узла: им становится максимум L
+//   bulkLoad        - отсортированный диапазон за O(n): середина + join
+//                     двух половин почти равной высоты стоит O(1)
+//   union / intersection / difference (A, B) - корень A делит B через
+//                     split; половины обрабатываются независимо и
+//                     собираются join / join2. O(m log(n / m + 1)) для
+//                     m <= n - объединение маленького снимка с большим
+//                     не трогает большую часть дерева.
+//   insertBatch     - пакет в любом порядке: сортировка, bulkLoad, union
+//   eraseBatch      - разность с отсортированным массивом ключей: ключ
+//                     корня делит массив двоичным поиском
+//
+// Параллельность. Половины независимы, поэтому верхние уровни рекурсии
+// (до 4 * потоков подзадач) выполняются последовательно, а получившиеся
+// пары поддеревьев раздаются ThreadPool::parallelFor. Подзадачи не
+// выделяют и не освобождают память (узлы только перевешиваются), лишние
+// узлы удаляются после параллельной фазы - подходит и однопоточный
+// PoolAllocator.
+//
+// Операции над двумя словарями забирают узлы второго (аргумент -
+// rvalue): копирования нет, при совпадении ключей остаётся значение
+// из *this (как в std::map::merge). Распределители словарей должны быть
+// равны, иначе std::invalid_argument.
+//
+// Наследник реализует:
+//   Node* joinNodes(Node* left, Node* mid, Node* right)
+// left и right - отдельные деревья (parent корня == nullptr, могут быть
+// пустыми), mid - отдельный узел; результат - корень с parent == nullptr.
+// joinNodes не должен трогать поля словаря: его вызывают потоки пула.
+// Необязательно: void prepareNode(Node*) - для новых узлов bulkLoad и
+// insertBatch (по умолчанию ничего не делает); свои splitTree и splitLast -
+// если высоту для join нельзя прочитать в узле за O(1), их рекурсия
+// передаёт высоты поддеревьев вниз (так делает RBTreeMap), иначе каждый
+// join на пути split дороже O(1) и split стоит O(log^2 n).
+// ========================================================================
+
+template <typename Derived, typename Key, typename Value, typename Compare, typename Allocator, typename Balance,
+          typename Augment = NoAugment>
+class JoinableTreeMap : public TreeMapBase<Derived, Key, Value, Compare, Allocator, Balance, Augment>
+{
+protected:
+    using MapBase = TreeMapBase<Derived, Key, Value, Compare, Allocator, Balance, Augment>;
+    using Node = typename MapBase::Node;
+
+public:
+    using MapBase::MapBase;
+    using typename MapBase::allocator_type;
+    using typename MapBase::size_type;
+
+    // --------------------------------------------------------------------
+    // Массовое построение
+    // --------------------------------------------------------------------
+    // Замена содержимого парами из [first, last) за O(n). Ключи должны
+    // строго возрастать, иначе std::invalid_argument (словарь не меняется)
+    template <typename InputIt>
+    void bulkLoad(InputIt first, InputIt last)
+    {
+        std::vector<Node*> nodes = createNodes(first, last);
+        for (std::size_t i = 1; i < nodes.size(); i++)
+        {
+            if (!this->compare(nodes[i - 1]->kv.first, nodes[i]->kv.first))
+            {
+                for (Node* node : nodes)
+                    this->destroyNode(node);
+                throw std::invalid_argument("bulkLoad: ключи должны строго возрастать");
+            }
+        }
+        this->clear();
+        setRoot(buildFromSorted(nodes, 0, static_cast<std::ptrdiff_t>(nodes.size()) - 1));
+        this->nodeCount = nodes.size();
+    }
+
+    // --------------------------------------------------------------------
+    // Пакетные вставка и удаление
+    // --------------------------------------------------------------------
+    // Вставить пары из [first, last) в любом порядке: пакет сортируется,
+    // собирается в дерево за O(k) и вливается через unionWith. Ключи,
+    // которые уже есть, и повторы внутри пакета не перезаписываются (как у
+    // std::map::insert(first, last)). Возвращает число вставленных ключей
+    template <typename InputIt>
+    size_type insertBatch(InputIt first, InputIt last) { return insertBatchImpl(first, last, nullptr); }
+
+    template <typename InputIt>
+    size_type insertBatch(InputIt first, InputIt last, ThreadPool& pool)
+    {
+        return insertBatchImpl(first, last, &pool);
+    }
+
+    // Удалить ключи из [first, last) в любом порядке. Отсортированные ключи
+    // делятся ключом корня двоичным поиском, поддеревья обрабатываются
+    // независимо - поддерево без ключей пакета не посещается. Возвращает
+    // число удалённых ключей
+    template <typename InputIt>
+    size_type eraseBatch(InputIt first, InputIt last) { return eraseBatchImpl(first, last, nullptr); }
+
+    template <typename InputIt>
+    size_type eraseBatch(InputIt first, InputIt last, ThreadPool& pool)
+    {
+        return eraseBatchImpl(first, last, &pool);
+    }
+
+    // --------------------------------------------------------------------
+    // Разделение и склейка
+    // --------------------------------------------------------------------
+    // Ключи >= key переходят в возвращаемый словарь, < key остаются.
+    // Перестройка дерева - O(log n). Без Augment размеры частей узнаются
+    // обходом той из них, что меньше (обе обходятся поочерёдно до конца
+    // одной) - O(min(k, n - k)); с Augment размер хранится в корне
+    Derived splitFrom(const Key& key)
+    {
+        Derived rest(this->compare, allocator_type(this->allocator));
+        SplitResult parts = derived().splitTree(detachRoot(), key);
+        Node* right = parts.match == nullptr ? parts.right : derived().joinNodes(nullptr, parts.match, parts.right);
+        size_type rightCount;
+        if constexpr (MapBase::AUGMENTED)
+            rightCount = MapBase::sizeOf(right);
+        else
+            rightCount = countSmallerSide(parts.left, right, this->nodeCount);
+        setRoot(parts.left);
+        rest.setRoot(right);
+        rest.nodeCount = rightCount;
+        this->nodeCount -= rightCount;
+        return rest;
+    }
+
+    // Приклеить other справа за O(log n): все ключи *this меньше ключей other
+    void join(Derived&& other)
+    {
+        checkAllocator(other);
+        if (other.root == nullptr || &other == this)
+            return;
+        if (this->root != nullptr && !this->compare(treeMaximum(this->root)->kv.first, treeMinimum(other.root)->kv.first))
+            throw std::invalid_argument("join: ключи должны быть меньше ключей присоединяемого словаря");
+        setRoot(join2(detachRoot(), other.detachRoot()));
+        this->nodeCount += other.nodeCount;
+        other.nodeCount = 0;
+    }
+
+    // --------------------------------------------------------------------
+    // Теоретико-множественные операции (по ключам)
+    // --------------------------------------------------------------------
+    void unionWith(Derived&& other) { setOperation<SetOp::Union>(other, nullptr); }
+    void unionWith(Derived&& other, ThreadPool& pool) { setOperation<SetOp::Union>(other, &pool); }
+
+    void intersectWith(Derived&& other) { setOperation<SetOp::Intersection>(other, nullptr); }
+    void intersectWith(Derived&& other, ThreadPool& pool) { setOperation<SetOp::Intersection>(other, &pool); }
+
+    // Удалить ключи, которые есть в other
+    void subtract(Derived&& other) { setOperation<SetOp::Difference>(other, nullptr); }
+    void subtract(Derived&& other, ThreadPool& pool) { setOperation<SetOp::Difference>(other, &pool); }
+
+protected:
+    enum class SetOp
+    {
+        Union,
+        Intersection,
+        Difference
+    };
+
+    struct SplitResult
+    {
+        Node* left = nullptr;
+        Node* match = nullptr;  // Узел с ключом key (отдельный) или nullptr
+        Node* right = nullptr;
+    };
+
+    // Подзадача параллельной фазы и узел её "плана" (верхние уровни рекурсии)
+    struct SetTask
+    {
+        Node* a;
+        Node* b;
+        Node* result;
+    };
+
+    struct SetFrame
+    {
+        Node* pivot;    // Корень поддерева A
+        Node* match;    // Узел B с тем же ключом или nullptr
+        int left;       // >= 0 - индекс кадра, < 0 - подзадача ~left
+        int right;
+    };
+
+    // То же для eraseBatch: поддерево и его отрезок отсортированных ключей
+    struct EraseTask
+    {
+        Node* tree;
+        std::size_t lo;
+        std::size_t hi;
+        Node* result;
+    };
+
+    struct EraseFrame
+    {
+        Node* pivot;
+        bool found;     // Ключ pivot есть в пакете
+        int left;
+        int right;
+    };
+
+    Derived& derived() { return static_cast<Derived&>(*this); }
+
+    // --------------------------------------------------------------------
+    // Вспомогательные операции над отдельными поддеревьями
+    // --------------------------------------------------------------------
+    Node* detachRoot()
+    {
+        Node* top = this->root;
+        this->root = nullptr;
+        return top;
+    }
+
+    void setRoot(Node* top)
+    {
+        this->root = top;
+        if (top != nullptr)
+            top->parent = nullptr;
+    }
+
+    // Отделить детей узла: три независимых дерева
+    static void detachChildren(Node* node, Node*& left, Node*& right)
+    {
+        left = node->left;
+        right = node->right;
+        node->left = node->right = nullptr;
+        if (left != nullptr)
+            left->parent = nullptr;
+        if (right != nullptr)
+            right->parent = nullptr;
+    }
+
+    // Узел mid с поддеревьями left и right (для joinNodes наследников)
+    static Node* link(Node* left, Node* mid, Node* right)
+    {
+        mid->left = left;
+        mid->right = right;
+        mid->parent = nullptr;
+        if (left != nullptr)
+            left->parent = mid;
+        if (right != nullptr)
+            right->parent = mid;
+        MapBase::pull(mid);
+        return mid;
+    }
+
+    // Другой ребёнок node уже на месте: аугментация node пересчитывается
+    static void setRight(Node* node, Node* child)
+    {
+        node->right = child;
+        if (child != nullptr)
+            child->parent = node;
+        MapBase::pull(node);
+    }
+
+    static void setLeft(Node* node, Node* child)
+    {
+        node->left = child;
+        if (child != nullptr)
+            child->parent = node;
+        MapBase::pull(node);
+    }
+
+    // Повороты отдельного поддерева: родитель нового корня - прежний
+    // родитель x, ссылку на поддерево в родителе обновляет вызывающий
+    static Node* rotateLeftSubtree(Node* x)
+    {
+        Node* y = x->right;
+        setRight(x, y->left);
+        y->parent = x->parent;
+        setLeft(y, x);
+        return y;
+    }
+
+    static Node* rotateRightSubtree(Node* x)
+    {
+        Node* y = x->left;
+        setLeft(x, y->right);
+        y->parent = x->parent;
+        setRight(y, x);
+        return y;
+    }
+
+    // Узлы для пар из [first, last); при исключении созданные удаляются
+    template <typename InputIt>
+    std::vector<Node*> createNodes(InputIt first, InputIt last)
+    {
+        std::vector<Node*> nodes;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                        typename std::iterator_traits<InputIt>::iterator_category>)
+            nodes.reserve(static_cast<std::size_t>(std::distance(first, last)));
+        try
+        {
+            for (; first != last; ++first)
+            {
+                Node* node = this->createNode(*first);
+                derived().prepareNode(node);
+                nodes.push_back(node);
+            }
+        }
+        catch (...)
+        {
+            for (Node* node : nodes)
+                this->destroyNode(node);
+            throw;
+        }
+        return nodes;
+    }
+
+    // Подготовка нового узла перед join (TreapMap назначает приоритет).
+    // Вызывается до параллельной фазы, поэтому может менять поля словаря
+    void prepareNode(Node*) {}
+
+    Node* buildFromSorted(const std::vector<Node*>& nodes, std::ptrdiff_t lo, std::ptrdiff_t hi)
+    {
+        if (lo > hi)
+            return nullptr;
+        std::ptrdiff_t mid = lo + (hi - lo) / 2;
+        Node* left = buildFromSorted(nodes, lo, mid - 1);
+        Node* right = buildFromSorted(nodes, mid + 1, hi);
+        return derived().joinNodes(left, nodes[mid], right);
+    }
+
+    SplitResult splitTree(Node* tree, const Key& key)
+    {
+        if (tree == nullptr)
+            return SplitResult();
+        Node* left;
+        Node* right;
+        detachChildren(tree, left, right);
+        if (this->compare(key, tree->kv.first))
+        {
+            SplitResult parts = splitTree(left, key);
+            parts.right = derived().joinNodes(parts.right, tree, right);
+            return parts;
+        }
+        if (this->compare(tree->kv.first, key))
+        {
+            SplitResult parts = splitTree(right, key);
+            parts.left = derived().joinNodes(left, tree, parts.left);
+            return parts;
+        }
+        return SplitResult{left, tree, right};
+    }
+
+    // Вырезать максимум: (дерево без максимума, узел максимума)
+    std::pair<Node*, Node*> splitLast(Node* tree)
+    {
+        Node* left;
+        Node* right;
+        detachChildren(tree, left, right);
+        if (right == nullptr)
+            return {left, tree};
+        std::pair<Node*, Node*> rest = splitLast(right);
+        return {derived().joinNodes(left, tree, rest.first), rest.second};
+    }
+
+    Node* join2(Node* left, Node* right)
+    {
+        if (left == nullptr)
+            return right;
+        if (right == nullptr)
+            return left;
+        std::pair<Node*, Node*> rest = derived().splitLast(left);
+        return derived().joinNodes(rest.first, rest.second, right);
+    }
+
+    // Число узлов в меньшем из двух деревьев (обход поочерёдно до конца
+    // одного из них); возвращается размер дерева b
+    static size_type countSmallerSide(Node* a, Node* b, size_type total)
+    {
+        Node* x = a == nullptr ? nullptr : treeMinimum(a);
+        Node* y = b == nullptr ? nullptr : treeMinimum(b);
+        size_type countA = 0;
+        size_type countB = 0;
+        while (x != nullptr && y != nullptr)
+        {
+            x = treeSuccessor(x);
+            y = treeSuccessor(y);
+            countA++;
+            countB++;
+        }
+        return y == nullptr ? countB : total - countA;
+    }
+
+    // --------------------------------------------------------------------
+    // Множественные операции
+    // --------------------------------------------------------------------
+    static void discard(std::vector<Node*>& garbage, Node* tree)
+    {
+        if (tree != nullptr)
+            garbage.push_back(tree);
+    }
+
+    // Сборка результата в узле рекурсии: pivot - узел A, match - узел B с
+    // тем же ключом (или nullptr), left / right - результаты для половин
+    template <SetOp Op>
+    Node* combine(Node* left, Node* pivot, Node* match, Node* right, std::vector<Node*>& garbage)
+    {
+        discard(garbage, match);
+        bool keepPivot = Op == SetOp::Union || (Op == SetOp::Intersection) == (match != nullptr);
+        if (keepPivot)
+            return derived().joinNodes(left, pivot, right);
+        discard(garbage, pivot);
+        return join2(left, right);
+    }
+
+    template <SetOp Op>
+    Node* setOpSequential(Node* a, Node* b, std::vector<Node*>& garbage)
+    {
+        if (a == nullptr)
+        {
+            if (Op == SetOp::Union)
+                return b;
+            discard(garbage, b);
+            return nullptr;
+        }
+        if (b == nullptr)
+        {
+            if (Op != SetOp::Intersection)
+                return a;
+            discard(garbage, a);
+            return nullptr;
+        }
+        SplitResult parts = derived().splitTree(b, a->kv.first);
+        Node* aLeft;
+        Node* aRight;
+        detachChildren(a, aLeft, aRight);
+        Node* left = setOpSequential<Op>(aLeft, parts.left, garbage);
+        Node* right = setOpSequential<Op>(aRight, parts.right, garbage);
+        return combine<Op>(left, a, parts.match, right, garbage);
+    }
+
+    // Верхние depth уровней рекурсии: split выполняется сразу, пары
+    // поддеревьев на нижнем уровне становятся подзадачами
+    int planSetOp(Node* a, Node* b, int depth, std::vector<SetTask>& tasks, std::vector<SetFrame>& frames)
+    {
+        if (depth == 0 || a == nullptr || b == nullptr)
+        {
+            tasks.push_back({a, b, nullptr});
+            return ~static_cast<int>(tasks.size() - 1);
+        }
+        SplitResult parts = derived().splitTree(b, a->kv.first);
+        Node* aLeft;
+        Node* aRight;
+        detachChildren(a, aLeft, aRight);
+        int left = planSetOp(aLeft, parts.left, depth - 1, tasks, frames);
+        int right = planSetOp(aRight, parts.right, depth - 1, tasks, frames);
+        frames.push_back({a, parts.match, left, right});
+        return static_cast<int>(frames.size() - 1);
+    }
+
+    template <SetOp Op>
+    Node* combinePlan(int index, std::vector<SetTask>& tasks, std::vector<SetFrame>& frames,
+                      std::vector<Node*>& garbage)
+    {
+        if (index < 0)
+            return tasks[~index].result;
+        SetFrame frame = frames[index];
+        Node* left = combinePlan<Op>(frame.left, tasks, frames, garbage);
+        Node* right = combinePlan<Op>(frame.right, tasks, frames, garbage);
+        return combine<Op>(left, frame.pivot, frame.match, right, garbage);
+    }
+
+    template <SetOp Op>
+    void setOperation(Derived& other, ThreadPool* pool)
+    {
+        checkAllocator(other);
+        if (&other == this)
+        {
+            if (Op == SetOp::Difference)
+                this->clear();
+            return;
+        }
+        size_type total = this->nodeCount + other.nodeCount;
+        Node* a = detachRoot();
+        Node* b = other.detachRoot();
+        other.nodeCount = 0;
+
+        std::vector<Node*> garbage;
+        Node* result;
+        if (pool == nullptr || pool->threadCount() == 1)
+            result = setOpSequential<Op>(a, b, garbage);
+        else
+        {
+            int depth = planDepth(*pool);
+            std::vector<SetTask> tasks;
+            std::vector<SetFrame> frames;
+            int top = planSetOp(a, b, depth, tasks, frames);
+            std::vector<std::vector<Node*>> taskGarbage(tasks.size());
+            pool->parallelFor(0, static_cast<std::int64_t>(tasks.size()), [&](std::int64_t i) {
+                SetTask& task = tasks[i];
+                task.result = setOpSequential<Op>(task.a, task.b, taskGarbage[i]);
+            });
+            result = combinePlan<Op>(top, tasks, frames, garbage);
+            for (std::vector<Node*>& list : taskGarbage)
+                garbage.insert(garbage.end(), list.begin(), list.end());
+        }
+
+        setRoot(result);
+        this->nodeCount = total - destroyGarbage(garbage);
+    }
+
+    // Уровней последовательного плана: до 4 * потоков подзадач
+    static int planDepth(const ThreadPool& pool)
+    {
+        int depth = 0;
+        while ((1 << depth) < 4 * pool.threadCount())
+            depth++;
+        return depth;
+    }
+
+    // --------------------------------------------------------------------
+    // Пакетные операции
+    // --------------------------------------------------------------------
+    template <typename InputIt>
+    size_type insertBatchImpl(InputIt first, InputIt last, ThreadPool* pool)
+    {
+        std::vector<Node*> nodes = createNodes(first, last);
+        std::stable_sort(nodes.begin(), nodes.end(),
+                         [this](const Node* a, const Node* b) { return this->compare(a->kv.first, b->kv.first); });
+        // Из повторов внутри пакета остаётся первый
+        std::size_t kept = 0;
+        for (Node* node : nodes)
+        {
+            if (kept > 0 && !this->compare(nodes[kept - 1]->kv.first, node->kv.first))
+                this->destroyNode(node);
+            else
+                nodes[kept++] = node;
+        }
+        nodes.resize(kept);
+
+        Derived batch(this->compare, allocator_type(this->allocator));
+        batch.setRoot(buildFromSorted(nodes, 0, static_cast<std::ptrdiff_t>(kept) - 1));
+        batch.nodeCount = kept;
+        size_type before = this->nodeCount;
+        setOperation<SetOp::Union>(batch, pool);
+        return this->nodeCount - before;
+    }
+
+    template <typename InputIt>
+    size_type eraseBatchImpl(InputIt first, InputIt last, ThreadPool* pool)
+    {
+        std::vector<Key> keys(first, last);
+        std::sort(keys.begin(), keys.end(), [this](const Key& a, const Key& b) { return this->compare(a, b); });
+        keys.erase(std::unique(keys.begin(), keys.end(),
+                               [this](const Key& a, const Key& b) { return !this->compare(a, b); }),
+                   keys.end());
+
+        Node* tree = detachRoot();
+        std::vector<Node*> garbage;
+        Node* result;
+        if (pool == nullptr || pool->threadCount() == 1)
+            result = eraseSequential(tree, keys, 0, keys.size(), garbage);
+        else
+        {
+            std::vector<EraseTask> tasks;
+            std::vector<EraseFrame> frames;
+            int top = planErase(tree, keys, 0, keys.size(), planDepth(*pool), tasks, frames);
+            std::vector<std::vector<Node*>> taskGarbage(tasks.size());
+            pool->parallelFor(0, static_cast<std::int64_t>(tasks.size()), [&](std::int64_t i) {
+                EraseTask& task = tasks[i];
+                task.result = eraseSequential(task.tree, keys, task.lo, task.hi, taskGarbage[i]);
+            });
+            result = combineErasePlan(top, tasks, frames, garbage);
+            for (std::vector<Node*>& list : taskGarbage)
+                garbage.insert(garbage.end(), list.begin(), list.end());
+        }
+
+        setRoot(result);
+        size_type removed = destroyGarbage(garbage);
+        this->nodeCount -= removed;
+        return removed;
+    }
+
+    // Граница отрезка ключей [lo, hi) по ключу key: левее - [lo, mid),
+    // правее - [mid + found, hi)
+    std::size_t splitKeys(const std::vector<Key>& keys, std::size_t lo, std::size_t hi, const Key& key,
+                          bool& found) const
+    {
+        auto it = std::lower_bound(keys.begin() + static_cast<std::ptrdiff_t>(lo),
+                                   keys.begin() + static_cast<std::ptrdiff_t>(hi), key,
+                                   [this](const Key& a, const Key& b) { return this->compare(a, b); });
+        std::size_t mid = static_cast<std::size_t>(it - keys.begin());
+        found = mid < hi && !this->compare(key, keys[mid]);
+        return mid;
+    }
+
+    Node* combineErase(Node* left, Node* pivot, bool found, Node* right, std::vector<Node*>& garbage)
+    {
+        if (!found)
+            return derived().joinNodes(left, pivot, right);
+        discard(garbage, pivot);
+        return join2(left, right);
+    }
+
+    Node* eraseSequential(Node* tree, const std::vector<Key>& keys, std::size_t lo, std::size_t hi,
+                          std::vector<Node*>& garbage)
+    {
+        if (tree == nullptr || lo == hi)
+            return tree;
+        bool found;
+        std::size_t mid = splitKeys(keys, lo, hi, tree->kv.first, found);
+        Node* left;
+        Node* right;
+        detachChildren(tree, left, right);
+        left = eraseSequential(left, keys, lo, mid, garbage);
+        right = eraseSequential(right, keys, found ? mid + 1 : mid, hi, garbage);
+        return combineErase(left, tree, found, right, garbage);
+    }
+
+    int planErase(Node* tree, const std::vector<Key>& keys, std::size_t lo, std::size_t hi, int depth,
+                  std::vector<EraseTask>& tasks, std::vector<EraseFrame>& frames)
+    {
+        if (depth == 0 || tree == nullptr || lo == hi)
+        {
+            tasks.push_back({tree, lo, hi, nullptr});
+            return ~static_cast<int>(tasks.size() - 1);
+        }
+        bool found;
+        std::size_t mid = splitKeys(keys, lo, hi, tree->kv.first, found);
+        Node* treeLeft;
+        Node* treeRight;
+        detachChildren(tree, treeLeft, treeRight);
+        int left = planErase(treeLeft, keys, lo, mid, depth - 1, tasks, frames);
+        int right = planErase(treeRight, keys, found ? mid + 1 : mid, hi, depth - 1, tasks, frames);
+        frames.push_back({tree, found, left, right});
+        return static_cast<int>(frames.size() - 1);
+    }
+
+    Node* combineErasePlan(int index, std::vector<EraseTask>& tasks, std::vector<EraseFrame>& frames,
+                           std::vector<Node*>& garbage)
+    {
+        if (index < 0)
+            return tasks[~index].result;
+        EraseFrame frame = frames[index];
+        Node* left = combineErasePlan(frame.left, tasks, frames, garbage);
+        Node* right = combineErasePlan(frame.right, tasks, frames, garbage);
+        return combineErase(left, frame.pivot, frame.found, right, garbage);
+    }
+
+    // Удалить отброшенные поддеревья; возвращает число удалённых узлов
+    size_type destroyGarbage(const std::vector<Node*>& garbage)
+    {
+        size_type removed = 0;
+        std::vector<Node*> stack;
+        for (Node* tree : garbage)
+        {
+            stack.push_back(tree);
+            while (!stack.empty())
+            {
+                Node* node = stack.back();
+                stack.pop_back();
+                removed++;
+                if (node->left != nullptr)
+                    stack.push_back(node->left);
+                if (node->right != nullptr)
+                    stack.push_back(node->right);
+            }
+            this->destroyTree(tree);
+        }
+        return removed;
+    }
+
+    void checkAllocator(const Derived& other) const
+    {
+        if (!(this->allocator == other.allocator))
+            throw std::invalid_argument("распределители словарей должны быть равны");
+    }
+};
@@ -0,0 +1,1077 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// ========================================================================
+// ОБЩАЯ ОСНОВА УПОРЯДОЧЕННЫХ СЛОВАРЕЙ НА БИНАРНЫХ ДЕРЕВЬЯХ ПОИСКА
+// ========================================================================
+// Учебные деревья (simple_avl.cxx, simple_rbtree.cxx, ...) хранят голый int
+// и умеют только insert / search. Словари AVLMap, RBTreeMap, SplayMap,
+// AAMap, ScapegoatMap и TreapMap построены на TreeMapBase и повторяют
+// интерфейс std::map (имена методов - как в стандартной библиотеке, чтобы
+// словари подставлялись вместо std::map без изменений):
+//
+//   AVLMap<std::string, std::unique_ptr<Index>, std::less<>> m;
+//   m.try_emplace("users", std::make_unique<Index>());   // move-only значения
+//   auto it = m.find(std::string_view("users"));       // гетерогенный поиск
+//   for (auto i = m.lower_bound("a"); i != m.end() && i->first < "b"; ++i) ...
+//
+// Узлы хранят указатель на родителя: итератор переходит к следующему ключу
+// за амортизированное O(1) без стека, а удаление по итератору не требует
+// повторного поиска. При удалении и перебалансировке узлы перевешиваются,
+// а не копируются: итераторы на остальные элементы остаются валидными,
+// значения не перемещаются (подходит для move-only типов).
+//
+// Наследник (CRTP) реализует только балансировку:
+//   void afterInsert(Node* node, int depth)  - новый лист на глубине depth
+//   void eraseNode(Node* node)               - вырезать узел из дерева
+//   void onAccess(Node* node)                - успешный поиск (splay)
+// Обход, поиск, выделение памяти и уничтожение - общие. Уничтожение и
+// копирование итеративные: глубина splay-дерева может достигать n.
+// С PoolAllocator (common/node_pool.h) узлы нарезаются из слябов, а
+// уничтожение словаря освобождает пул целиком.
+//
+// Последний параметр словарей - Augment (по умолчанию NoAugment): с ним
+// узлы хранят размеры поддеревьев и сводки, и появляются rank, select и
+// aggregate по диапазону ключей за O(log n):
+//
+//   AVLMap<int, long, std::less<int>, std::allocator<...>, ValueSum<long>> m;
+//   m.rank(100);           // сколько ключей < 100
+//   m.select(10)->first;   // 11-й по возрастанию ключ
+//   m.aggregate(100, 200); // сумма значений с ключами из [100, 200)
+// ========================================================================
+
+// Пустые данные балансировки (splay- и scapegoat-деревья)
+struct NoBalance
+{
+};
+
+// ------------------------------------------------------------------------
+// Аугментация: размеры поддеревьев и сводки (моноиды) в узлах
+// ------------------------------------------------------------------------
+// Политика Augment описывает моноид над парами словаря:
+//   using Summary = ...;                          - тип сводки
+//   static Summary identity();                    - нейтральный элемент
+//   static Summary lift(const Key&, const Value&) - сводка одной пары
+//   static Summary combine(const Summary&, const Summary&) - ассоциативна
+// Узел хранит размер и сводку своего поддерева (в порядке ключей: левое,
+// сам узел, правое). Их пересчитывает pull после каждого изменения
+// структуры - вставки, удаления, поворота, перестройки. Любая балансировка
+// меняет O(1) связей на шаг, поэтому цена - O(1) на поворот и O(log n) на
+// путь к корню. NoAugment - без полей в узле и без пересчётов.
+
+struct NoAugment
+{
+};
+
+// Только размеры поддеревьев: rank / select
+struct OrderStatistics
+{
+    struct Summary
+    {
+    };
+    static Summary identity() { return {}; }
+    template <typename Key, typename Value>
+    static Summary lift(const Key&, const Value&)
+    {
+        return {};
+    }
+    static Summary combine(const Summary&, const Summary&) { return {}; }
+};
+
+// Сумма значений (например, сумма заказов в диапазоне ключей)
+template <typename T>
+struct ValueSum
+{
+    using Summary = T;
+    static Summary identity() { return T(); }
+    template <typename Key, typename Value>
+    static Summary lift(const Key&, const Value& value)
+    {
+        return static_cast<T>(value);
+    }
+    static Summary combine(const Summary& a, const Summary& b) { return a + b; }
+};
+
+// Минимум значений (пустой диапазон - numeric_limits<T>::max())
+template <typename T>
+struct ValueMin
+{
+    using Summary = T;
+    static Summary identity() { return std::numeric_limits<T>::max(); }
+    template <typename Key, typename Value>
+    static Summary lift(const Key&, const Value& value)
+    {
+        return static_cast<T>(value);
+    }
+    static Summary combine(const Summary& a, const Summary& b) { return b < a ? b : a; }
+};
+
+// Сводка хранится, только если она не пустая (OrderStatistics - один размер)
+template <typename Augment, typename = void>
+struct HasSummary : std::false_type
+{
+};
+
+template <typename Augment>
+struct HasSummary<Augment, std::enable_if_t<!std::is_empty_v<typename Augment::Summary>>> : std::true_type
+{
+};
+
+template <typename Augment, bool WithSummary = HasSummary<Augment>::value>
+struct AugmentFields
+{
+    std::size_t size = 1;
+    typename Augment::Summary summary{};
+};
+
+template <typename Augment>
+struct AugmentFields<Augment, false>
+{
+    std::size_t size = 1;
+};
+
+template <>
+struct AugmentFields<NoAugment, false>
+{
+};
+
+template <typename Key, typename Value, typename Balance, typename Augment = NoAugment>
+struct TreeMapNode : AugmentFields<Augment>
+{
+    std::pair<const Key, Value> kv;
+    TreeMapNode* left = nullptr;
+    TreeMapNode* right = nullptr;
+    TreeMapNode* parent = nullptr;
+    Balance balance{};  // Высота / цвет / уровень / приоритет
+
+    template <typename... Args>
+    explicit TreeMapNode(Args&&... args) : kv(std::forward<Args>(args)...)
+    {
+    }
+};
+
+template <typename Node>
+Node* treeMinimum(Node* node)
+{
+    while (node->left != nullptr)
+        node = node->left;
+    return node;
+}
+
+template <typename Node>
+Node* treeMaximum(Node* node)
+{
+    while (node->right != nullptr)
+        node = node->right;
+    return node;
+}
+
+// Следующий по порядку узел (nullptr после максимума)
+template <typename Node>
+Node* treeSuccessor(Node* node)
+{
+    if (node->right != nullptr)
+        return treeMinimum(node->right);
+    Node* parent = node->parent;
+    while (parent != nullptr && node == parent->right)
+    {
+        node = parent;
+        parent = parent->parent;
+    }
+    return parent;
+}
+
+template <typename Node>
+Node* treePredecessor(Node* node)
+{
+    if (node->left != nullptr)
+        return treeMaximum(node->left);
+    Node* parent = node->parent;
+    while (parent != nullptr && node == parent->left)
+    {
+        node = parent;
+        parent = parent->parent;
+    }
+    return parent;
+}
+
+// Компаратор с is_transparent (std::less<>) разрешает гетерогенный поиск.
+// Параметр K делает проверку зависимой от аргумента шаблона метода (SFINAE)
+template <typename Compare, typename K, typename = void>
+struct IsTransparentCompare : std::false_type
+{
+};
+
+template <typename Compare, typename K>
+struct IsTransparentCompare<Compare, K, std::void_t<typename Compare::is_transparent>> : std::true_type
+{
+};
+
+// Распределитель с массовым освобождением пула (PoolAllocator из node_pool.h)
+template <typename Allocator, typename = void>
+struct HasPoolRelease : std::false_type
+{
+};
+
+template <typename Allocator>
+struct HasPoolRelease<Allocator, std::void_t<decltype(std::declval<const Allocator&>().ownsPool()),
+                                             decltype(std::declval<Allocator&>().releasePool())>>
+    : std::true_type
+{
+};
+
+template <typename Derived, typename Key, typename Value, typename Compare, typename Allocator, typename Balance,
+          typename Augment = NoAugment>
+class TreeMapBase
+{
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<const Key, Value>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = Compare;
+    using allocator_type = Allocator;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+protected:
+    using Node = TreeMapNode<Key, Value, Balance, Augment>;
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    // Гетерогенный поиск (find("abc") при Key = std::string) - только если
+    // компаратор прозрачный, как у std::map
+    template <typename K>
+    using EnableTransparent = std::enable_if_t<IsTransparentCompare<Compare, K>::value, int>;
+
+    static constexpr bool AUGMENTED = !std::is_same_v<Augment, NoAugment>;
+
+    Node* root = nullptr;
+    size_type nodeCount = 0;
+    Compare compare;
+    NodeAllocator allocator;
+
+public:
+    // --------------------------------------------------------------------
+    // Итераторы
+    // --------------------------------------------------------------------
+    template <bool IsConst>
+    class Iterator
+    {
+        friend class TreeMapBase;
+        using NodePtr = std::conditional_t<IsConst, const Node*, Node*>;
+        using TreePtr = std::conditional_t<IsConst, const TreeMapBase*, TreeMapBase*>;
+
+        NodePtr node = nullptr;  // nullptr - end()
+        TreePtr tree = nullptr;  // Нужно для --end()
+
+        Iterator(NodePtr n, TreePtr t) : node(n), tree(t) {}
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = TreeMapBase::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+        using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+
+        Iterator() = default;
+
+        // iterator -> const_iterator
+        template <bool C = IsConst, typename = std::enable_if_t<C>>
+        Iterator(const Iterator<false>& other) : node(other.node), tree(other.tree)
+        {
+        }
+
+        reference operator*() const { return node->kv; }
+        pointer operator->() const { return &node->kv; }
+
+        Iterator& operator++()
+        {
+            node = treeSuccessor(node);
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+        Iterator& operator--()
+        {
+            node = node == nullptr ? treeMaximum(tree->root) : treePredecessor(node);
+            return *this;
+        }
+        Iterator operator--(int)
+        {
+            Iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) { return a.node == b.node; }
+        friend bool operator!=(const Iterator& a, const Iterator& b) { return a.node != b.node; }
+
+        template <bool>
+        friend class Iterator;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // --------------------------------------------------------------------
+    // Создание, копирование, уничтожение
+    // --------------------------------------------------------------------
+    explicit TreeMapBase(const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : compare(comp), allocator(alloc)
+    {
+    }
+
+    // Копия повторяет форму исходного дерева (вместе с данными балансировки)
+    TreeMapBase(const TreeMapBase& other)
+        : compare(other.compare),
+          allocator(NodeTraits::select_on_container_copy_construction(other.allocator))
+    {
+        root = cloneTree(other.root);
+        nodeCount = other.nodeCount;
+    }
+
+    TreeMapBase(TreeMapBase&& other) noexcept
+        : root(other.root), nodeCount(other.nodeCount), compare(std::move(other.compare)),
+          allocator(std::move(other.allocator))
+    {
+        other.root = nullptr;
+        other.nodeCount = 0;
+    }
+
+    TreeMapBase& operator=(const TreeMapBase& other)
+    {
+        if (this != &other)
+        {
+            Node* copy = cloneTree(other.root);
+            clear();
+            root = copy;
+            nodeCount = other.nodeCount;
+            compare = other.compare;
+        }
+        return *this;
+    }
+
+    // Распределитель переносится вместе с узлами
+    TreeMapBase& operator=(TreeMapBase&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            root = other.root;
+            nodeCount = other.nodeCount;
+            compare = std::move(other.compare);
+            allocator = std::move(other.allocator);
+            other.root = nullptr;
+            other.nodeCount = 0;
+        }
+        return *this;
+    }
+
+    ~TreeMapBase()
+    {
+        destroyAll();
+    }
+
+    void clear()
+    {
+        destroyAll();
+        root = nullptr;
+        nodeCount = 0;
+    }
+
+    void swap(TreeMapBase& other) noexcept
+    {
+        using std::swap;
+        swap(root, other.root);
+        swap(nodeCount, other.nodeCount);
+        swap(compare, other.compare);
+        swap(allocator, other.allocator);
+    }
+
+    // --------------------------------------------------------------------
+    // Размер и обход
+    // --------------------------------------------------------------------
+    size_type size() const { return nodeCount; }
+    bool empty() const { return nodeCount == 0; }
+    key_compare key_comp() const { return compare; }
+    allocator_type get_allocator() const { return allocator_type(allocator); }
+
+    iterator begin() { return iterator(root == nullptr ? nullptr : treeMinimum(root), this); }
+    const_iterator begin() const { return const_iterator(root == nullptr ? nullptr : treeMinimum(root), this); }
+    const_iterator cbegin() const { return begin(); }
+    iterator end() { return iterator(nullptr, this); }
+    const_iterator end() const { return const_iterator(nullptr, this); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    // --------------------------------------------------------------------
+    // Поиск (для каждого - перегрузка с гетерогенным ключом)
+    // --------------------------------------------------------------------
+    iterator find(const Key& key) { return accessed(findNode(key)); }
+    const_iterator find(const Key& key) const { return const_iterator(findNode(key), this); }
+    template <typename K, EnableTransparent<K> = 0>
+    iterator find(const K& key) { return accessed(findNode(key)); }
+    template <typename K, EnableTransparent<K> = 0>
+    const_iterator find(const K& key) const { return const_iterator(findNode(key), this); }
+
+    bool contains(const Key& key) const { return findNode(key) != nullptr; }
+    template <typename K, EnableTransparent<K> = 0>
+    bool contains(const K& key) const { return findNode(key) != nullptr; }
+
+    size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+    template <typename K, EnableTransparent<K> = 0>
+    size_type count(const K& key) const { return contains(key) ? 1 : 0; }
+
+    // Первый ключ >= key
+    iterator lower_bound(const Key& key) { return iterator(lowerBoundNode(key), this); }
+    const_iterator lower_bound(const Key& key) const { return const_iterator(lowerBoundNode(key), this); }
+    template <typename K, EnableTransparent<K> = 0>
+    iterator lower_bound(const K& key) { return iterator(lowerBoundNode(key), this); }
+    template <typename K, EnableTransparent<K> = 0>
+    const_iterator lower_bound(const K& key) const { return const_iterator(lowerBoundNode(key), this); }
+
+    // Первый ключ > key
+    iterator upper_bound(const Key& key) { return iterator(upperBoundNode(key), this); }
+    const_iterator upper_bound(const Key& key) const { return const_iterator(upperBoundNode(key), this); }
+    template <typename K, EnableTransparent<K> = 0>
+    iterator upper_bound(const K& key) { return iterator(upperBoundNode(key), this); }
+    template <typename K, EnableTransparent<K> = 0>
+    const_iterator upper_bound(const K& key) const { return const_iterator(upperBoundNode(key), this); }
+
+    std::pair<iterator, iterator> equal_range(const Key& key) { return {lower_bound(key), upper_bound(key)}; }
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const
+    {
+        return {lower_bound(key), upper_bound(key)};
+    }
+    template <typename K, EnableTransparent<K> = 0>
+    std::pair<iterator, iterator> equal_range(const K& key) { return {lower_bound(key), upper_bound(key)}; }
+    template <typename K, EnableTransparent<K> = 0>
+    std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+    {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    Value& at(const Key& key)
+    {
+        Node* node = findNode(key);
+        if (node == nullptr)
+            throw std::out_of_range("TreeMap::at: ключ не найден");
+        return node->kv.second;
+    }
+    const Value& at(const Key& key) const
+    {
+        const Node* node = findNode(key);
+        if (node == nullptr)
+            throw std::out_of_range("TreeMap::at: ключ не найден");
+        return node->kv.second;
+    }
+
+    // --------------------------------------------------------------------
+    // Вставка
+    // --------------------------------------------------------------------
+    std::pair<iterator, bool> insert(const value_type& value) { return emplace(value); }
+    std::pair<iterator, bool> insert(value_type&& value) { return emplace(std::move(value)); }
+
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+            emplace(*first);
+    }
+
+    // Узел создаётся до поиска (ключ известен только после конструирования);
+    // если ключ уже есть - узел уничтожается
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        Node* node = createNode(std::forward<Args>(args)...);
+        Node* parent = nullptr;
+        Node** link = &root;
+        int depth = 0;
+        while (*link != nullptr)
+        {
+            parent = *link;
+            if (compare(node->kv.first, parent->kv.first))
+                link = &parent->left;
+            else if (compare(parent->kv.first, node->kv.first))
+                link = &parent->right;
+            else
+            {
+                destroyNode(node);
+                return {accessed(parent), false};
+            }
+            depth++;
+        }
+        return {iterator(linkNode(node, parent, link, depth), this), true};
+    }
+
+    // Значение конструируется только если ключа нет: аргументы (например,
+    // std::unique_ptr) при неудаче не расходуются
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+    {
+        Node* parent = nullptr;
+        Node** link = &root;
+        int depth = 0;
+        while (*link != nullptr)
+        {
+            parent = *link;
+            if (compare(key, parent->kv.first))
+                link = &parent->left;
+            else if (compare(parent->kv.first, key))
+                link = &parent->right;
+            else
+                return {accessed(parent), false};
+            depth++;
+        }
+        Node* node = createNode(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+        return {iterator(linkNode(node, parent, link, depth), this), true};
+    }
+
+    template <typename V>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, V&& value)
+    {
+        auto result = try_emplace(key, std::forward<V>(value));
+        if (!result.second)
+        {
+            result.first->second = std::forward<V>(value);
+            refresh(result.first);
+        }
+        return result;
+    }
+
+    template <typename V>
+    std::pair<iterator, bool> insert_or_assign(Key&& key, V&& value)
+    {
+        auto result = try_emplace(std::move(key), std::forward<V>(value));
+        if (!result.second)
+        {
+            result.first->second = std::forward<V>(value);
+            refresh(result.first);
+        }
+        return result;
+    }
+
+    Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+    Value& operator[](Key&& key) { return try_emplace(std::move(key)).first->second; }
+
+    // --------------------------------------------------------------------
+    // Удаление
+    // --------------------------------------------------------------------
+    // Возвращает итератор на следующий элемент
+    iterator erase(const_iterator pos)
+    {
+        Node* node = const_cast<Node*>(pos.node);
+        Node* next = treeSuccessor(node);
+        derived().eraseNode(node);
+        destroyNode(node);
+        nodeCount--;
+        return iterator(next, this);
+    }
+    iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        while (first != last)
+            first = erase(first);
+        return iterator(const_cast<Node*>(last.node), this);
+    }
+
+    size_type erase(const Key& key)
+    {
+        Node* node = findNode(key);
+        if (node == nullptr)
+            return 0;
+        erase(const_iterator(node, this));
+        return 1;
+    }
+
+    // --------------------------------------------------------------------
+    // Порядковые статистики и сводки (только с Augment, O(log n))
+    // --------------------------------------------------------------------
+    // Число ключей меньше key
+    size_type rank(const Key& key) const
+    {
+        static_assert(AUGMENTED, "rank требует Augment (например, OrderStatistics)");
+        size_type result = 0;
+        const Node* node = root;
+        while (node != nullptr)
+        {
+            if (compare(node->kv.first, key))
+            {
+                result += sizeOf(node->left) + 1;
+                node = node->right;
+            }
+            else
+                node = node->left;
+        }
+        return result;
+    }
+
+    // k-й по возрастанию ключ (с нуля); end(), если k >= size()
+    iterator select(size_type k) { return iterator(selectNode(k), this); }
+    const_iterator select(size_type k) const { return const_iterator(selectNode(k), this); }
+
+    // Сводка пар с ключами из [first, last)
+    template <typename A = Augment>
+    typename A::Summary aggregate(const Key& first, const Key& last) const
+    {
+        static_assert(HasSummary<A>::value, "aggregate требует Augment со сводкой (например, ValueSum)");
+        // Спуск до узла, где пути к first и last расходятся
+        const Node* node = root;
+        while (node != nullptr)
+        {
+            if (!compare(node->kv.first, last))
+                node = node->left;
+            else if (compare(node->kv.first, first))
+                node = node->right;
+            else
+                break;
+        }
+        if (node == nullptr)
+            return A::identity();
+        // Слева - ключи >= first (накапливаются справа налево)
+        typename A::Summary left = A::identity();
+        for (const Node* n = node->left; n != nullptr;)
+        {
+            if (compare(n->kv.first, first))
+                n = n->right;
+            else
+            {
+                left = A::combine(A::combine(liftNode(n), summaryOf(n->right)), left);
+                n = n->left;
+            }
+        }
+        // Справа - ключи < last (слева направо)
+        typename A::Summary right = A::identity();
+        for (const Node* n = node->right; n != nullptr;)
+        {
+            if (compare(n->kv.first, last))
+            {
+                right = A::combine(A::combine(right, summaryOf(n->left)), liftNode(n));
+                n = n->right;
+            }
+            else
+                n = n->left;
+        }
+        return A::combine(A::combine(left, liftNode(node)), right);
+    }
+
+    // Сводка всего словаря
+    template <typename A = Augment>
+    typename A::Summary aggregate() const
+    {
+        static_assert(HasSummary<A>::value, "aggregate требует Augment со сводкой (например, ValueSum)");
+        return summaryOf(root);
+    }
+
+    // Пересчитать сводки после изменения значения через итератор или
+    // operator[] (insert_or_assign делает это сам)
+    void refresh(const_iterator pos)
+    {
+        if constexpr (AUGMENTED)
+            pullPath(const_cast<Node*>(pos.node));
+    }
+
+    // Высота дерева (число узлов на самом длинном пути) - для сравнения деревьев
+    int height() const
+    {
+        int best = 0;
+        const Node* node = root;
+        const Node* prev = nullptr;
+        int depth = 0;
+        // Итеративный обход по родительским указателям
+        while (node != nullptr)
+        {
+            const Node* next;
+            if (prev == node->parent)
+            {
+                depth++;
+                best = std::max(best, depth);
+                next = node->left != nullptr ? node->left : (node->right != nullptr ? node->right : node->parent);
+            }
+            else if (prev == node->left && node->right != nullptr)
+                next = node->right;
+            else
+                next = node->parent;
+            if (next == node->parent)
+                depth--;
+            prev = node;
+            node = next;
+        }
+        return best;
+    }
+
+protected:
+    Derived& derived() { return static_cast<Derived&>(*this); }
+
+    iterator accessed(Node* node)
+    {
+        if (node != nullptr)
+            derived().onAccess(node);
+        return iterator(node, this);
+    }
+
+    // Балансировку по умолчанию при поиске не трогаем
+    void onAccess(Node*) {}
+
+    template <typename K>
+    Node* findNode(const K& key) const
+    {
+        Node* node = root;
+        while (node != nullptr)
+        {
+            if (compare(key, node->kv.first))
+                node = node->left;
+            else if (compare(node->kv.first, key))
+                node = node->right;
+            else
+                return node;
+        }
+        return nullptr;
+    }
+
+    template <typename K>
+    Node* lowerBoundNode(const K& key) const
+    {
+        Node* node = root;
+        Node* result = nullptr;
+        while (node != nullptr)
+        {
+            if (compare(node->kv.first, key))
+                node = node->right;
+            else
+            {
+                result = node;
+                node = node->left;
+            }
+        }
+        return result;
+    }
+
+    template <typename K>
+    Node* upperBoundNode(const K& key) const
+    {
+        Node* node = root;
+        Node* result = nullptr;
+        while (node != nullptr)
+        {
+            if (compare(key, node->kv.first))
+            {
+                result = node;
+                node = node->left;
+            }
+            else
+                node = node->right;
+        }
+        return result;
+    }
+
+    // --------------------------------------------------------------------
+    // Аугментация: пересчёт размера и сводки узла по детям
+    // --------------------------------------------------------------------
+    static size_type sizeOf(const Node* node)
+    {
+        if constexpr (AUGMENTED)
+            return node == nullptr ? 0 : node->size;
+        else
+            return 0;
+    }
+
+    template <typename A = Augment>
+    static typename A::Summary liftNode(const Node* node)
+    {
+        return A::lift(node->kv.first, node->kv.second);
+    }
+
+    template <typename A = Augment>
+    static typename A::Summary summaryOf(const Node* node)
+    {
+        return node == nullptr ? A::identity() : node->summary;
+    }
+
+    static void pull(Node* node)
+    {
+        if constexpr (AUGMENTED)
+        {
+            node->size = 1 + sizeOf(node->left) + sizeOf(node->right);
+            if constexpr (HasSummary<Augment>::value)
+                node->summary = Augment::combine(Augment::combine(summaryOf(node->left), liftNode(node)),
+                                                 summaryOf(node->right));
+        }
+    }
+
+    // Пересчёт от node до корня (изменилось поддерево node)
+    static void pullPath(Node* node)
+    {
+        if constexpr (AUGMENTED)
+        {
+            for (; node != nullptr; node = node->parent)
+                pull(node);
+        }
+    }
+
+    Node* selectNode(size_type k) const
+    {
+        static_assert(AUGMENTED, "select требует Augment (например, OrderStatistics)");
+        const Node* node = root;
+        while (node != nullptr)
+        {
+            size_type leftSize = sizeOf(node->left);
+            if (k < leftSize)
+                node = node->left;
+            else if (k == leftSize)
+                return const_cast<Node*>(node);
+            else
+            {
+                k -= leftSize + 1;
+                node = node->right;
+            }
+        }
+        return nullptr;
+    }
+
+    Node* linkNode(Node* node, Node* parent, Node** link, int depth)
+    {
+        node->parent = parent;
+        *link = node;
+        nodeCount++;
+        pull(node);
+        pullPath(parent);
+        derived().afterInsert(node, depth);
+        return node;
+    }
+
+    // --------------------------------------------------------------------
+    // Память узлов
+    // --------------------------------------------------------------------
+    template <typename... Args>
+    Node* createNode(Args&&... args)
+    {
+        Node* node = NodeTraits::allocate(allocator, 1);
+        try
+        {
+            NodeTraits::construct(allocator, node, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            NodeTraits::deallocate(allocator, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void destroyNode(Node* node)
+    {
+        NodeTraits::destroy(allocator, node);
+        NodeTraits::deallocate(allocator, node, 1);
+    }
+
+    // Уничтожение всего дерева. Если распределитель - единственный владелец
+    // пула узлов, пул отдаётся целиком; обход нужен лишь для деструкторов
+    void destroyAll()
+    {
+        if constexpr (HasPoolRelease<NodeAllocator>::value)
+        {
+            if (root != nullptr && allocator.ownsPool())
+            {
+                if constexpr (!std::is_trivially_destructible_v<Node>)
+                    destroyTree<false>(root);
+                allocator.releasePool();
+                return;
+            }
+        }
+        destroyTree(root);
+    }
+
+    // Без рекурсии: спускаемся к листу, удаляем его и поднимаемся к родителю
+    // (Deallocate = false - только деструкторы, память отдаст пул)
+    template <bool Deallocate = true>
+    void destroyTree(Node* node)
+    {
+        Node* stop = node == nullptr ? nullptr : node->parent;
+        while (node != stop)
+        {
+            if (node->left != nullptr)
+                node = node->left;
+            else if (node->right != nullptr)
+                node = node->right;
+            else
+            {
+                Node* parent = node->parent;
+                if (parent != stop)
+                {
+                    if (parent->left == node)
+                        parent->left = nullptr;
+                    else
+                        parent->right = nullptr;
+                }
+                if constexpr (Deallocate)
+                    destroyNode(node);
+                else
+                    NodeTraits::destroy(allocator, node);
+                node = parent;
+            }
+        }
+    }
+
+    // Данные балансировки и аугментации (размер, сводка)
+    static void copyNodeData(Node* target, const Node* source)
+    {
+        target->balance = source->balance;
+        static_cast<AugmentFields<Augment>&>(*target) = static_cast<const AugmentFields<Augment>&>(*source);
+    }
+
+    // Копия поддерева без рекурсии (форма и данные балансировки сохраняются)
+    Node* cloneTree(const Node* source)
+    {
+        if (source == nullptr)
+            return nullptr;
+        Node* copyRoot = createNode(source->kv);
+        copyNodeData(copyRoot, source);
+        const Node* s = source;
+        Node* d = copyRoot;
+        try
+        {
+            while (true)
+            {
+                if (s->left != nullptr && d->left == nullptr)
+                {
+                    d->left = createNode(s->left->kv);
+                    copyNodeData(d->left, s->left);
+                    d->left->parent = d;
+                    s = s->left;
+                    d = d->left;
+                }
+                else if (s->right != nullptr && d->right == nullptr)
+                {
+                    d->right = createNode(s->right->kv);
+                    copyNodeData(d->right, s->right);
+                    d->right->parent = d;
+                    s = s->right;
+                    d = d->right;
+                }
+                else if (s == source)
+                    break;
+                else
+                {
+                    s = s->parent;
+                    d = d->parent;
+                }
+            }
+        }
+        catch (...)
+        {
+            destroyTree(copyRoot);
+            throw;
+        }
+        return copyRoot;
+    }
+
+    // --------------------------------------------------------------------
+    // Структурные операции для наследников
+    // --------------------------------------------------------------------
+    // Заменить ребёнка oldChild узла parent (nullptr - корень) на newChild
+    void replaceChild(Node* parent, Node* oldChild, Node* newChild)
+    {
+        if (parent == nullptr)
+            root = newChild;
+        else if (parent->left == oldChild)
+            parent->left = newChild;
+        else
+            parent->right = newChild;
+        if (newChild != nullptr)
+            newChild->parent = parent;
+    }
+
+    // Левый поворот: правый ребёнок y поднимается на место x,
+    // левое поддерево y становится правым поддеревом x
+    void rotateLeft(Node* x)
+    {
+        Node* y = x->right;
+        x->right = y->left;
+        if (y->left != nullptr)
+            y->left->parent = x;
+        replaceChild(x->parent, x, y);
+        y->left = x;
+        x->parent = y;
+        pull(x);
+        pull(y);
+    }
+
+    void rotateRight(Node* x)
+    {
+        Node* y = x->left;
+        x->left = y->right;
+        if (y->right != nullptr)
+            y->right->parent = x;
+        replaceChild(x->parent, x, y);
+        y->right = x;
+        x->parent = y;
+        pull(x);
+        pull(y);
+    }
+
+    // Вырезать узел с не более чем одним ребёнком; возвращает родителя
+    Node* spliceOut(Node* node)
+    {
+        Node* parent = unlinkNode(node);
+        pullPath(parent);
+        return parent;
+    }
+
+    // То же без пересчёта аугментации (bstErase пересчитывает путь сам)
+    Node* unlinkNode(Node* node)
+    {
+        Node* child = node->left != nullptr ? node->left : node->right;
+        Node* parent = node->parent;
+        replaceChild(parent, node, child);
+        return parent;
+    }
+
+    // Удаление из обычного BST: узел с двумя детьми заменяется преемником
+    // (перевешиванием, преемник забирает и данные балансировки z).
+    // Возвращает узел, с которого начинается подъём перебалансировки
+    // (nullptr - удалён корень без детей или с одним ребёнком)
+    Node* bstErase(Node* z)
+    {
+        if (z->left == nullptr || z->right == nullptr)
+            return spliceOut(z);
+        Node* y = treeMinimum(z->right);
+        Node* from = y;
+        if (y->parent != z)
+        {
+            from = unlinkNode(y);
+            y->right = z->right;
+            y->right->parent = y;
+        }
+        replaceChild(z->parent, z, y);
+        y->left = z->left;
+        y->left->parent = y;
+        y->balance = z->balance;
+        pullPath(from);
+        return from;
+    }
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+
+#include "../graph_common/csr_graph.h"
+
+// Итеративный DFS на CSR-графе (тот же порядок обхода, что и Graph::DFS
+// в simple_dfs.cxx: соседи кладутся в стек в обратном порядке и помечаются
+// посещёнными в момент добавления). Возвращает порядок посещения вершин.
+inline std::vector<int> csrDFS(const CSRGraph& g, int startVertex)
+{
+    const int V = g.vertexCount();
+    std::vector<char> visited(V, 0);
+    std::vector<int> stack;
+    std::vector<int> order;
+    stack.reserve(V);
+    order.reserve(V);
+
+    visited[startVertex] = 1;
+    stack.push_back(startVertex);
+
+    while (!stack.empty())
+    {
+        int u = stack.back();
+        stack.pop_back();
+        order.push_back(u);
+
+        // Обратный порядок: первый сосед окажется наверху стека
+        for (std::int64_t e = g.edgeEnd(u) - 1; e >= g.edgeBegin(u); e--)
+        {
+            int v = g.target(e);
+            if (!visited[v])
+            {
+                visited[v] = 1;
+                stack.push_back(v);
+            }
+        }
+    }
+    return order;
+}
@@ -0,0 +1,344 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../graph_common/csr_graph.h"
+
+// ========================================================================
+// ИТЕРАТИВНЫЙ DFS С ЯВНЫМ СТЕКОМ И ХУКАМИ
+// ========================================================================
+// Graph::DFSRecursive в simple_dfs.cxx тратит кадр стека вызовов на каждую
+// вершину пути: на цепочке из миллиона вершин стек (обычно 8 МБ)
+// переполняется. Итеративный Graph::DFS не падает, но и не умеет ничего,
+// кроме печати порядка: в нём нет момента "вершина закончена" (postorder),
+// на котором построены SCC, топологическая сортировка и мосты.
+//
+// DFSEngine хранит явный стек пар (вершина, следующее ребро) и вызывает
+// хуки посетителя ровно в те моменты, что и рекурсивная версия:
+//
+//   preorder(u, parent)       - вход в вершину (parent = -1 у корня)
+//   treeEdge(u, v, e)         - ребро e ведёт в новую вершину v
+//   nonTreeEdge(u, v, e)      - ребро e ведёт в уже посещённую вершину v
+//   postorder(u, parent)      - все рёбра u обработаны, выход из вершины
+//
+// Все массивы выделяются в конструкторе. Отметки посещения - метки
+// "поколения" (visitedStamp[v] == stamp), поэтому новый запуск не
+// очищает O(V) память: достаточно увеличить stamp.
+// ========================================================================
+
+// Посетитель по умолчанию: все хуки пустые, наследники переопределяют нужные
+struct DFSVisitor
+{
+    void preorder(int, int) {}
+    void postorder(int, int) {}
+    void treeEdge(int, int, std::int64_t) {}
+    void nonTreeEdge(int, int, std::int64_t) {}
+};
+
+class DFSEngine
+{
+    const CSRGraph& graph;
+    std::vector<int> stackVertex;           // Вершины на пути от корня
+    std::vector<std::int64_t> stackEdge;    // Следующее непросмотренное ребро каждой из них
+    std::vector<unsigned> visitedStamp;     // visitedStamp[v] == stamp => посещена
+    unsigned stamp;
+
+public:
+    explicit DFSEngine(const CSRGraph& g)
+        : graph(g), stackVertex(g.vertexCount()), stackEdge(g.vertexCount()),
+          visitedStamp(g.vertexCount(), 0), stamp(0)
+    {
+    }
+
+    // Начать новый обход: все вершины снова непосещённые, за O(1)
+    void reset()
+    {
+        if (++stamp == 0)
+        {
+            // Переполнение счётчика (раз в 4 млрд запусков) - честная очистка
+            std::fill(visitedStamp.begin(), visitedStamp.end(), 0);
+            stamp = 1;
+        }
+    }
+
+    bool visited(int v) const { return visitedStamp[v] == stamp; }
+
+    // Обход из одной вершины (без reset: можно продолжать лес обходов)
+    template <typename Visitor>
+    void explore(int root, Visitor& visitor)
+    {
+        if (visited(root))
+            return;
+        visitedStamp[root] = stamp;
+        visitor.preorder(root, -1);
+
+        int top = 0;
+        stackVertex[0] = root;
+        stackEdge[0] = graph.edgeBegin(root);
+
+        while (top >= 0)
+        {
+            int u = stackVertex[top];
+            std::int64_t e = stackEdge[top];
+            if (e < graph.edgeEnd(u))
+            {
+                stackEdge[top] = e + 1;
+                int v = graph.target(e);
+                if (visitedStamp[v] != stamp)
+                {
+                    // "Рекурсивный вызов": кладём v на стек
+                    visitedStamp[v] = stamp;
+                    visitor.treeEdge(u, v, e);
+                    visitor.preorder(v, u);
+                    top++;
+                    stackVertex[top] = v;
+                    stackEdge[top] = graph.edgeBegin(v);
+                }
+                else
+                {
+                    visitor.nonTreeEdge(u, v, e);
+                }
+            }
+            else
+            {
+                // "Возврат из рекурсии"
+                int parent = top > 0 ? stackVertex[top - 1] : -1;
+                visitor.postorder(u, parent);
+                top--;
+            }
+        }
+    }
+
+    // Одиночный обход из source
+    template <typename Visitor>
+    void run(int source, Visitor& visitor)
+    {
+        reset();
+        explore(source, visitor);
+    }
+
+    // Лес обходов: из каждой ещё не посещённой вершины по порядку
+    template <typename Visitor>
+    void runAll(Visitor& visitor)
+    {
+        reset();
+        for (int v = 0; v < graph.vertexCount(); v++)
+        {
+            explore(v, visitor);
+        }
+    }
+};
+
+// ========================================================================
+// СИЛЬНО СВЯЗНЫЕ КОМПОНЕНТЫ (алгоритм Тарьяна)
+// ========================================================================
+// index[u] - номер вершины в порядке входа, low[u] - минимальный index,
+// достижимый из поддерева u по не более чем одному обратному ребру
+// в вершину, ещё лежащую в стеке компонент. Если low[u] == index[u],
+// u - корень компоненты: снимаем со стека всё до u включительно.
+// Компоненты нумеруются в обратном топологическом порядке графа конденсации.
+// ========================================================================
+class TarjanSCC
+{
+    struct Visitor : DFSVisitor
+    {
+        TarjanSCC& s;
+        explicit Visitor(TarjanSCC& owner) : s(owner) {}
+
+        void preorder(int u, int)
+        {
+            s.index[u] = s.low[u] = s.counter++;
+            s.sccStack[s.sccTop++] = u;
+            s.onStack[u] = 1;
+        }
+
+        void nonTreeEdge(int u, int v, std::int64_t)
+        {
+            if (s.onStack[v])
+                s.low[u] = std::min(s.low[u], s.index[v]);
+        }
+
+        void postorder(int u, int parent)
+        {
+            if (s.low[u] == s.index[u])
+            {
+                int v;
+                do
+                {
+                    v = s.sccStack[--s.sccTop];
+                    s.onStack[v] = 0;
+                    s.component[v] = s.componentCount;
+                } while (v != u);
+                s.componentCount++;
+            }
+            if (parent != -1)
+                s.low[parent] = std::min(s.low[parent], s.low[u]);
+        }
+    };
+
+    DFSEngine engine;
+    std::vector<int> index, low, sccStack, component;
+    std::vector<char> onStack;
+    int sccTop = 0;
+    int counter = 0;
+    int componentCount = 0;
+
+public:
+    explicit TarjanSCC(const CSRGraph& g)
+        : engine(g), index(g.vertexCount()), low(g.vertexCount()),
+          sccStack(g.vertexCount()), component(g.vertexCount()), onStack(g.vertexCount(), 0)
+    {
+    }
+
+    // Возвращает количество компонент; componentOf(v) - номер компоненты
+    int run()
+    {
+        sccTop = counter = componentCount = 0;
+        Visitor visitor(*this);
+        engine.runAll(visitor);
+        return componentCount;
+    }
+
+    int componentOf(int v) const { return component[v]; }
+    const std::vector<int>& components() const { return component; }
+};
+
+// ========================================================================
+// ТОПОЛОГИЧЕСКАЯ СОРТИРОВКА
+// ========================================================================
+// Порядок, обратный postorder, - топологический: вершина заканчивается
+// только после всех вершин, достижимых из неё. Ребро в "серую" вершину
+// (вход был, выхода ещё нет - она на текущем пути) означает цикл.
+// ========================================================================
+class TopologicalSort
+{
+    struct Visitor : DFSVisitor
+    {
+        TopologicalSort& t;
+        explicit Visitor(TopologicalSort& owner) : t(owner) {}
+
+        void preorder(int u, int) { t.onPath[u] = 1; }
+
+        void nonTreeEdge(int, int v, std::int64_t)
+        {
+            if (t.onPath[v])
+                t.acyclic = false;
+        }
+
+        void postorder(int u, int)
+        {
+            t.onPath[u] = 0;
+            t.order[--t.position] = u; // Заполняем с конца => обратный postorder
+        }
+    };
+
+    DFSEngine engine;
+    std::vector<int> order;
+    std::vector<char> onPath;
+    int position = 0;
+    bool acyclic = true;
+
+public:
+    explicit TopologicalSort(const CSRGraph& g)
+        : engine(g), order(g.vertexCount()), onPath(g.vertexCount(), 0)
+    {
+    }
+
+    // Возвращает false, если в графе есть цикл (тогда order() не топологический)
+    bool run()
+    {
+        position = static_cast<int>(order.size());
+        acyclic = true;
+        Visitor visitor(*this);
+        engine.runAll(visitor);
+        return acyclic;
+    }
+
+    const std::vector<int>& result() const { return order; }
+};
+
+// ========================================================================
+// МОСТЫ И ТОЧКИ СОЧЛЕНЕНИЯ (неориентированный граф)
+// ========================================================================
+// tin[u] - время входа, low[u] - минимальное tin, достижимое из поддерева u
+// по одному обратному ребру. Для ребра дерева p -> u:
+//   low[u] >  tin[p]  => ребро (p, u) - мост
+//   low[u] >= tin[p]  => p - точка сочленения (если p не корень)
+// Корень - точка сочленения, если у него больше одного потомка в дереве.
+//
+// Граф должен быть построен как неориентированный. Обратное ребро в
+// родителя пропускается только ОДИН раз - так кратные рёбра (две дороги
+// между одними и теми же перекрёстками) правильно не считаются мостом.
+// ========================================================================
+class BridgesAndArticulationPoints
+{
+    struct Visitor : DFSVisitor
+    {
+        BridgesAndArticulationPoints& b;
+        explicit Visitor(BridgesAndArticulationPoints& owner) : b(owner) {}
+
+        void preorder(int u, int parent)
+        {
+            b.tin[u] = b.low[u] = b.timer++;
+            b.parentOf[u] = parent;
+            b.parentSkipped[u] = 0;
+            b.treeChildren[u] = 0;
+        }
+
+        void treeEdge(int u, int, std::int64_t) { b.treeChildren[u]++; }
+
+        void nonTreeEdge(int u, int v, std::int64_t)
+        {
+            if (v == b.parentOf[u] && !b.parentSkipped[u])
+            {
+                b.parentSkipped[u] = 1; // Ребро, по которому пришли
+                return;
+            }
+            b.low[u] = std::min(b.low[u], b.tin[v]);
+        }
+
+        void postorder(int u, int parent)
+        {
+            if (parent == -1)
+            {
+                if (b.treeChildren[u] > 1)
+                    b.articulation[u] = 1;
+                return;
+            }
+            b.low[parent] = std::min(b.low[parent], b.low[u]);
+            if (b.low[u] > b.tin[parent])
+                b.bridgeList.push_back({parent, u});
+            if (b.low[u] >= b.tin[parent] && b.parentOf[parent] != -1)
+                b.articulation[parent] = 1;
+        }
+    };
+
+    DFSEngine engine;
+    std::vector<int> tin, low, parentOf, treeChildren;
+    std::vector<char> parentSkipped, articulation;
+    std::vector<std::pair<int, int>> bridgeList;
+    int timer = 0;
+
+public:
+    explicit BridgesAndArticulationPoints(const CSRGraph& g)
+        : engine(g), tin(g.vertexCount()), low(g.vertexCount()), parentOf(g.vertexCount()),
+          treeChildren(g.vertexCount()), parentSkipped(g.vertexCount()), articulation(g.vertexCount())
+    {
+        bridgeList.reserve(g.vertexCount()); // Мостов не больше, чем рёбер леса (V - 1)
+    }
+
+    void run()
+    {
+        timer = 0;
+        bridgeList.clear();
+        std::fill(articulation.begin(), articulation.end(), 0);
+        Visitor visitor(*this);
+        engine.runAll(visitor);
+    }
+
+    const std::vector<std::pair<int, int>>& bridges() const { return bridgeList; }
+    bool isArticulationPoint(int v) const { return articulation[v] != 0; }
+};
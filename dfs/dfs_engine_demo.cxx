@@ -0,0 +1,178 @@
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "dfs_engine.h"
+
+// ========================================================================
+// ДЕМОНСТРАЦИЯ DFSEngine: SCC, ТОПОЛОГИЧЕСКАЯ СОРТИРОВКА, МОСТЫ
+// ========================================================================
+// 1. Маленькие графы с заранее известным ответом.
+// 2. Цепочка из 2 млн вершин: рекурсивный DFS на ней переполнил бы стек
+//    вызовов, явный стек DFSEngine - нет. Повторные запуски не выделяют
+//    память (все буферы созданы в конструкторах).
+// ========================================================================
+
+void check(const char* name, bool ok)
+{
+    std::cout << (ok ? "  ✓ " : "  ✗ ") << name << std::endl;
+}
+
+template <typename Func>
+double timeMs(Func&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main()
+{
+    std::cout << "=== ТЕСТ 1: Сильно связные компоненты ===" << std::endl;
+    {
+        // Компоненты {0, 1, 2}, {3, 4}, {5}
+        CSRGraphBuilder b(6);
+        b.addEdge(0, 1);
+        b.addEdge(1, 2);
+        b.addEdge(2, 0);
+        b.addEdge(2, 3);
+        b.addEdge(3, 4);
+        b.addEdge(4, 3);
+        b.addEdge(4, 5);
+        CSRGraph g = b.build();
+
+        TarjanSCC scc(g);
+        int count = scc.run();
+        std::cout << "  Компонент: " << count << std::endl;
+        for (int v = 0; v < g.vertexCount(); v++)
+        {
+            std::cout << "  Вершина " << v << " -> компонента " << scc.componentOf(v) << std::endl;
+        }
+        check("три компоненты", count == 3);
+        check("0, 1, 2 вместе", scc.componentOf(0) == scc.componentOf(1) && scc.componentOf(1) == scc.componentOf(2));
+        check("3, 4 вместе", scc.componentOf(3) == scc.componentOf(4) && scc.componentOf(3) != scc.componentOf(0));
+        // Обратный топологический порядок: сток {5} получает номер 0
+        check("сток нумеруется первым", scc.componentOf(5) == 0);
+    }
+
+    std::cout << "\n=== ТЕСТ 2: Топологическая сортировка ===" << std::endl;
+    {
+        // Порядок сборки: 5 -> 2 -> 3 -> 1, 5 -> 0, 4 -> 0, 4 -> 1
+        CSRGraphBuilder b(6);
+        b.addEdge(5, 2);
+        b.addEdge(5, 0);
+        b.addEdge(4, 0);
+        b.addEdge(4, 1);
+        b.addEdge(2, 3);
+        b.addEdge(3, 1);
+        CSRGraph g = b.build();
+
+        TopologicalSort topo(g);
+        bool acyclic = topo.run();
+        std::vector<int> position(g.vertexCount());
+        std::cout << "  Порядок:";
+        for (int i = 0; i < g.vertexCount(); i++)
+        {
+            std::cout << " " << topo.result()[i];
+            position[topo.result()[i]] = i;
+        }
+        std::cout << std::endl;
+
+        bool ordered = true;
+        for (int u = 0; u < g.vertexCount(); u++)
+        {
+            for (int v : g.neighbors(u))
+            {
+                ordered = ordered && position[u] < position[v];
+            }
+        }
+        check("граф ацикличен", acyclic);
+        check("каждое ребро идёт вперёд", ordered);
+
+        CSRGraphBuilder cyclic(3);
+        cyclic.addEdge(0, 1);
+        cyclic.addEdge(1, 2);
+        cyclic.addEdge(2, 0);
+        CSRGraph c = cyclic.build();
+        TopologicalSort topoCycle(c);
+        check("цикл 0 -> 1 -> 2 -> 0 обнаружен", !topoCycle.run());
+    }
+
+    std::cout << "\n=== ТЕСТ 3: Мосты и точки сочленения ===" << std::endl;
+    {
+        //   0 - 1 - 2       треугольник 0-1-2, мост 1-3,
+        //    \  |           треугольник 3-4-5, мост 5-6,
+        //     \ 3 - 4       кратное ребро 6 = 7 (не мост)
+        //       \  /
+        //        5 - 6 = 7
+        CSRGraphBuilder b(8, true);
+        b.addEdge(0, 1);
+        b.addEdge(1, 2);
+        b.addEdge(2, 0);
+        b.addEdge(1, 3);
+        b.addEdge(3, 4);
+        b.addEdge(4, 5);
+        b.addEdge(5, 3);
+        b.addEdge(5, 6);
+        b.addEdge(6, 7);
+        b.addEdge(6, 7);
+        CSRGraph g = b.build();
+
+        BridgesAndArticulationPoints bap(g);
+        bap.run();
+        std::cout << "  Мосты:";
+        for (const auto& bridge : bap.bridges())
+        {
+            std::cout << " (" << bridge.first << ", " << bridge.second << ")";
+        }
+        std::cout << std::endl << "  Точки сочленения:";
+        std::vector<int> points;
+        for (int v = 0; v < g.vertexCount(); v++)
+        {
+            if (bap.isArticulationPoint(v))
+            {
+                std::cout << " " << v;
+                points.push_back(v);
+            }
+        }
+        std::cout << std::endl;
+        check("два моста", bap.bridges().size() == 2);
+        check("точки сочленения 1, 3, 5, 6", points == std::vector<int>({1, 3, 5, 6}));
+    }
+
+    std::cout << "\n=== ТЕСТ 4: Глубокая цепочка (2 000 000 вершин) ===" << std::endl;
+    {
+        const int V = 2000000;
+        CSRGraphBuilder b(V);
+        b.reserve(V);
+        for (int v = 0; v + 1 < V; v++)
+        {
+            b.addEdge(v, v + 1);
+        }
+        b.addEdge(V - 1, V / 2); // Цикл во второй половине цепочки
+        CSRGraph g = b.build();
+
+        TarjanSCC scc(g);
+        TopologicalSort topo(g);
+        int count = 0;
+        bool acyclic = true;
+        const int runs = 5;
+        double sccMs = timeMs([&] {
+            for (int r = 0; r < runs; r++)
+                count = scc.run();
+        }) / runs;
+        double topoMs = timeMs([&] {
+            for (int r = 0; r < runs; r++)
+                acyclic = topo.run();
+        }) / runs;
+
+        std::cout << "  Глубина пути DFS: " << V << " вершин" << std::endl;
+        std::cout << "  Tarjan SCC:     " << sccMs << " мс на запуск" << std::endl;
+        std::cout << "  Топосортировка: " << topoMs << " мс на запуск" << std::endl;
+        check("компонент V/2 + 1", count == V / 2 + 1);
+        check("цикл обнаружен", !acyclic);
+    }
+
+    return 0;
+}
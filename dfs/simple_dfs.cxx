@@ -2,6 +2,8 @@
 #include <vector>
 #include <stack>
 
+#include "../common/trace.h"
+
 // Вспомогательная функция для вывода содержимого стека
 void printStack(std::stack<int> s, const std::string& label)
 {
@@ -22,12 +24,13 @@ void printStack(std::stack<int> s, const std::string& label)
 }
 
 // Класс для представления графа с использованием списка смежности
+template <typename Trace = NoTrace>
 class Graph
 {
     int numVertices;                    // Количество вершин
     std::vector<std::vector<int>> adj;  // Список смежности
     std::vector<bool> visited;          // Массив для отслеживания посещенных вершин
-    bool verbose;                        // Режим детального вывода
+    Trace verbose;                       // Режим детального вывода
 
 public:
     // Конструктор: создаем граф с заданным количеством вершин
@@ -182,7 +185,7 @@ int main()
     //  1     2
     //  | \   |
     //  3   4 5
-    Graph g1(6, true);
+    Graph<VerboseTrace> g1(6, true);
     g1.addEdge(0, 1);
     g1.addEdge(0, 2);
     g1.addEdge(1, 3);
@@ -195,7 +198,7 @@ int main()
     std::cout << "========================================" << std::endl;
     // Тест 2: Линейное дерево (цепочка)
     // 0 -- 1 -- 2 -- 3 -- 4
-    Graph g2(5, true);
+    Graph<VerboseTrace> g2(5, true);
     g2.addEdge(0, 1);
     g2.addEdge(1, 2);
     g2.addEdge(2, 3);
@@ -211,7 +214,7 @@ int main()
     //  1 --- 2
     //  |     |
     //  3 --- 4
-    Graph g3(5, true);
+    Graph<VerboseTrace> g3(5, true);
     g3.addEdge(0, 1);
     g3.addEdge(0, 2);
     g3.addEdge(1, 2);  // Цикл
@@ -229,7 +232,7 @@ int main()
     //      1     2
     //     / \   / \
     //    3   4 5   6
-    Graph g4(7, true);
+    Graph<VerboseTrace> g4(7, true);
     g4.addEdge(0, 1);
     g4.addEdge(0, 2);
     g4.addEdge(1, 3);
@@ -241,7 +244,7 @@ int main()
     std::cout << "\n\n========================================" << std::endl;
     std::cout << "  ТЕСТ 5: Рекурсивный DFS (для сравнения)" << std::endl;
     std::cout << "========================================" << std::endl;
-    Graph g5(6, false);
+    Graph<> g5(6, false);
     g5.addEdge(0, 1);
     g5.addEdge(0, 2);
     g5.addEdge(1, 3);
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../graph_common/graph_generators.h"
+#include "contraction_hierarchy.h"
+#include "point_to_point.h"
+
+// ========================================================================
+// CONTRACTION HIERARCHIES: ПРЕДОБРАБОТКА И ЗАДЕРЖКА ЗАПРОСОВ
+// ========================================================================
+// Дорожная решётка с шоссе на каждой 16-й линии (generateRoadGrid).
+// На решётке без шоссе иерархии нет: ядро из последних вершин становится
+// почти полным графом, и предобработка в разы дольше. Измеряем:
+//   - время предобработки и число ярлыков;
+//   - запись иерархии в файл и загрузку из него;
+//   - задержку запросов s -> t (p50 / p90 / p99 / максимум) у CH и у
+//     двунаправленной Дейкстры; все расстояния сверяются, а развёрнутый
+//     путь CH проверяется по исходному графу (вне замера).
+//
+// Запуск: ./ch_benchmark [side] [queries] (по умолчанию 200 и 2000)
+// ========================================================================
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct LatencyStats
+{
+    double p50, p90, p99, max, mean; // Микросекунды
+};
+
+LatencyStats summarize(std::vector<double> micros)
+{
+    std::sort(micros.begin(), micros.end());
+    auto at = [&](double q) { return micros[static_cast<std::size_t>(q * (micros.size() - 1))]; };
+    double sum = 0;
+    for (double m : micros)
+        sum += m;
+    return {at(0.5), at(0.9), at(0.99), micros.back(), sum / micros.size()};
+}
+
+void printStats(const char* name, const LatencyStats& s, double settled)
+{
+    std::cout << name << std::fixed << std::setprecision(1)
+              << std::setw(10) << s.p50 << std::setw(10) << s.p90 << std::setw(10) << s.p99
+              << std::setw(10) << s.max << std::setw(12) << settled << std::endl;
+}
+
+// Путь s -> t в исходном графе и его длина равна distance: соседние
+// вершины соединены ребром, сумма весов (самых лёгких из параллельных
+// рёбер) совпадает с расстоянием
+bool pathMatches(const CSRGraph& g, const std::vector<int>& path, int s, int t, int distance)
+{
+    if (path.empty() || path.front() != s || path.back() != t)
+        return false;
+    long long length = 0;
+    for (std::size_t i = 0; i + 1 < path.size(); i++)
+    {
+        int best = INT_MAX;
+        for (std::int64_t e = g.edgeBegin(path[i]); e < g.edgeEnd(path[i]); e++)
+            if (g.target(e) == path[i + 1])
+                best = std::min(best, g.weight(e));
+        if (best == INT_MAX)
+            return false;
+        length += best;
+    }
+    return length == distance;
+}
+
+int main(int argc, char* argv[])
+{
+    int side = (argc > 1) ? std::atoi(argv[1]) : 200;
+    int queries = (argc > 2) ? std::atoi(argv[2]) : 2000;
+    const std::string file = "road_grid.ch";
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  CONTRACTION HIERARCHIES" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RoadGrid grid = generateRoadGrid(side, 1, 16);
+    const CSRGraph& g = grid.graph;
+    std::cout << "V = " << g.vertexCount() << ", E = " << g.edgeCount() / 2 << "\n" << std::endl;
+
+    auto start = Clock::now();
+    ContractionHierarchy built = buildContractionHierarchy(g);
+    double buildSeconds = secondsSince(start);
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Предобработка:  " << buildSeconds << " с, ярлыков " << built.shortcutCount()
+              << ", рёбер в иерархии " << built.edgeCount() << std::endl;
+
+    start = Clock::now();
+    built.save(file);
+    double saveSeconds = secondsSince(start);
+    start = Clock::now();
+    ContractionHierarchy ch = ContractionHierarchy::load(file);
+    double loadSeconds = secondsSince(start);
+    std::cout << "Файл " << file << ": запись " << saveSeconds * 1000 << " мс, загрузка "
+              << loadSeconds * 1000 << " мс" << std::endl;
+    std::remove(file.c_str());
+
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> vertex(0, g.vertexCount() - 1);
+    std::vector<std::pair<int, int>> pairs(queries);
+    for (auto& p : pairs)
+        p = {vertex(rng), vertex(rng)};
+
+    PointToPointQuery dijkstra(g, g);
+    CHQuery chQuery(ch);
+    std::vector<double> dijkstraMicros(queries), chMicros(queries);
+    std::vector<int> expected(queries);
+    double dijkstraSettled = 0, chSettled = 0;
+    bool ok = true;
+    bool pathsOk = true;
+
+    for (int q = 0; q < queries; q++)
+    {
+        auto begin = Clock::now();
+        expected[q] = dijkstra.bidirectional(pairs[q].first, pairs[q].second);
+        dijkstraMicros[q] = secondsSince(begin) * 1e6;
+        dijkstraSettled += dijkstra.settledCount();
+    }
+    for (int q = 0; q < queries; q++)
+    {
+        auto begin = Clock::now();
+        int d = chQuery.distance(pairs[q].first, pairs[q].second);
+        chMicros[q] = secondsSince(begin) * 1e6;
+        chSettled += chQuery.settledCount();
+        ok = ok && d == expected[q];
+        pathsOk = pathsOk && pathMatches(g, chQuery.path(), pairs[q].first, pairs[q].second, d);
+    }
+
+    std::cout << "\nЗадержка запроса, мкс (" << queries << " запросов):" << std::endl;
+    std::cout << "Алгоритм               p50       p90       p99  максимум     вершин" << std::endl;
+    printStats("Двунаправленная  ", summarize(dijkstraMicros), dijkstraSettled / queries);
+    printStats("CH               ", summarize(chMicros), chSettled / queries);
+    std::cout << "\nРасстояния CH совпадают с Дейкстрой: " << (ok ? "✓" : "✗ ОШИБКА") << std::endl;
+    std::cout << "Длины развёрнутых путей CH равны расстояниям: " << (pathsOk ? "✓" : "✗ ОШИБКА") << std::endl;
+
+    double speedup = summarize(dijkstraMicros).mean / summarize(chMicros).mean;
+    std::cout << "Ускорение среднего запроса: " << std::setprecision(0) << speedup << "x" << std::endl;
+    std::cout << "Предобработка окупается после ~"
+              << buildSeconds * 1e6 / (summarize(dijkstraMicros).mean - summarize(chMicros).mean)
+              << " запросов" << std::endl;
+    return 0;
+}
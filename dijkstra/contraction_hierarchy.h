@@ -0,0 +1,699 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../graph_common/csr_graph.h"
+#include "../graph_common/indexed_heap.h"
+
+// ========================================================================
+// CONTRACTION HIERARCHIES (Geisberger, Sanders, Schultes, Delling)
+// ========================================================================
+// Даже двунаправленная Дейкстра (point_to_point.h) на дорожном графе
+// извлекает сотни тысяч вершин на запрос. CH переносит почти всю работу
+// в однократную предобработку:
+//
+// ПРЕДОБРАБОТКА (ContractionHierarchyBuilder)
+//   Вершины "стягиваются" по одной в порядке важности. Стягивание v:
+//   для каждой пары соседей u -> v -> w проверяем, есть ли путь u -> w
+//   не длиннее w(u, v) + w(v, w) в оставшемся графе без v
+//   ("свидетель", локальная Дейкстра). Если нет - добавляем ЯРЛЫК
+//   u -> w с этим весом (через середину v). Затем v удаляется.
+//   Порядок: сначала вершины, стягивание которых добавляет мало ярлыков
+//   (приоритет = 2 * (ярлыки - удаляемые рёбра) + уже стянутые соседи).
+//   Номер вершины в порядке стягивания - её ранг.
+//
+// ЗАПРОС (CHQuery)
+//   Любой кратчайший путь s -> t в графе с ярлыками можно выбрать так,
+//   что ранги сначала растут, затем убывают. Поэтому прямой поиск от s
+//   идёт только по рёбрам ВВЕРХ (к вершинам большего ранга), обратный от
+//   t - тоже только вверх по входящим рёбрам. Оба поиска маленькие
+//   (сотни вершин на графе с миллионом), ответ - минимум dist_s + dist_t
+//   по вершинам, достигнутым обоими.
+//
+// Результат предобработки сохраняется в файл (save / load), чтобы
+// сервис запросов не повторял её при каждом запуске. load проверяет
+// файл целиком за O(V + E) (смещения, концы рёбер, середины ярлыков,
+// ранги) и на повреждённом бросает std::runtime_error.
+// ========================================================================
+
+// Иерархия: два графа "вверх" в виде CSR и середины ярлыков
+class ContractionHierarchy
+{
+    std::vector<int> rank; // Порядок стягивания вершины
+
+    // up:   u -> v, rank[v] > rank[u] (прямой поиск)
+    // down: для вершины u - рёбра v -> u с rank[v] > rank[u], записанные
+    //       как u -> v (обратный поиск идёт по ним от t вверх)
+    CSRGraph up, down;
+    std::vector<int> upMiddle, downMiddle; // Середина ярлыка или -1 для исходного ребра
+
+    friend class ContractionHierarchyBuilder;
+
+    static constexpr std::uint32_t FILE_MAGIC = 0x31484343; // "CCH1"
+
+    template <typename T>
+    static void writeArray(std::ofstream& out, const T* data, std::size_t count)
+    {
+        out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+    }
+
+    template <typename T>
+    static void readArray(std::ifstream& in, T* data, std::size_t count)
+    {
+        in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+    }
+
+    static void writeGraph(std::ofstream& out, const CSRGraph& g, const std::vector<int>& middle)
+    {
+        std::int64_t E = g.edgeCount();
+        writeArray(out, &E, 1);
+        writeArray(out, g.offsetData(), static_cast<std::size_t>(g.vertexCount()) + 1);
+        writeArray(out, g.targetData(), static_cast<std::size_t>(E));
+        writeArray(out, g.weightData(), static_cast<std::size_t>(E));
+        writeArray(out, middle.data(), static_cast<std::size_t>(E));
+    }
+
+    // Сколько байт осталось до конца файла (позиция чтения не меняется)
+    static std::int64_t remainingBytes(std::ifstream& in)
+    {
+        std::streampos here = in.tellg();
+        in.seekg(0, std::ios::end);
+        std::streampos end = in.tellg();
+        in.seekg(here);
+        return static_cast<std::int64_t>(end - here);
+    }
+
+    static void checkFile(bool ok, const char* what)
+    {
+        if (!ok)
+            throw std::runtime_error(std::string("ContractionHierarchy: повреждённый файл (") + what + ")");
+    }
+
+    // Граф и середины проверяются до использования: иначе повреждённый
+    // файл даст чтение за границами массивов в CHQuery
+    static CSRGraph readGraph(std::ifstream& in, int V, std::vector<int>& middle)
+    {
+        std::int64_t E = 0;
+        readArray(in, &E, 1);
+        checkFile(static_cast<bool>(in) && E >= 0, "число рёбер");
+        // Размер массивов из файла не больше самого файла
+        const std::int64_t arrayBytes = remainingBytes(in) - (static_cast<std::int64_t>(V) + 1) * 8;
+        checkFile(arrayBytes >= 0 && E <= arrayBytes / static_cast<std::int64_t>(3 * sizeof(int)), "файл обрезан");
+
+        std::vector<std::int64_t> offsets(static_cast<std::size_t>(V) + 1);
+        std::vector<int> targets(static_cast<std::size_t>(E)), weights(static_cast<std::size_t>(E));
+        middle.resize(static_cast<std::size_t>(E));
+        readArray(in, offsets.data(), offsets.size());
+        readArray(in, targets.data(), targets.size());
+        readArray(in, weights.data(), weights.size());
+        readArray(in, middle.data(), middle.size());
+        if (!in)
+            throw std::runtime_error("ContractionHierarchy: файл обрезан");
+
+        checkFile(offsets[0] == 0 && offsets[V] == E, "смещения");
+        for (int u = 0; u < V; u++)
+            checkFile(offsets[u] <= offsets[u + 1], "смещения");
+        for (std::int64_t e = 0; e < E; e++)
+        {
+            checkFile(targets[e] >= 0 && targets[e] < V && weights[e] >= 0, "ребро");
+            checkFile(middle[e] >= -1 && middle[e] < V, "середина ярлыка");
+        }
+        return CSRGraph(V, std::move(offsets), std::move(targets), std::move(weights));
+    }
+
+    // Рёбра ведут вверх по рангу, середина ярлыка ниже обоих концов - на
+    // этом держится развёртка путей (иначе она может зациклиться)
+    static void checkRanks(const std::vector<int>& rank, const CSRGraph& g, const std::vector<int>& middle)
+    {
+        for (int u = 0; u < g.vertexCount(); u++)
+        {
+            for (std::int64_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++)
+            {
+                int v = g.target(e);
+                int m = middle[e];
+                checkFile(rank[v] > rank[u], "ранги рёбер");
+                checkFile(m == -1 || (rank[m] < rank[u] && rank[m] < rank[v]), "ранг середины ярлыка");
+            }
+        }
+    }
+
+public:
+    int vertexCount() const { return static_cast<int>(rank.size()); }
+    int rankOf(int v) const { return rank[v]; }
+
+    const CSRGraph& upGraph() const { return up; }
+    const CSRGraph& downGraph() const { return down; }
+    int upMiddleOf(std::int64_t e) const { return upMiddle[e]; }
+    int downMiddleOf(std::int64_t e) const { return downMiddle[e]; }
+
+    // Всего рёбер в иерархии (исходные + ярлыки)
+    std::int64_t edgeCount() const { return up.edgeCount() + down.edgeCount(); }
+
+    std::int64_t shortcutCount() const
+    {
+        std::int64_t count = 0;
+        for (int m : upMiddle)
+            count += (m != -1);
+        for (int m : downMiddle)
+            count += (m != -1);
+        return count;
+    }
+
+    // Двоичный файл: магическое число, V, ранги, затем оба графа
+    // (offsets, targets, weights, middle). Порядок байтов - машинный.
+    void save(const std::string& path) const
+    {
+        std::ofstream out(path, std::ios::binary);
+        if (!out)
+            throw std::runtime_error("ContractionHierarchy: не удалось открыть " + path);
+        std::uint32_t magic = FILE_MAGIC;
+        int V = vertexCount();
+        writeArray(out, &magic, 1);
+        writeArray(out, &V, 1);
+        writeArray(out, rank.data(), rank.size());
+        writeGraph(out, up, upMiddle);
+        writeGraph(out, down, downMiddle);
+        if (!out)
+            throw std::runtime_error("ContractionHierarchy: ошибка записи " + path);
+    }
+
+    static ContractionHierarchy load(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            throw std::runtime_error("ContractionHierarchy: не удалось открыть " + path);
+        std::uint32_t magic = 0;
+        int V = -1;
+        readArray(in, &magic, 1);
+        readArray(in, &V, 1);
+        if (!in || magic != FILE_MAGIC || V < 0)
+            throw std::runtime_error("ContractionHierarchy: " + path + " - не файл иерархии");
+
+        checkFile(V <= remainingBytes(in) / static_cast<std::int64_t>(sizeof(int)), "файл обрезан");
+
+        ContractionHierarchy ch;
+        ch.rank.resize(V);
+        readArray(in, ch.rank.data(), ch.rank.size());
+        checkFile(static_cast<bool>(in), "файл обрезан");
+        // Ранги - перестановка 0..V-1
+        std::vector<char> seen(static_cast<std::size_t>(V), 0);
+        for (int r : ch.rank)
+        {
+            checkFile(r >= 0 && r < V && !seen[r], "ранги");
+            seen[r] = 1;
+        }
+        ch.up = readGraph(in, V, ch.upMiddle);
+        ch.down = readGraph(in, V, ch.downMiddle);
+        checkRanks(ch.rank, ch.up, ch.upMiddle);
+        checkRanks(ch.rank, ch.down, ch.downMiddle);
+        return ch;
+    }
+};
+
+// ========================================================================
+// ПРЕДОБРАБОТКА
+// ========================================================================
+class ContractionHierarchyBuilder
+{
+    struct Arc
+    {
+        int to;
+        int weight;
+        int middle; // -1 - исходное ребро
+    };
+
+    const int numVertices;
+
+    // Оставшийся граф: только рёбра между ещё не стянутыми вершинами.
+    // При стягивании v её рёбра переезжают в upArcs[v] / downArcs[v]
+    // (все соседи стянутся позже, т. е. выше по рангу) и больше не меняются.
+    std::vector<std::vector<Arc>> out, in;
+    std::vector<std::vector<Arc>> upArcs, downArcs;
+    std::vector<int> contractedNeighbors;
+    std::vector<int> neighbors; // Соседи стягиваемой вершины (без повторов)
+    std::vector<char> isNeighbor;
+    std::vector<char> isTarget; // Концы рёбер стягиваемой вершины (цели поиска свидетелей)
+
+    // Локальная Дейкстра поиска свидетелей (метки времени, как в point_to_point.h)
+    std::vector<int> witnessDist;
+    std::vector<unsigned> witnessStamp;
+    unsigned witnessEpoch = 0;
+    IndexedDaryHeap<4> witnessHeap;
+
+    std::vector<std::pair<int, Arc>> pending; // Ярлыки стягиваемой вершины: (откуда, ребро)
+
+    static void eraseArc(std::vector<Arc>& arcs, int to)
+    {
+        for (std::size_t i = 0; i < arcs.size(); i++)
+        {
+            if (arcs[i].to == to)
+            {
+                arcs[i] = arcs.back();
+                arcs.pop_back();
+                return;
+            }
+        }
+    }
+
+    // Добавить ребро u -> v или улучшить вес существующего
+    void addArc(int u, int v, int weight, int middle)
+    {
+        for (Arc& a : out[u])
+        {
+            if (a.to == v)
+            {
+                if (weight < a.weight)
+                {
+                    a.weight = weight;
+                    a.middle = middle;
+                    for (Arc& b : in[v])
+                    {
+                        if (b.to == u)
+                        {
+                            b.weight = weight;
+                            b.middle = middle;
+                            break;
+                        }
+                    }
+                }
+                return;
+            }
+        }
+        out[u].push_back({v, weight, middle});
+        in[v].push_back({u, weight, middle});
+    }
+
+    // Дейкстра от source без вершины skip, пока ключ не превысит limit,
+    // не извлечено maxSettled вершин или не извлечены все targets
+    // (помечены в isTarget). После неё witnessDistance(v) - верхняя
+    // оценка кратчайшего пути source -> v без skip.
+    void witnessSearch(int source, int skip, int limit, int maxSettled, int targets)
+    {
+        if (++witnessEpoch == 0)
+        {
+            std::fill(witnessStamp.begin(), witnessStamp.end(), 0);
+            witnessEpoch = 1;
+        }
+        witnessHeap.clear();
+        witnessStamp[source] = witnessEpoch;
+        witnessDist[source] = 0;
+        witnessHeap.push(source, 0);
+
+        int settled = 0;
+        while (!witnessHeap.empty() && settled < maxSettled)
+        {
+            if (witnessHeap.topKey() > limit)
+                break;
+            int u = witnessHeap.pop();
+            settled++;
+            if (u != source && isTarget[u] && --targets == 0)
+                break;
+            for (const Arc& a : out[u])
+            {
+                if (a.to == skip)
+                    continue;
+                int newDist = witnessDist[u] + a.weight;
+                if (witnessStamp[a.to] != witnessEpoch)
+                {
+                    witnessStamp[a.to] = witnessEpoch;
+                    witnessDist[a.to] = newDist;
+                    witnessHeap.push(a.to, newDist);
+                }
+                else if (newDist < witnessDist[a.to])
+                {
+                    witnessDist[a.to] = newDist;
+                    witnessHeap.decreaseKey(a.to, newDist);
+                }
+            }
+        }
+    }
+
+    int witnessDistance(int v) const
+    {
+        return witnessStamp[v] == witnessEpoch ? witnessDist[v] : INT_MAX;
+    }
+
+    // Ярлыки, нужные при стягивании v, - в pending
+    void findShortcuts(int v, int maxSettled)
+    {
+        pending.clear();
+        int maxOut = 0;
+        for (const Arc& a : out[v])
+        {
+            maxOut = std::max(maxOut, a.weight);
+            isTarget[a.to] = 1;
+        }
+
+        for (const Arc& incoming : in[v])
+        {
+            int u = incoming.to;
+            int targets = static_cast<int>(out[v].size()) - isTarget[u];
+            if (targets > 0)
+                witnessSearch(u, v, incoming.weight + maxOut, maxSettled, targets);
+            for (const Arc& outgoing : out[v])
+            {
+                int w = outgoing.to;
+                if (w == u)
+                    continue;
+                int viaV = incoming.weight + outgoing.weight;
+                if (witnessDistance(w) > viaV)
+                    pending.push_back({u, Arc{w, viaV, v}});
+            }
+        }
+        for (const Arc& a : out[v])
+            isTarget[a.to] = 0;
+    }
+
+    // Приоритет: 2 * (ярлыки - удаляемые рёбра) + уже стянутые соседи.
+    // Второе слагаемое распределяет стягивание равномерно по графу; вес 2
+    // у первого дал в ch_benchmark меньше ярлыков и быстрее предобработку.
+    int priority(int v)
+    {
+        findShortcuts(v, PRIORITY_MAX_SETTLED);
+        int removed = static_cast<int>(out[v].size() + in[v].size());
+        return 2 * (static_cast<int>(pending.size()) - removed) + contractedNeighbors[v];
+    }
+
+    void contract(int v)
+    {
+        findShortcuts(v, WITNESS_MAX_SETTLED);
+        for (const auto& shortcut : pending)
+            addArc(shortcut.first, shortcut.second.to, shortcut.second.weight, shortcut.second.middle);
+
+        neighbors.clear();
+        for (const Arc& a : out[v])
+        {
+            eraseArc(in[a.to], v);
+            if (!isNeighbor[a.to])
+            {
+                isNeighbor[a.to] = 1;
+                neighbors.push_back(a.to);
+            }
+        }
+        for (const Arc& a : in[v])
+        {
+            eraseArc(out[a.to], v);
+            if (!isNeighbor[a.to])
+            {
+                isNeighbor[a.to] = 1;
+                neighbors.push_back(a.to);
+            }
+        }
+        for (int u : neighbors)
+            isNeighbor[u] = 0;
+
+        upArcs[v] = std::move(out[v]);
+        downArcs[v] = std::move(in[v]);
+        out[v].clear();
+        in[v].clear();
+    }
+
+    // Упаковать рёбра вершин в CSR
+    static CSRGraph packArcs(const std::vector<std::vector<Arc>>& arcs, std::vector<int>& middle)
+    {
+        const int V = static_cast<int>(arcs.size());
+        std::vector<std::int64_t> offsets(V + 1, 0);
+        for (int u = 0; u < V; u++)
+            offsets[u + 1] = offsets[u] + static_cast<std::int64_t>(arcs[u].size());
+
+        std::vector<int> targets(offsets[V]), weights(offsets[V]);
+        middle.resize(offsets[V]);
+        for (int u = 0; u < V; u++)
+        {
+            std::int64_t pos = offsets[u];
+            for (const Arc& a : arcs[u])
+            {
+                targets[pos] = a.to;
+                weights[pos] = a.weight;
+                middle[pos] = a.middle;
+                pos++;
+            }
+        }
+        return CSRGraph(V, std::move(offsets), std::move(targets), std::move(weights));
+    }
+
+public:
+    // Сколько вершин может извлечь один поиск свидетеля при стягивании.
+    // Если свидетель не найден за это число шагов, добавляется ярлык -
+    // возможно, лишний, но корректность запросов от этого не страдает.
+    static constexpr int WITNESS_MAX_SETTLED = 500;
+    // То же при оценке приоритета: её повторяют для каждого соседа после
+    // каждого стягивания, поэтому поиск короче (оценка чуть грубее)
+    static constexpr int PRIORITY_MAX_SETTLED = 50;
+
+    explicit ContractionHierarchyBuilder(const CSRGraph& g)
+        : numVertices(g.vertexCount()),
+          out(g.vertexCount()), in(g.vertexCount()),
+          upArcs(g.vertexCount()), downArcs(g.vertexCount()),
+          contractedNeighbors(g.vertexCount(), 0), isNeighbor(g.vertexCount(), 0), isTarget(g.vertexCount(), 0),
+          witnessDist(g.vertexCount()), witnessStamp(g.vertexCount(), 0), witnessHeap(g.vertexCount())
+    {
+        for (int u = 0; u < numVertices; u++)
+        {
+            for (std::int64_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++)
+            {
+                if (g.target(e) != u) // Петли на кратчайшие пути не влияют
+                    addArc(u, g.target(e), g.weight(e), -1);
+            }
+        }
+    }
+
+    ContractionHierarchy build()
+    {
+        ContractionHierarchy ch;
+        ch.rank.assign(numVertices, -1);
+
+        // Очередь вершин по приоритету с ленивым обновлением: после
+        // извлечения приоритет пересчитывается, и если он стал хуже
+        // следующего в очереди - вершина возвращается обратно
+        IndexedDaryHeap<4> queue(numVertices);
+        for (int v = 0; v < numVertices; v++)
+            queue.push(v, priority(v));
+
+        int nextRank = 0;
+        while (!queue.empty())
+        {
+            int v = queue.pop();
+            int current = priority(v);
+            if (!queue.empty() && current > queue.topKey())
+            {
+                queue.push(v, current);
+                continue;
+            }
+
+            contract(v);
+            ch.rank[v] = nextRank++;
+
+            // Приоритет соседей мог вырасти (проверится при извлечении)
+            // или уменьшиться (обновляем сразу)
+            for (int u : neighbors)
+            {
+                contractedNeighbors[u]++;
+                int p = priority(u);
+                if (p < queue.keyOf(u))
+                    queue.decreaseKey(u, p);
+            }
+        }
+
+        ch.up = packArcs(upArcs, ch.upMiddle);
+        ch.down = packArcs(downArcs, ch.downMiddle);
+        return ch;
+    }
+};
+
+inline ContractionHierarchy buildContractionHierarchy(const CSRGraph& g)
+{
+    ContractionHierarchyBuilder builder(g);
+    return builder.build();
+}
+
+// ========================================================================
+// ЗАПРОСЫ
+// ========================================================================
+// Двунаправленный поиск вверх с "остановкой по требованию" (stall on
+// demand): если вершину u можно достичь короче через более важного соседа
+// (по ребру сверху вниз), её dist не кратчайший, и рёбра из u не
+// просматриваются. Объект переиспользуется между запросами, как
+// PointToPointQuery (метки времени вместо очистки массивов).
+class CHQuery
+{
+    struct Search
+    {
+        std::vector<int> dist;
+        std::vector<int> parent;              // Предыдущая вершина (-1 у s / t)
+        std::vector<std::int64_t> parentEdge; // Ребро иерархии, по которому пришли
+        std::vector<unsigned> stamp;
+        IndexedDaryHeap<4> heap;
+
+        explicit Search(int V) : dist(V), parent(V), parentEdge(V), stamp(V, 0), heap(V) {}
+    };
+
+    const ContractionHierarchy& ch;
+    Search forward, backward;
+    unsigned epoch = 0;
+    int source = -1, target = -1;
+    int meeting = -1;
+    long long best = LLONG_MAX;
+    std::int64_t settled = 0;
+
+    bool reached(const Search& s, int v) const { return s.stamp[v] == epoch; }
+
+    // Извлечь одну вершину: searchGraph - рёбра вверх этого направления,
+    // stallGraph - рёбра вверх другого направления (входящие сверху)
+    void step(Search& self, const Search& other, const CSRGraph& searchGraph, const CSRGraph& stallGraph)
+    {
+        int u = self.heap.pop();
+        settled++;
+        int distU = self.dist[u];
+        if (reached(other, u) && static_cast<long long>(distU) + other.dist[u] < best)
+        {
+            best = static_cast<long long>(distU) + other.dist[u];
+            meeting = u;
+        }
+
+        for (std::int64_t e = stallGraph.edgeBegin(u); e < stallGraph.edgeEnd(u); e++)
+        {
+            int v = stallGraph.target(e);
+            if (reached(self, v) && static_cast<long long>(self.dist[v]) + stallGraph.weight(e) < distU)
+                return; // Остановка: u достижима короче через v
+        }
+
+        for (std::int64_t e = searchGraph.edgeBegin(u); e < searchGraph.edgeEnd(u); e++)
+        {
+            int v = searchGraph.target(e);
+            int newDist = distU + searchGraph.weight(e);
+            if (!reached(self, v))
+            {
+                self.stamp[v] = epoch;
+                self.dist[v] = newDist;
+                self.parent[v] = u;
+                self.parentEdge[v] = e;
+                self.heap.push(v, newDist);
+            }
+            else if (newDist < self.dist[v])
+            {
+                self.dist[v] = newDist;
+                self.parent[v] = u;
+                self.parentEdge[v] = e;
+                self.heap.pushOrDecrease(v, newDist);
+            }
+        }
+    }
+
+    // Развернуть ребро иерархии в исходные рёбра (вершины без начальной)
+    void unpack(int from, int to, int middle, std::vector<int>& path) const
+    {
+        // Стек отрезков (from, to, middle); отрезки справа кладутся первыми
+        std::vector<std::pair<std::pair<int, int>, int>> stack;
+        stack.push_back({{from, to}, middle});
+        while (!stack.empty())
+        {
+            int a = stack.back().first.first;
+            int b = stack.back().first.second;
+            int m = stack.back().second;
+            stack.pop_back();
+            if (m == -1)
+            {
+                path.push_back(b);
+                continue;
+            }
+            // a -> m: rank[m] < rank[a], лежит в down[m]; m -> b - в up[m]
+            stack.push_back({{m, b}, middleOf(ch.upGraph(), m, b, true)});
+            stack.push_back({{a, m}, middleOf(ch.downGraph(), m, a, false)});
+        }
+    }
+
+    int middleOf(const CSRGraph& g, int u, int v, bool isUp) const
+    {
+        for (std::int64_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++)
+        {
+            if (g.target(e) == v)
+                return isUp ? ch.upMiddleOf(e) : ch.downMiddleOf(e);
+        }
+        throw std::logic_error("CHQuery: ребро ярлыка не найдено");
+    }
+
+public:
+    explicit CHQuery(const ContractionHierarchy& hierarchy)
+        : ch(hierarchy), forward(hierarchy.vertexCount()), backward(hierarchy.vertexCount())
+    {
+    }
+
+    // Расстояние s -> t (INT_MAX, если t недостижима)
+    int distance(int s, int t)
+    {
+        if (++epoch == 0)
+        {
+            std::fill(forward.stamp.begin(), forward.stamp.end(), 0);
+            std::fill(backward.stamp.begin(), backward.stamp.end(), 0);
+            epoch = 1;
+        }
+        forward.heap.clear();
+        backward.heap.clear();
+        source = s;
+        target = t;
+        meeting = -1;
+        best = LLONG_MAX;
+        settled = 0;
+
+        forward.stamp[s] = epoch;
+        forward.dist[s] = 0;
+        forward.parent[s] = -1;
+        forward.heap.push(s, 0);
+        backward.stamp[t] = epoch;
+        backward.dist[t] = 0;
+        backward.parent[t] = -1;
+        backward.heap.push(t, 0);
+
+        // Каждое направление идёт, пока его минимальный ключ меньше best:
+        // вершина с большим dist уже не улучшит ответ
+        while (true)
+        {
+            bool forwardActive = !forward.heap.empty() && forward.heap.topKey() < best;
+            bool backwardActive = !backward.heap.empty() && backward.heap.topKey() < best;
+            if (!forwardActive && !backwardActive)
+                break;
+            bool goForward = forwardActive &&
+                             (!backwardActive || forward.heap.topKey() <= backward.heap.topKey());
+            if (goForward)
+                step(forward, backward, ch.upGraph(), ch.downGraph());
+            else
+                step(backward, forward, ch.downGraph(), ch.upGraph());
+        }
+        return best == LLONG_MAX ? INT_MAX : static_cast<int>(best);
+    }
+
+    // Путь последнего запроса в исходном графе (ярлыки развёрнуты)
+    std::vector<int> path() const
+    {
+        std::vector<int> result;
+        if (meeting == -1)
+            return result;
+
+        // s -> meeting: рёбра up собираются от meeting вниз и разворачиваются
+        std::vector<int> upChain;
+        for (int v = meeting; forward.parent[v] != -1; v = forward.parent[v])
+            upChain.push_back(v);
+        result.push_back(source);
+        for (std::size_t i = upChain.size(); i-- > 0;)
+        {
+            int v = upChain[i];
+            unpack(forward.parent[v], v, ch.upMiddleOf(forward.parentEdge[v]), result);
+        }
+
+        // meeting -> t: обратный поиск пришёл в v из parent[v] (ниже по рангу)
+        for (int v = meeting; backward.parent[v] != -1; v = backward.parent[v])
+            unpack(v, backward.parent[v], ch.downMiddleOf(backward.parentEdge[v]), result);
+        return result;
+    }
+
+    // Сколько вершин извлечено последним запросом
+    std::int64_t settledCount() const { return settled; }
+};
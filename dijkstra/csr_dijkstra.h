@@ -0,0 +1,174 @@
+#pragma once
+
+#include <climits>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "../graph_common/csr_graph.h"
+#include "../graph_common/indexed_heap.h"
+#include "dijkstra_queues.h"
+
+// Алгоритм Дейкстры на CSR-графе (тот же алгоритм, что и Graph::dijkstra
+// в simple_dijkstra.cxx, но без вывода и без состояния внутри графа:
+// функцию можно вызывать сколько угодно раз на одном и том же графе).
+//
+// Возвращает массив расстояний, INT_MAX = вершина недостижима.
+inline std::vector<int> csrDijkstra(const CSRGraph& g, int startVertex)
+{
+    const int V = g.vertexCount();
+    std::vector<int> distance(V, INT_MAX);
+    std::vector<char> visited(V, 0);
+
+    std::priority_queue<std::pair<int, int>,
+                        std::vector<std::pair<int, int>>,
+                        std::greater<std::pair<int, int>>> pq;
+
+    distance[startVertex] = 0;
+    pq.push({0, startVertex});
+
+    while (!pq.empty())
+    {
+        int u = pq.top().second;
+        pq.pop();
+        if (visited[u])
+            continue;
+        visited[u] = 1;
+
+        for (std::int64_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++)
+        {
+            int v = g.target(e);
+            int newDist = distance[u] + g.weight(e);
+            if (!visited[v] && newDist < distance[v])
+            {
+                distance[v] = newDist;
+                pq.push({newDist, v});
+            }
+        }
+    }
+    return distance;
+}
+
+// ========================================================================
+// ДЕЙКСТРА С ВЫБОРОМ ОЧЕРЕДИ
+// ========================================================================
+// Версия выше (std::priority_queue + ленивое удаление) кладёт вершину
+// в очередь при КАЖДОМ улучшении расстояния. Очереди ниже поддерживают
+// decreaseKey, поэтому каждая вершина лежит в очереди не более одного раза.
+//
+//   BinaryHeap  - std::priority_queue, ленивое удаление (как в simple_dijkstra.cxx)
+//   DaryHeap    - индексированная 4-арная куча, O((V + E) log V)
+//   Dial        - очередь Дайала, O(E + V * C), C - максимальный вес ребра
+//   Radix       - radix-куча, O(E + V log C)
+//   Auto        - Dial для маленьких весов, иначе Radix
+// ========================================================================
+
+enum class DijkstraQueue
+{
+    BinaryHeap,
+    DaryHeap,
+    Dial,
+    Radix,
+    Auto
+};
+
+// Максимальный вес ребра; бросает исключение при отрицательных весах
+inline int maxEdgeWeight(const CSRGraph& g)
+{
+    int maxWeight = 0;
+    const int* w = g.weightData();
+    for (std::int64_t e = 0; e < g.edgeCount(); e++)
+    {
+        if (w[e] < 0)
+            throw std::invalid_argument("Дейкстра: отрицательный вес ребра");
+        if (w[e] > maxWeight)
+            maxWeight = w[e];
+    }
+    return maxWeight;
+}
+
+// Общее ядро для очередей с decreaseKey.
+// Проверка visited не нужна: расстояние извлечённой вершины окончательно,
+// и условие newDist < distance[v] для неё уже никогда не выполнится.
+template <typename Queue>
+std::vector<int> dijkstraWithQueue(const CSRGraph& g, int startVertex, Queue& queue)
+{
+    std::vector<int> distance(g.vertexCount(), INT_MAX);
+    distance[startVertex] = 0;
+    queue.push(startVertex, 0);
+
+    while (!queue.empty())
+    {
+        int u = queue.pop();
+        int distU = distance[u];
+        for (std::int64_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++)
+        {
+            int v = g.target(e);
+            int newDist = distU + g.weight(e);
+            if (newDist < distance[v])
+            {
+                if (distance[v] == INT_MAX)
+                    queue.push(v, newDist);
+                else
+                    queue.decreaseKey(v, newDist);
+                distance[v] = newDist;
+            }
+        }
+    }
+    return distance;
+}
+
+// Порог выбора в режиме Auto: очередь Дайала выгодна, пока C + 1 корзин
+// помещаются в кэш и их обход не дороже логарифма кучи
+const int DIAL_MAX_WEIGHT = 4096;
+
+inline std::vector<int> csrDijkstra(const CSRGraph& g, int startVertex, DijkstraQueue queueType)
+{
+    const int V = g.vertexCount();
+    switch (queueType)
+    {
+    case DijkstraQueue::BinaryHeap:
+        return csrDijkstra(g, startVertex);
+    case DijkstraQueue::DaryHeap:
+    {
+        IndexedDaryHeap<4> heap(V);
+        return dijkstraWithQueue(g, startVertex, heap);
+    }
+    case DijkstraQueue::Dial:
+    {
+        BucketQueue queue(V, maxEdgeWeight(g));
+        return dijkstraWithQueue(g, startVertex, queue);
+    }
+    case DijkstraQueue::Radix:
+    {
+        maxEdgeWeight(g); // Только проверка на отрицательные веса
+        RadixHeap queue(V);
+        return dijkstraWithQueue(g, startVertex, queue);
+    }
+    case DijkstraQueue::Auto:
+    default:
+    {
+        int maxWeight = maxEdgeWeight(g);
+        if (maxWeight <= DIAL_MAX_WEIGHT)
+        {
+            BucketQueue queue(V, maxWeight);
+            return dijkstraWithQueue(g, startVertex, queue);
+        }
+        RadixHeap queue(V);
+        return dijkstraWithQueue(g, startVertex, queue);
+    }
+    }
+}
+
+inline const char* dijkstraQueueName(DijkstraQueue queueType)
+{
+    switch (queueType)
+    {
+    case DijkstraQueue::BinaryHeap: return "BinaryHeap";
+    case DijkstraQueue::DaryHeap:   return "4-aryHeap";
+    case DijkstraQueue::Dial:       return "Dial";
+    case DijkstraQueue::Radix:      return "Radix";
+    default:                        return "Auto";
+    }
+}
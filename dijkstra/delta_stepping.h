@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+#include "../graph_common/csr_graph.h"
+#include "../graph_common/thread_pool.h"
+
+// ========================================================================
+// DELTA-STEPPING (Meyer, Sanders) - ПАРАЛЛЕЛЬНЫЕ КРАТЧАЙШИЕ ПУТИ
+// ========================================================================
+// Дейкстра строго последовательна: за шаг извлекается ОДНА вершина с
+// минимальным расстоянием. Delta-stepping ослабляет порядок: вершины
+// раскладываются по "корзинам" ширины delta
+//
+//   корзина i = вершины с предварительным расстоянием в [i*delta, (i+1)*delta)
+//
+// и вся корзина обрабатывается параллельно. Рёбра делятся на
+//   ЛЁГКИЕ (w <= delta) - могут вернуть вершину в ту же корзину;
+//   ТЯЖЁЛЫЕ (w >  delta) - всегда ведут в следующие корзины.
+//
+//   для i = 0, 1, 2, ... пока есть непустые корзины:
+//     R = {}
+//     пока корзина i не пуста:           // "лёгкие раунды"
+//       F = корзина i; корзина i = {}; R += F
+//       параллельно: релаксация лёгких рёбер из F
+//     параллельно: релаксация тяжёлых рёбер из R (один раз на вершину)
+//
+// delta = 1 при целых весах - это Дейкстра по корзинам (алгоритм Дейкстры
+// с корзинами Дайала), delta = бесконечность - Беллман-Форд. Между ними -
+// компромисс: больше delta - больше параллельной работы на корзину, но и
+// больше повторных релаксаций вершин, расстояние которых ещё уменьшится.
+//
+// Реализация:
+//   - dist - атомики; релаксация - атомарный минимум через compare_exchange
+//   - корзины у каждого потока свои; все расстояния в работе лежат в
+//     [i*delta, i*delta + maxWeight], поэтому корзин хватает
+//     maxWeight / delta + 2, индекс берётся по модулю (циклический массив)
+//   - рёбра каждой вершины переставлены: сначала лёгкие, затем тяжёлые
+//     (одна граница lightEnd[u] вместо проверки веса на каждом ребре)
+//   - вершина могла попасть в корзину несколько раз: повторы отсекаются
+//     атомарной меткой раунда
+// ========================================================================
+
+class DeltaStepping
+{
+    const CSRGraph& graph;
+    ThreadPool& pool;
+    int delta = 1;
+    int maxWeight = 0;
+
+    // Рёбра, переставленные по вершинам: [edgeBegin(u), lightEnd[u]) - лёгкие
+    std::vector<int> targets, weights;
+    std::vector<std::int64_t> lightEnd;
+
+    std::vector<std::atomic<int>> dist;
+    std::vector<std::atomic<unsigned>> roundClaim; // Последний лёгкий раунд, обработавший вершину
+    std::vector<std::atomic<unsigned>> bucketClaim; // Последняя корзина, где вершина попала в R
+    unsigned round = 0;
+    unsigned bucketStamp = 0;
+
+    // bins[поток][корзина по модулю] и список R по потокам
+    std::vector<std::vector<std::vector<int>>> bins;
+    std::vector<std::vector<int>> localSettled;
+    std::vector<int> frontier, settled;
+    std::size_t numBins = 1;
+
+    void relax(int tid, int v, int newDist)
+    {
+        int current = dist[v].load(std::memory_order_relaxed);
+        while (newDist < current)
+        {
+            if (dist[v].compare_exchange_weak(current, newDist, std::memory_order_relaxed))
+            {
+                bins[tid][static_cast<std::size_t>(newDist / delta) % numBins].push_back(v);
+                return;
+            }
+        }
+    }
+
+    // Собрать корзину slot всех потоков во frontier; false - корзина пуста
+    bool gatherBin(std::size_t slot)
+    {
+        frontier.clear();
+        for (auto& local : bins)
+        {
+            frontier.insert(frontier.end(), local[slot].begin(), local[slot].end());
+            local[slot].clear();
+        }
+        return !frontier.empty();
+    }
+
+    bool binEmpty(std::size_t slot) const
+    {
+        for (const auto& local : bins)
+        {
+            if (!local[slot].empty())
+                return false;
+        }
+        return true;
+    }
+
+public:
+    // Статистика последнего запуска
+    std::int64_t bucketsProcessed = 0;
+    std::int64_t lightRounds = 0;
+
+    DeltaStepping(const CSRGraph& g, ThreadPool& threadPool, int bucketWidth)
+        : graph(g), pool(threadPool),
+          dist(g.vertexCount()), roundClaim(g.vertexCount()), bucketClaim(g.vertexCount()),
+          bins(threadPool.threadCount()), localSettled(threadPool.threadCount())
+    {
+        for (std::int64_t e = 0; e < g.edgeCount(); e++)
+            maxWeight = std::max(maxWeight, g.weight(e));
+        setDelta(bucketWidth);
+    }
+
+    // Ширина корзины по умолчанию: средний вес на вершину порядка delta
+    // (maxWeight / средняя степень, как предлагают Meyer и Sanders для
+    // случайных весов). Лучшее значение зависит от графа - см. бенчмарк.
+    static int suggestDelta(const CSRGraph& g)
+    {
+        int maxW = 0;
+        for (std::int64_t e = 0; e < g.edgeCount(); e++)
+            maxW = std::max(maxW, g.weight(e));
+        double averageDegree = g.vertexCount() > 0 ? static_cast<double>(g.edgeCount()) / g.vertexCount() : 1.0;
+        return std::max(1, static_cast<int>(maxW / std::max(1.0, averageDegree)));
+    }
+
+    int bucketWidth() const { return delta; }
+
+    // Сменить delta: рёбра заново делятся на лёгкие и тяжёлые
+    void setDelta(int bucketWidth)
+    {
+        delta = std::max(1, bucketWidth);
+        numBins = static_cast<std::size_t>(maxWeight / delta) + 2;
+        for (auto& local : bins)
+            local.assign(numBins, std::vector<int>());
+
+        const int V = graph.vertexCount();
+        targets.resize(static_cast<std::size_t>(graph.edgeCount()));
+        weights.resize(static_cast<std::size_t>(graph.edgeCount()));
+        lightEnd.resize(V);
+        pool.parallelFor(0, V, [&](std::int64_t u) {
+            std::int64_t light = graph.edgeBegin(static_cast<int>(u));
+            std::int64_t heavy = graph.edgeEnd(static_cast<int>(u));
+            for (std::int64_t e = graph.edgeBegin(static_cast<int>(u)); e < graph.edgeEnd(static_cast<int>(u)); e++)
+            {
+                std::int64_t pos = graph.weight(e) <= delta ? light++ : --heavy;
+                targets[pos] = graph.target(e);
+                weights[pos] = graph.weight(e);
+            }
+            lightEnd[u] = light;
+        }, 1024);
+    }
+
+    // Расстояния от source (INT_MAX - недостижима), как у csrDijkstra
+    std::vector<int> run(int source)
+    {
+        const int V = graph.vertexCount();
+        pool.parallelFor(0, V, [&](std::int64_t v) {
+            dist[v].store(INT_MAX, std::memory_order_relaxed);
+            roundClaim[v].store(0, std::memory_order_relaxed);
+            bucketClaim[v].store(0, std::memory_order_relaxed);
+        }, 4096);
+        round = bucketStamp = 0;
+        bucketsProcessed = lightRounds = 0;
+
+        dist[source].store(0, std::memory_order_relaxed);
+        bins[0][0].push_back(source);
+
+        std::int64_t bucket = 0;
+        std::size_t empty = 0; // Подряд пустых корзин: numBins - все пусты
+        while (empty < numBins)
+        {
+            const std::size_t slot = static_cast<std::size_t>(bucket) % numBins;
+            if (binEmpty(slot))
+            {
+                empty++;
+                bucket++;
+                continue;
+            }
+            empty = 0;
+            bucketsProcessed++;
+            bucketStamp++;
+            settled.clear();
+
+            // Лёгкие раунды: пока корзина пополняется
+            while (gatherBin(slot))
+            {
+                lightRounds++;
+                round++;
+                const std::int64_t low = bucket * delta;
+                const std::int64_t high = low + delta;
+                pool.parallelFor(0, static_cast<std::int64_t>(frontier.size()), [&](std::int64_t i) {
+                    int tid = pool.currentThreadIndex();
+                    int u = frontier[i];
+                    int d = dist[u].load(std::memory_order_relaxed);
+                    // Устаревшая запись (вершина уже в другой корзине) или повтор в раунде
+                    if (d < low || d >= high || roundClaim[u].exchange(round, std::memory_order_relaxed) == round)
+                        return;
+                    if (bucketClaim[u].exchange(bucketStamp, std::memory_order_relaxed) != bucketStamp)
+                        localSettled[tid].push_back(u);
+                    for (std::int64_t e = graph.edgeBegin(u); e < lightEnd[u]; e++)
+                        relax(tid, targets[e], d + weights[e]);
+                }, 64);
+            }
+
+            // Тяжёлые рёбра - один раз для каждой вершины корзины
+            for (auto& local : localSettled)
+            {
+                settled.insert(settled.end(), local.begin(), local.end());
+                local.clear();
+            }
+            pool.parallelFor(0, static_cast<std::int64_t>(settled.size()), [&](std::int64_t i) {
+                int tid = pool.currentThreadIndex();
+                int u = settled[i];
+                int d = dist[u].load(std::memory_order_relaxed);
+                for (std::int64_t e = lightEnd[u]; e < graph.edgeEnd(u); e++)
+                    relax(tid, targets[e], d + weights[e]);
+            }, 64);
+            bucket++;
+        }
+
+        std::vector<int> result(V);
+        for (int v = 0; v < V; v++)
+            result[v] = dist[v].load(std::memory_order_relaxed);
+        return result;
+    }
+};
+
+// Однократный запуск с delta по умолчанию
+inline std::vector<int> deltaStepping(const CSRGraph& g, int source, ThreadPool& pool)
+{
+    DeltaStepping solver(g, pool, DeltaStepping::suggestDelta(g));
+    return solver.run(source);
+}
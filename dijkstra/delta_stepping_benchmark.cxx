@@ -0,0 +1,111 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "../graph_common/graph_generators.h"
+#include "csr_dijkstra.h"
+#include "delta_stepping.h"
+
+// ========================================================================
+// DELTA-STEPPING: ВЫБОР DELTA И МАСШТАБИРУЕМОСТЬ
+// ========================================================================
+// Два графа с разной структурой:
+//   - дорожная решётка (generateRoadGrid): большой диаметр, веса ~100
+//   - R-MAT (Graph500, веса 1..255): малый диаметр, степенные степени
+// Для каждого: последовательная csrDijkstra, delta-stepping с разными
+// delta на всех ядрах и выбранная delta на 1, 2, 4, ... потоках.
+// Все расстояния сверяются с Дейкстрой.
+//
+// Запуск: ./delta_stepping_benchmark [side] [scale] (по умолчанию 700 и 18)
+// ========================================================================
+
+template <typename Func>
+double bestOfMs(int runs, Func&& f)
+{
+    double best = 1e18;
+    for (int r = 0; r < runs; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+void benchmarkGraph(const char* name, const CSRGraph& g, int source, int cores)
+{
+    std::cout << "\n--- " << name << ": V = " << g.vertexCount() << ", E = " << g.edgeCount() << " ---" << std::endl;
+
+    std::vector<int> expected;
+    double dijkstraMs = bestOfMs(3, [&]() { expected = csrDijkstra(g, source, DijkstraQueue::DaryHeap); });
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "csrDijkstra (4-куча): " << dijkstraMs << " мс\n" << std::endl;
+
+    // Подбор delta на всех ядрах
+    ThreadPool pool(cores);
+    const int suggested = DeltaStepping::suggestDelta(g);
+    DeltaStepping solver(g, pool, suggested);
+    std::cout << "delta (потоков: " << cores << ")        мс     корзин   раундов" << std::endl;
+    int bestDelta = suggested;
+    double bestMs = 1e18;
+    for (int factor : {-8, -2, 1, 2, 8, 32})
+    {
+        int delta = factor < 0 ? std::max(1, suggested / -factor) : suggested * factor;
+        solver.setDelta(delta);
+        std::vector<int> actual;
+        double ms = bestOfMs(3, [&]() { actual = solver.run(source); });
+        if (ms < bestMs)
+        {
+            bestMs = ms;
+            bestDelta = delta;
+        }
+        std::cout << std::setw(8) << delta << (delta == suggested ? " (suggestDelta)" : "               ")
+                  << std::setw(10) << ms << std::setw(10) << solver.bucketsProcessed
+                  << std::setw(10) << solver.lightRounds
+                  << (actual == expected ? "   ✓" : "   ✗ ОШИБКА") << std::endl;
+    }
+
+    // Масштабируемость с лучшей delta
+    std::cout << "\nПотоки (delta = " << bestDelta << ")       мс   ускорение к Дейкстре" << std::endl;
+    std::vector<int> threadCounts;
+    for (int t = 1; t < cores; t *= 2)
+        threadCounts.push_back(t);
+    threadCounts.push_back(cores);
+    for (int threads : threadCounts)
+    {
+        ThreadPool threadPool(threads);
+        DeltaStepping ds(g, threadPool, bestDelta);
+        std::vector<int> actual;
+        double ms = bestOfMs(3, [&]() { actual = ds.run(source); });
+        std::cout << std::setw(6) << threads << std::setw(21) << ms << std::setw(12) << dijkstraMs / ms << "x"
+                  << (actual == expected ? "   ✓" : "   ✗ ОШИБКА") << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int side = (argc > 1) ? std::atoi(argv[1]) : 700;
+    int scale = (argc > 2) ? std::atoi(argv[2]) : 18;
+    int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  DELTA-STEPPING (ядер: " << cores << ")" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RoadGrid grid = generateRoadGrid(side, 1);
+    benchmarkGraph("Дорожная решётка", grid.graph, 0, cores);
+
+    CSRGraph rmat = CSRGraph::fromEdgeList(1 << scale, generateRMAT(scale, 16, 1, 255), true);
+    int source = 0;
+    for (int v = 1; v < rmat.vertexCount(); v++)
+    {
+        if (rmat.degree(v) > rmat.degree(source))
+            source = v;
+    }
+    benchmarkGraph("R-MAT", rmat, source, cores);
+    return 0;
+}
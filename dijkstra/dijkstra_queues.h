@@ -0,0 +1,216 @@
+#pragma once
+
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+// ========================================================================
+// МОНОТОННЫЕ ОЧЕРЕДИ ДЛЯ ДЕЙКСТРЫ С ЦЕЛЫМИ ВЕСАМИ
+// ========================================================================
+// В алгоритме Дейкстры извлекаемые минимумы никогда не убывают: если
+// извлекли вершину с расстоянием d, все следующие будут >= d. Для целых
+// неотрицательных весов это позволяет обойтись без сравнений кучи.
+//
+// Обе очереди имеют одинаковый интерфейс (как IndexedDaryHeap):
+//   push(v, key), decreaseKey(v, key), contains(v), empty(), pop()
+// и хранят каждую вершину не более одного раза.
+// ========================================================================
+
+// ------------------------------------------------------------------------
+// Очередь Дайала (Dial's bucket queue)
+// ------------------------------------------------------------------------
+// Корзина на каждое значение расстояния. Так как все ключи в очереди лежат
+// в диапазоне [min, min + C], где C - максимальный вес ребра, достаточно
+// C + 1 корзин, используемых по кругу (индекс = key % (C + 1)).
+//
+// Корзины - двусвязные списки на массивах next/prev, поэтому decreaseKey
+// (перенос вершины в другую корзину) выполняется за O(1).
+//
+// Сложность Дейкстры: O(E + V * C) - идеальна для маленьких весов.
+// ------------------------------------------------------------------------
+class BucketQueue
+{
+    int numBuckets;           // C + 1
+    std::vector<int> head;    // Первая вершина в корзине, -1 = пусто
+    std::vector<int> next;    // Следующая вершина в той же корзине
+    std::vector<int> prev;    // Предыдущая вершина в той же корзине
+    std::vector<int> key;     // Текущий ключ вершины
+    std::vector<char> inQueue;
+    std::size_t count;        // Количество вершин в очереди
+    int cursor;               // Текущий минимальный ключ (монотонно растёт)
+
+    void link(int v)
+    {
+        int b = key[v] % numBuckets;
+        prev[v] = -1;
+        next[v] = head[b];
+        if (head[b] != -1)
+            prev[head[b]] = v;
+        head[b] = v;
+    }
+
+    void unlink(int v)
+    {
+        if (prev[v] != -1)
+            next[prev[v]] = next[v];
+        else
+            head[key[v] % numBuckets] = next[v];
+        if (next[v] != -1)
+            prev[next[v]] = prev[v];
+    }
+
+public:
+    // capacity - количество вершин, maxWeight - максимальный вес ребра C
+    BucketQueue(int capacity, int maxWeight)
+        : numBuckets(maxWeight + 1), head(maxWeight + 1, -1),
+          next(capacity), prev(capacity), key(capacity), inQueue(capacity, 0),
+          count(0), cursor(0)
+    {
+    }
+
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+    bool contains(int v) const { return inQueue[v] != 0; }
+
+    void push(int v, int k)
+    {
+        key[v] = k;
+        inQueue[v] = 1;
+        link(v);
+        count++;
+    }
+
+    void decreaseKey(int v, int k)
+    {
+        unlink(v);
+        key[v] = k;
+        link(v);
+    }
+
+    int pop()
+    {
+        // Ищем ближайшую непустую корзину (не более C + 1 шагов)
+        while (head[cursor % numBuckets] == -1)
+        {
+            cursor++;
+        }
+        int v = head[cursor % numBuckets];
+        unlink(v);
+        inQueue[v] = 0;
+        count--;
+        return v;
+    }
+};
+
+// ------------------------------------------------------------------------
+// Radix-куча (Ahuja, Mehlhorn, Orlin, Tarjan)
+// ------------------------------------------------------------------------
+// 33 корзины для 32-битных ключей. Ключ k лежит в корзине с номером
+// "старший различающийся бит k и last", где last - последний извлечённый
+// минимум:
+//   корзина 0      - ключи, равные last
+//   корзина i > 0  - ключи, отличающиеся от last в бите i - 1 и выше не отличающиеся
+//
+// При извлечении, если корзина 0 пуста, берём первую непустую корзину,
+// находим в ней минимум, делаем его новым last и раскладываем корзину
+// заново - каждый элемент переходит в корзину с меньшим номером. Поэтому
+// каждая вершина перекладывается O(log C) раз, независимо от величины весов.
+//
+// Сложность Дейкстры: O(E + V log C) - не зависит от C линейно, в отличие
+// от очереди Дайала.
+// ------------------------------------------------------------------------
+class RadixHeap
+{
+    static const int NUM_BUCKETS = 33;
+
+    std::vector<int> buckets[NUM_BUCKETS]; // Вершины в корзинах
+    std::vector<std::uint32_t> key;        // Текущий ключ вершины
+    std::vector<int> bucketOf;             // Номер корзины вершины, -1 = нет в очереди
+    std::vector<int> posInBucket;          // Позиция вершины внутри корзины
+    std::uint32_t last;                    // Последний извлечённый минимум
+    std::size_t count;
+
+    int bucketIndex(std::uint32_t k) const
+    {
+        if (k == last)
+            return 0;
+        return 32 - __builtin_clz(k ^ last);
+    }
+
+    void insertInto(int v, int b)
+    {
+        bucketOf[v] = b;
+        posInBucket[v] = static_cast<int>(buckets[b].size());
+        buckets[b].push_back(v);
+    }
+
+    void removeFrom(int v)
+    {
+        std::vector<int>& bucket = buckets[bucketOf[v]];
+        int p = posInBucket[v];
+        int moved = bucket.back();
+        bucket[p] = moved;
+        posInBucket[moved] = p;
+        bucket.pop_back();
+    }
+
+public:
+    explicit RadixHeap(int capacity)
+        : key(capacity), bucketOf(capacity, -1), posInBucket(capacity), last(0), count(0)
+    {
+    }
+
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+    bool contains(int v) const { return bucketOf[v] != -1; }
+
+    void push(int v, int k)
+    {
+        key[v] = static_cast<std::uint32_t>(k);
+        insertInto(v, bucketIndex(key[v]));
+        count++;
+    }
+
+    void decreaseKey(int v, int k)
+    {
+        removeFrom(v);
+        key[v] = static_cast<std::uint32_t>(k);
+        insertInto(v, bucketIndex(key[v]));
+    }
+
+    int pop()
+    {
+        if (buckets[0].empty())
+        {
+            // Первая непустая корзина
+            int b = 1;
+            while (buckets[b].empty())
+                b++;
+
+            // Новый last - минимум этой корзины
+            std::uint32_t minKey = UINT32_MAX;
+            for (int v : buckets[b])
+            {
+                if (key[v] < minKey)
+                    minKey = key[v];
+            }
+            last = minKey;
+
+            // Раскладываем корзину заново (все элементы уйдут в корзины < b)
+            std::vector<int> moving;
+            moving.swap(buckets[b]);
+            for (int v : moving)
+            {
+                insertInto(v, bucketIndex(key[v]));
+            }
+            moving.clear();
+            moving.swap(buckets[b]); // Возвращаем ёмкость, чтобы не перевыделять
+        }
+
+        int v = buckets[0].back();
+        buckets[0].pop_back();
+        bucketOf[v] = -1;
+        count--;
+        return v;
+    }
+};
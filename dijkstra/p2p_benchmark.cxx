@@ -0,0 +1,100 @@
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../graph_common/graph_generators.h"
+#include "csr_dijkstra.h"
+#include "point_to_point.h"
+
+// ========================================================================
+// ЗАПРОСЫ s -> t: ДЕЙКСТРА, ДВУНАПРАВЛЕННАЯ ДЕЙКСТРА, A*
+// ========================================================================
+// "Дорожная сеть" - generateRoadGrid (решётка перекрёстков со случайно
+// сдвинутыми координатами, вес - длина дороги в метрах). Случайные пары
+// s, t; для каждого алгоритма - среднее время запроса и среднее число
+// извлечённых вершин.
+// Расстояния сверяются с полной Дейкстрой (csrDijkstra).
+//
+// Запуск: ./p2p_benchmark [side] [queries] (по умолчанию 700 и 200)
+// ========================================================================
+
+int main(int argc, char* argv[])
+{
+    int side = (argc > 1) ? std::atoi(argv[1]) : 700;
+    int queries = (argc > 2) ? std::atoi(argv[2]) : 200;
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  ЗАПРОСЫ s -> t НА ДОРОЖНОЙ РЕШЁТКЕ" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RoadGrid grid = generateRoadGrid(side, 1);
+    const CSRGraph& g = grid.graph;
+    const int V = g.vertexCount();
+    std::cout << "V = " << V << ", E = " << g.edgeCount() / 2 << ", запросов: " << queries << "\n" << std::endl;
+
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> vertex(0, V - 1);
+    std::vector<std::pair<int, int>> pairs(queries);
+    for (auto& p : pairs)
+        p = {vertex(rng), vertex(rng)};
+
+    // Эталон: полная Дейкстра (по одной на запрос - так работает simple_dijkstra)
+    std::vector<int> expected(queries);
+    auto start = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++)
+        expected[q] = csrDijkstra(g, pairs[q].first, DijkstraQueue::DaryHeap)[pairs[q].second];
+    double fullMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    PointToPointQuery query(g, g);
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Алгоритм                  мс/запрос   вершин/запрос" << std::endl;
+    std::cout << "Полная Дейкстра          " << std::setw(10) << fullMs / queries
+              << std::setw(16) << V << "   ✓" << std::endl;
+
+    auto run = [&](const char* name, auto&& algorithm) {
+        bool ok = true;
+        std::int64_t settled = 0;
+        auto begin = std::chrono::steady_clock::now();
+        for (int q = 0; q < queries; q++)
+        {
+            int d = algorithm(pairs[q].first, pairs[q].second);
+            settled += query.settledCount();
+            ok = ok && d == expected[q];
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        std::cout << name << std::setw(10) << ms / queries << std::setw(16) << settled / queries
+                  << (ok ? "   ✓" : "   ✗ ОШИБКА") << std::endl;
+    };
+
+    run("Дейкстра до t            ", [&](int s, int t) { return query.dijkstra(s, t); });
+    run("Двунаправленная          ", [&](int s, int t) { return query.bidirectional(s, t); });
+    run("A* (евклидова)           ", [&](int s, int t) {
+        return query.astar(s, t, EuclideanHeuristic(grid.x, grid.y, t));
+    });
+
+    // Проверка восстановления пути: сумма весов рёбер равна расстоянию
+    int s = pairs[0].first, t = pairs[0].second;
+    int d = query.bidirectional(s, t);
+    std::vector<int> path = query.path();
+    long long length = 0;
+    bool valid = !path.empty() && path.front() == s && path.back() == t;
+    for (std::size_t i = 0; valid && i + 1 < path.size(); i++)
+    {
+        int best = INT_MAX;
+        for (std::int64_t e = g.edgeBegin(path[i]); e < g.edgeEnd(path[i]); e++)
+        {
+            if (g.target(e) == path[i + 1])
+                best = std::min(best, g.weight(e));
+        }
+        valid = best != INT_MAX;
+        length += best;
+    }
+    std::cout << "\nПуть " << s << " -> " << t << ": " << path.size() << " вершин, длина " << d
+              << ((valid && length == d) ? "   ✓" : "   ✗ ОШИБКА") << std::endl;
+    return 0;
+}
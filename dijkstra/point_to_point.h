@@ -0,0 +1,273 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "../graph_common/csr_graph.h"
+#include "../graph_common/indexed_heap.h"
+
+// ========================================================================
+// ПОИСК КРАТЧАЙШЕГО ПУТИ МЕЖДУ ДВУМЯ ВЕРШИНАМИ (s -> t)
+// ========================================================================
+// Graph::dijkstra(startVertex) из simple_dijkstra.cxx всегда обходит весь
+// граф и хранит distance/visited в полях объекта - второй запуск требует
+// повторной инициализации O(V). Когда нужно одно расстояние s -> t на
+// графе с миллионами вершин, это почти вся работа впустую.
+//
+// PointToPointQuery - объект для МНОГИХ запросов на одном графе:
+//
+//   1. Ранняя остановка: поиск заканчивается, как только t извлечена
+//      из очереди (её расстояние окончательно).
+//   2. Метки времени: dist[v] действительно, только если stamp[v] равен
+//      номеру текущего запроса. Новый запрос увеличивает номер - O(1)
+//      вместо заполнения массивов O(V). Куча очищается за O(своего размера).
+//   3. Три алгоритма:
+//        dijkstra(s, t)      - обычная Дейкстра с ранней остановкой
+//        bidirectional(s, t) - два поиска навстречу: от s по рёбрам,
+//                              от t по обратным рёбрам; каждый проходит
+//                              примерно половину "радиуса" - на дорожных
+//                              графах это вдвое меньше вершин
+//        astar(s, t, h)      - A*: ключ вершины dist[v] + h(v), где h(v) -
+//                              нижняя оценка расстояния v -> t (например,
+//                              евклидово расстояние по координатам). Поиск
+//                              вытягивается в сторону цели.
+//
+// Все веса неотрицательные. Недостижимая t - расстояние INT_MAX.
+// ========================================================================
+
+class PointToPointQuery
+{
+    // Состояние одного направления поиска
+    struct Search
+    {
+        std::vector<int> dist;
+        std::vector<int> parent;
+        std::vector<unsigned> stamp;
+        IndexedDaryHeap<4> heap;
+
+        explicit Search(int V) : dist(V), parent(V), stamp(V, 0), heap(V) {}
+    };
+
+    const CSRGraph& graph;
+    const CSRGraph& reverse; // Обратные рёбра (для неориентированного графа - сам граф)
+    Search forward, backward;
+    unsigned epoch = 0;
+
+    int source = -1, target = -1;
+    int meeting = -1;       // Вершина, через которую проходит найденный путь
+    long long best = 0;     // Длина найденного пути (LLONG_MAX - пути нет)
+    std::int64_t settled = 0;
+
+    bool reached(const Search& s, int v) const { return s.stamp[v] == epoch; }
+
+    int distanceIn(const Search& s, int v) const { return reached(s, v) ? s.dist[v] : INT_MAX; }
+
+    void begin(int s, int t)
+    {
+        if (++epoch == 0)
+        {
+            // Переполнение счётчика: честная очистка меток
+            std::fill(forward.stamp.begin(), forward.stamp.end(), 0);
+            std::fill(backward.stamp.begin(), backward.stamp.end(), 0);
+            epoch = 1;
+        }
+        forward.heap.clear();
+        backward.heap.clear();
+        source = s;
+        target = t;
+        meeting = -1;
+        best = LLONG_MAX;
+        settled = 0;
+    }
+
+    // Новое расстояние до v. Вершина, уже извлечённая из кучи, кладётся
+    // снова (так A* остаётся точным и с несогласованной эвристикой)
+    void reach(Search& s, int v, int distance, int parent, int key)
+    {
+        if (!reached(s, v))
+        {
+            s.stamp[v] = epoch;
+            s.heap.push(v, key);
+        }
+        else
+        {
+            s.heap.pushOrDecrease(v, key);
+        }
+        s.dist[v] = distance;
+        s.parent[v] = parent;
+    }
+
+    int finish()
+    {
+        return best == LLONG_MAX ? INT_MAX : static_cast<int>(best);
+    }
+
+public:
+    // reverseGraph - транспонированный граф (g.transpose()) для
+    // ориентированных графов; для неориентированных - сам граф
+    PointToPointQuery(const CSRGraph& g, const CSRGraph& reverseGraph)
+        : graph(g), reverse(reverseGraph), forward(g.vertexCount()), backward(g.vertexCount())
+    {
+    }
+
+    // Дейкстра от s, остановка при извлечении t
+    int dijkstra(int s, int t)
+    {
+        begin(s, t);
+        reach(forward, s, 0, -1, 0);
+        while (!forward.heap.empty())
+        {
+            int u = forward.heap.pop();
+            settled++;
+            if (u == t)
+            {
+                best = forward.dist[t];
+                meeting = t;
+                break;
+            }
+            int distU = forward.dist[u];
+            for (std::int64_t e = graph.edgeBegin(u); e < graph.edgeEnd(u); e++)
+            {
+                int v = graph.target(e);
+                int newDist = distU + graph.weight(e);
+                if (newDist < distanceIn(forward, v))
+                    reach(forward, v, newDist, u, newDist);
+            }
+        }
+        return finish();
+    }
+
+    // Двунаправленная Дейкстра. best - длина лучшего пути s -> u -> v -> t,
+    // найденного при просмотре рёбер между двумя поисками. Остановка, когда
+    // minKey(вперёд) + minKey(назад) >= best: любой ещё не найденный путь
+    // проходит через вершину, не извлечённую ни одним поиском, и не короче.
+    int bidirectional(int s, int t)
+    {
+        begin(s, t);
+        reach(forward, s, 0, -1, 0);
+        reach(backward, t, 0, -1, 0);
+        if (s == t)
+        {
+            best = 0;
+            meeting = s;
+            return 0;
+        }
+
+        while (!forward.heap.empty() && !backward.heap.empty())
+        {
+            if (static_cast<long long>(forward.heap.topKey()) + backward.heap.topKey() >= best)
+                break;
+
+            // Расширяем направление с меньшей очередью (баланс работы)
+            bool goForward = forward.heap.size() <= backward.heap.size();
+            Search& self = goForward ? forward : backward;
+            Search& other = goForward ? backward : forward;
+            const CSRGraph& edges = goForward ? graph : reverse;
+
+            int u = self.heap.pop();
+            settled++;
+            int distU = self.dist[u];
+            for (std::int64_t e = edges.edgeBegin(u); e < edges.edgeEnd(u); e++)
+            {
+                int v = edges.target(e);
+                int newDist = distU + edges.weight(e);
+                if (newDist < distanceIn(self, v))
+                    reach(self, v, newDist, u, newDist);
+                if (reached(other, v))
+                {
+                    long long candidate = static_cast<long long>(newDist) + other.dist[v];
+                    if (candidate < best)
+                    {
+                        best = candidate;
+                        meeting = v;
+                    }
+                }
+            }
+        }
+        return finish();
+    }
+
+    // A* с эвристикой h(v) - нижней оценкой расстояния v -> t.
+    // Эвристика должна быть согласованной: h(u) <= w(u, v) + h(v) и h(t) = 0
+    // (евклидово расстояние при весах не меньше длины отрезка - такая).
+    // Тогда каждая вершина извлекается один раз, как в Дейкстре.
+    template <typename Heuristic>
+    int astar(int s, int t, Heuristic&& h)
+    {
+        begin(s, t);
+        reach(forward, s, 0, -1, h(s));
+        while (!forward.heap.empty())
+        {
+            int u = forward.heap.pop();
+            settled++;
+            if (u == t)
+            {
+                best = forward.dist[t];
+                meeting = t;
+                break;
+            }
+            int distU = forward.dist[u];
+            for (std::int64_t e = graph.edgeBegin(u); e < graph.edgeEnd(u); e++)
+            {
+                int v = graph.target(e);
+                int newDist = distU + graph.weight(e);
+                if (newDist < distanceIn(forward, v))
+                    reach(forward, v, newDist, u, newDist + h(v));
+            }
+        }
+        return finish();
+    }
+
+    // Путь последнего запроса s -> t (пустой, если t недостижима)
+    std::vector<int> path() const
+    {
+        std::vector<int> result;
+        if (meeting == -1)
+            return result;
+        for (int v = meeting; v != -1; v = forward.parent[v])
+        {
+            result.push_back(v);
+        }
+        std::reverse(result.begin(), result.end());
+        // Часть от точки встречи до t - по обратному поиску (только у bidirectional)
+        if (meeting != target)
+        {
+            for (int v = backward.parent[meeting]; v != -1; v = backward.parent[v])
+            {
+                result.push_back(v);
+            }
+        }
+        return result;
+    }
+
+    // Сколько вершин извлечено из очередей последним запросом
+    std::int64_t settledCount() const { return settled; }
+};
+
+// ========================================================================
+// ЕВКЛИДОВА ЭВРИСТИКА ДЛЯ A*
+// ========================================================================
+// Вершины имеют координаты (x[v], y[v]). Если вес каждого ребра не меньше
+// scale * длина отрезка между его концами (дороги не короче прямой),
+// то floor(scale * |v - t|) - согласованная нижняя оценка.
+// ========================================================================
+struct EuclideanHeuristic
+{
+    const std::vector<double>& x;
+    const std::vector<double>& y;
+    int target;
+    double scale;
+
+    EuclideanHeuristic(const std::vector<double>& xs, const std::vector<double>& ys, int t, double weightPerUnit = 1.0)
+        : x(xs), y(ys), target(t), scale(weightPerUnit)
+    {
+    }
+
+    int operator()(int v) const
+    {
+        return static_cast<int>(scale * std::hypot(x[v] - x[target], y[v] - y[target]));
+    }
+};
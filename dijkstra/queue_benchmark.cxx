@@ -0,0 +1,74 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "csr_dijkstra.h"
+
+// ========================================================================
+// СРАВНЕНИЕ ОЧЕРЕДЕЙ ДЛЯ ДЕЙКСТРЫ
+// ========================================================================
+// Решётка side x side со случайными весами в диапазоне [1, maxWeight].
+// Для каждой очереди замеряем время и сверяем расстояния с эталоном
+// (std::priority_queue с ленивым удалением).
+//
+// Запуск: ./queue_benchmark [сторона_решётки] (по умолчанию 700)
+// ========================================================================
+
+CSRGraph makeGrid(int side, int maxWeight, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> weightDist(1, maxWeight);
+    CSRGraphBuilder builder(side * side, true);
+    builder.reserve(static_cast<std::size_t>(side) * side * 2);
+    for (int r = 0; r < side; r++)
+    {
+        for (int c = 0; c < side; c++)
+        {
+            int u = r * side + c;
+            if (c + 1 < side) builder.addEdge(u, u + 1, weightDist(rng));
+            if (r + 1 < side) builder.addEdge(u, u + side, weightDist(rng));
+        }
+    }
+    return builder.build();
+}
+
+int main(int argc, char* argv[])
+{
+    int side = (argc > 1) ? std::atoi(argv[1]) : 700;
+    std::mt19937 rng(7);
+
+    const DijkstraQueue queues[] = {
+        DijkstraQueue::BinaryHeap, DijkstraQueue::DaryHeap,
+        DijkstraQueue::Dial, DijkstraQueue::Radix, DijkstraQueue::Auto
+    };
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  ДЕЙКСТРА: сравнение очередей" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    for (int maxWeight : {10, 1000, 100000})
+    {
+        CSRGraph g = makeGrid(side, maxWeight, rng);
+        std::cout << "\nРешётка " << side << "x" << side << ", веса [1, " << maxWeight << "]" << std::endl;
+
+        std::vector<int> reference = csrDijkstra(g, 0);
+        for (DijkstraQueue q : queues)
+        {
+            // Очередь Дайала с огромным C бессмысленна: пропускаем
+            if (q == DijkstraQueue::Dial && maxWeight > DIAL_MAX_WEIGHT)
+                continue;
+
+            auto start = std::chrono::steady_clock::now();
+            std::vector<int> distance = csrDijkstra(g, 0, q);
+            auto end = std::chrono::steady_clock::now();
+            double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+            std::cout << "  " << std::left << std::setw(12) << dijkstraQueueName(q)
+                      << std::right << std::setw(10) << std::fixed << std::setprecision(2) << ms << " мс"
+                      << (distance == reference ? "   ✓" : "   ✗ РАСХОЖДЕНИЕ") << std::endl;
+        }
+    }
+    return 0;
+}
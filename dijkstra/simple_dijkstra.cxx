@@ -4,6 +4,8 @@
 #include <climits>
 #include <iomanip>
 
+#include "../common/trace.h"
+
 // Вспомогательная функция для вывода содержимого приоритетной очереди
 void printPriorityQueue(std::priority_queue<std::pair<int, int>, 
                                            std::vector<std::pair<int, int>>, 
@@ -34,13 +36,14 @@ struct Edge
 };
 
 // Класс для представления взвешенного графа
+template <typename Trace = NoTrace>
 class Graph
 {
     int numVertices;                              // Количество вершин
     std::vector<std::vector<Edge>> adj;          // Список смежности с весами
     std::vector<int> distance;                    // Массив кратчайших расстояний
     std::vector<bool> visited;                    // Массив для отслеживания обработанных вершин
-    bool verbose;                                  // Режим детального вывода
+    Trace verbose;                                 // Режим детального вывода
 
 public:
     // Конструктор: создаем граф с заданным количеством вершин
@@ -211,7 +214,7 @@ int main()
     //     5        2
     //     |
     //     1
-    Graph g1(6, true);
+    Graph<VerboseTrace> g1(6, true);
     g1.addEdge(0, 1, 3);
     g1.addEdge(0, 2, 2);
     g1.addEdge(1, 3, 1);
@@ -231,7 +234,7 @@ int main()
     //     1        1        4
     //     |        |
     //     3 --2--> 2
-    Graph g2(5, true);
+    Graph<VerboseTrace> g2(5, true);
     g2.addEdge(0, 1, 1);
     g2.addEdge(0, 3, 4);
     g2.addEdge(1, 2, 2);
@@ -250,7 +253,7 @@ int main()
     //     / \   / \
     //    1   2 4   1
     //    1   2 4   1
-    Graph g3(7, true);
+    Graph<VerboseTrace> g3(7, true);
     g3.addEdge(0, 1, 5);
     g3.addEdge(0, 2, 3);
     g3.addEdge(1, 3, 1);
@@ -263,7 +266,7 @@ int main()
     std::cout << "  ТЕСТ 4: Граф с циклом (без детального вывода)" << std::endl;
     std::cout << "========================================" << std::endl;
     // Тест 4: Граф с циклом
-    Graph g4(4, false);
+    Graph<> g4(4, false);
     g4.addEdge(0, 1, 1);
     g4.addEdge(1, 2, 2);
     g4.addEdge(2, 3, 3);
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "parallel_apsp.h"
+#include "../graph_common/text_columns.h"
+
+// ========================================================================
+// ПАРАЛЛЕЛЬНЫЙ APSP: ускорение в зависимости от числа потоков
+// ========================================================================
+// Два графа:
+//   плотный     - V вершин, каждая дуга u -> v (u != v) с вероятностью
+//                 0.2: без повторов, E / V² ~ 0.2 - выше порога Auto
+//   разреженный - 2V вершин, ~8 рёбер на вершину
+//   разреженный с весами 0..3 - много рёбер нулевого веса: у источников
+//                 разные деревья кратчайших путей с равными длинами
+// Для каждого числа потоков 1, 2, 4, ... (до числа ядер) замеряем
+// параллельный блочный Флойд-Уоршелл и Дейкстру из каждой вершины,
+// сверяем расстояния и восстановленные пути (у PATH_CHECK_SOURCES
+// источников - до всех вершин) и печатаем ускорение относительно
+// одного потока.
+//
+// Запуск: ./apsp_benchmark [V] (по умолчанию 1024)
+// ========================================================================
+
+const int PATH_CHECK_SOURCES = 64;
+
+// Веса рёбер - равномерно из [minWeight, maxWeight]
+CSRGraph makeRandomGraph(int V, long long E, int minWeight, int maxWeight, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> vertexDist(0, V - 1);
+    std::uniform_int_distribution<int> weightDist(minWeight, maxWeight);
+    CSRGraphBuilder builder(V);
+    builder.reserve(static_cast<std::size_t>(E));
+    for (long long i = 0; i < E; i++)
+    {
+        builder.addEdge(vertexDist(rng), vertexDist(rng), weightDist(rng));
+    }
+    return builder.build();
+}
+
+// Каждая дуга u -> v (u != v) независимо с вероятностью density - без
+// повторов, поэтому E / V² действительно около density
+CSRGraph makeDenseGraph(int V, double density, std::mt19937& rng)
+{
+    std::bernoulli_distribution hasEdge(density);
+    std::uniform_int_distribution<int> weightDist(1, 1000);
+    CSRGraphBuilder builder(V);
+    builder.reserve(static_cast<std::size_t>(density * V * V));
+    for (int u = 0; u < V; u++)
+    {
+        for (int v = 0; v < V; v++)
+        {
+            if (u != v && hasEdge(rng))
+                builder.addEdge(u, v, weightDist(rng));
+        }
+    }
+    return builder.build();
+}
+
+// Путь u -> v из reconstructPath: начинается в u, кончается в v, идёт по
+// рёбрам графа, и сумма самых лёгких из кратных рёбер равна dist(u, v)
+bool pathMatches(const CSRGraph& g, const APSPResult& r, int u, int v)
+{
+    std::vector<int> path = r.reconstructPath(u, v);
+    if (r.distance(u, v) == APSPResult::INF)
+        return path.empty();
+    if (path.empty() || path.front() != u || path.back() != v)
+        return false;
+    long long length = 0;
+    for (std::size_t i = 0; i + 1 < path.size(); i++)
+    {
+        int lightest = APSPResult::INF;
+        for (std::int64_t e = g.edgeBegin(path[i]); e < g.edgeEnd(path[i]); e++)
+        {
+            if (g.target(e) == path[i + 1])
+                lightest = std::min(lightest, g.weight(e));
+        }
+        if (lightest == APSPResult::INF)
+            return false;
+        length += lightest;
+    }
+    return length == r.distance(u, v);
+}
+
+bool pathsMatch(const CSRGraph& g, const APSPResult& r)
+{
+    const int V = g.vertexCount();
+    const int step = std::max(1, V / PATH_CHECK_SOURCES);
+    for (int u = 0; u < V; u += step)
+    {
+        for (int v = 0; v < V; v++)
+        {
+            if (!pathMatches(g, r, u, v))
+                return false;
+        }
+    }
+    return true;
+}
+
+double runMs(const CSRGraph& g, ThreadPool& pool, APSPMethod method, APSPResult& out)
+{
+    auto start = std::chrono::steady_clock::now();
+    out = parallelAPSP(g, pool, method);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void benchmarkGraph(const std::string& name, const CSRGraph& g, const std::vector<int>& threadCounts)
+{
+    const double V = g.vertexCount();
+    std::cout << "\n" << name << ": V = " << g.vertexCount() << ", E = " << g.edgeCount()
+              << ", E/V² = " << std::fixed << std::setprecision(3) << g.edgeCount() / (V * V)
+              << ", Auto выбирает: " << (preferDijkstraAPSP(g) ? "Дейкстру" : "Флойда-Уоршелла") << std::endl;
+    std::cout << alignLeft("Потоки", 10) << alignRight("FW, мс", 14) << alignRight("ускор.", 10)
+              << alignRight("Dijkstra, мс", 16) << alignRight("ускор.", 10) << std::endl;
+
+    double fwBase = 0, djBase = 0;
+    for (int threads : threadCounts)
+    {
+        ThreadPool pool(threads);
+        APSPResult fw, dj;
+        double fwMs = runMs(g, pool, APSPMethod::FloydWarshall, fw);
+        double djMs = runMs(g, pool, APSPMethod::Dijkstra, dj);
+        if (threads == threadCounts.front())
+        {
+            fwBase = fwMs;
+            djBase = djMs;
+        }
+
+        std::cout << std::left << std::setw(10) << threads << std::right << std::fixed
+                  << std::setw(14) << std::setprecision(1) << fwMs
+                  << std::setw(9) << std::setprecision(2) << fwBase / fwMs << "x"
+                  << std::setw(16) << std::setprecision(1) << djMs
+                  << std::setw(9) << std::setprecision(2) << djBase / djMs << "x"
+                  << (fw.dist == dj.dist ? "   ✓" : "   ✗ РАСХОЖДЕНИЕ")
+                  << (pathsMatch(g, fw) && pathsMatch(g, dj) ? " пути ✓" : " пути ✗") << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int V = (argc > 1) ? std::atoi(argv[1]) : 1024;
+    int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    std::vector<int> threadCounts;
+    for (int t = 1; t < cores; t *= 2)
+    {
+        threadCounts.push_back(t);
+    }
+    threadCounts.push_back(cores);
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  ПАРАЛЛЕЛЬНЫЙ APSP (ядер: " << cores << ")" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    std::mt19937 rng(2024);
+    benchmarkGraph("Плотный граф", makeDenseGraph(V, 0.2, rng), threadCounts);
+    benchmarkGraph("Разреженный граф", makeRandomGraph(2 * V, 16LL * V, 1, 1000, rng), threadCounts);
+    benchmarkGraph("Разреженный граф, веса 0..3", makeRandomGraph(2 * V, 16LL * V, 0, 3, rng), threadCounts);
+    return 0;
+}
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// ========================================================================
+// БЛОЧНЫЙ (ТАЙЛОВЫЙ) АЛГОРИТМ ФЛОЙДА-УОРШЕЛЛА
+// ========================================================================
+// Учебная версия (simple_floyd_warshall.cxx) хранит матрицы как
+// vector<vector<int>> и на каждой итерации k проходит ВСЮ матрицу V x V.
+// При V = 4096 матрица занимает 64 МБ и не помещается ни в один кэш:
+// каждая итерация k заново читает всю матрицу из памяти.
+//
+// Блочная версия:
+// 1. Одна непрерывная матрица row-major: dist[i * stride + j]
+// 2. Матрица разбита на тайлы B x B (B = 64 => 16 КБ на тайл).
+//    Для блока kb (вершины kb*B ... kb*B + B - 1) выполняются три фазы:
+//
+//      Фаза 1: диагональный тайл (kb, kb) обновляется сам через себя
+//      Фаза 2: тайлы строки kb и столбца kb обновляются через диагональный
+//      Фаза 3: все остальные тайлы (i, j) через (i, kb) и (kb, j)
+//
+//        kb
+//    +--+--+--+
+//    |3 |2 |3 |
+//    +--+--+--+
+// kb |2 |1 |2 |
+//    +--+--+--+
+//    |3 |2 |3 |
+//    +--+--+--+
+//
+//    Внутри тайла все B итераций k работают с тремя тайлами по 16 КБ,
+//    которые целиком лежат в L1/L2.
+// 3. Внутренний цикл по j без ветвлений: min и выбор next делаются
+//    через сравнение и смешивание (blend), что векторизуется - вручную
+//    через AVX2 (если компилятор собирает с -mavx2 / -march=native)
+//    или автоматически в скалярной версии.
+//
+// Восстановление путей сохранено: матрица next обновляется в том же
+// ядре (next[i][j] = next[i][k] при улучшении), как в учебной версии.
+// Переход по next корректен, пока в графе нет циклов нулевого веса: на
+// таком цикле порядок тайлов может оставить следующие вершины, которые
+// указывают друг на друга. Тогда reconstructPath бросает
+// std::logic_error, а пути строит parallel_apsp.h по тугим рёбрам.
+// ========================================================================
+
+class BlockedFloydWarshall
+{
+public:
+    static constexpr int INF = INT_MAX / 2; // "Бесконечность" как в учебной версии
+
+private:
+    int numVertices;  // Количество вершин
+    int blockSize;    // Размер тайла B (кратен 8 для AVX2)
+    int stride;       // Длина строки матрицы (V, округлённое вверх до B)
+    std::vector<int> dist; // Матрица расстояний stride x stride
+    std::vector<int> next; // Матрица для восстановления путей
+
+    // --------------------------------------------------------------------
+    // Ядро min-plus для одной строки тайла:
+    //   для j в [0, width): если dik + dkj[j] < dij[j], то
+    //       dij[j] = dik + dkj[j], nij[j] = nik
+    // Сумма с INF в dkj даёт INF (а не INF + отрицательный вес).
+    // --------------------------------------------------------------------
+    static void relaxRow(int* dij, int* nij, const int* dkj, int dik, int nik, int width)
+    {
+        int j = 0;
+#if defined(__AVX2__)
+        const __m256i vInf = _mm256_set1_epi32(INF);
+        const __m256i vDik = _mm256_set1_epi32(dik);
+        const __m256i vNik = _mm256_set1_epi32(nik);
+        for (; j + 8 <= width; j += 8)
+        {
+            __m256i vDkj = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dkj + j));
+            __m256i vDij = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dij + j));
+            __m256i vNij = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nij + j));
+
+            __m256i kjInf = _mm256_cmpeq_epi32(vDkj, vInf);
+            __m256i sum = _mm256_blendv_epi8(_mm256_add_epi32(vDik, vDkj), vInf, kjInf);
+            __m256i better = _mm256_cmpgt_epi32(vDij, sum);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dij + j), _mm256_min_epi32(vDij, sum));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(nij + j), _mm256_blendv_epi8(vNij, vNik, better));
+        }
+#endif
+        // Скалярная версия (и хвост после AVX2): выбор через битовые маски
+        // вместо if, чтобы компилятор мог превратить цикл в векторные min/blend
+        for (; j < width; j++)
+        {
+            int kj = dkj[j];
+            int d = dij[j];
+            int infMask = -static_cast<int>(kj == INF);           // Все биты 1, если dkj == INF
+            int sum = ((dik + kj) & ~infMask) | (INF & infMask);
+            int betterMask = -static_cast<int>(sum < d);          // Все биты 1 при улучшении
+            dij[j] = (sum & betterMask) | (d & ~betterMask);
+            nij[j] = (nik & betterMask) | (nij[j] & ~betterMask);
+        }
+    }
+
+    // Обновление тайла C (строки ci.., столбцы cj..) через вершины k
+    // блока kb: C[i][j] = min(C[i][j], A[i][k] + B[k][j]).
+    // Тайл может совпадать с A или B (фазы 1 и 2) - порядок "k снаружи"
+    // сохраняет корректность, как в обычном Флойде-Уоршелле.
+    void updateTile(int ci, int cj, int kb)
+    {
+        const int k0 = kb * blockSize;
+        for (int k = k0; k < k0 + blockSize; k++)
+        {
+            const int* rowK = &dist[static_cast<std::size_t>(k) * stride + cj];
+            for (int i = ci; i < ci + blockSize; i++)
+            {
+                std::size_t rowI = static_cast<std::size_t>(i) * stride;
+                int dik = dist[rowI + k];
+                if (dik == INF)
+                    continue; // Весь ряд не улучшится - проверка вынесена из цикла по j
+                relaxRow(&dist[rowI + cj], &next[rowI + cj], rowK, dik, next[rowI + k], blockSize);
+            }
+        }
+    }
+
+    int blockCount() const { return stride / blockSize; }
+
+public:
+    BlockedFloydWarshall(int V, int block = 64) : numVertices(V), blockSize(block)
+    {
+        if (block <= 0 || block % 8 != 0)
+            throw std::invalid_argument("Размер тайла должен быть положительным и кратным 8");
+
+        stride = (V + blockSize - 1) / blockSize * blockSize;
+        if (stride == 0)
+            stride = blockSize;
+
+        dist.assign(static_cast<std::size_t>(stride) * stride, INF);
+        next.assign(static_cast<std::size_t>(stride) * stride, -1);
+
+        // Расстояние от вершины до самой себя равно 0 (включая фиктивные
+        // вершины выравнивания: они ни с чем не связаны и не влияют на ответ)
+        for (int i = 0; i < stride; i++)
+        {
+            dist[static_cast<std::size_t>(i) * stride + i] = 0;
+            next[static_cast<std::size_t>(i) * stride + i] = i;
+        }
+    }
+
+    // Добавление взвешенного ребра от вершины u к вершине v
+    void addEdge(int u, int v, int weight)
+    {
+        dist[static_cast<std::size_t>(u) * stride + v] = weight;
+        next[static_cast<std::size_t>(u) * stride + v] = v;
+    }
+
+    // Фаза 1 для блока kb
+    void runPhase1(int kb)
+    {
+        updateTile(kb * blockSize, kb * blockSize, kb);
+    }
+
+    // Фаза 2, тайл t строки/столбца kb (t != kb)
+    void runPhase2Tile(int kb, int t)
+    {
+        updateTile(kb * blockSize, t * blockSize, kb); // Строка kb
+        updateTile(t * blockSize, kb * blockSize, kb); // Столбец kb
+    }
+
+    // Фаза 3, тайл (bi, bj), bi != kb и bj != kb
+    void runPhase3Tile(int kb, int bi, int bj)
+    {
+        updateTile(bi * blockSize, bj * blockSize, kb);
+    }
+
+    // Последовательный запуск всех трёх фаз для всех блоков
+    void run()
+    {
+        const int nb = blockCount();
+        for (int kb = 0; kb < nb; kb++)
+        {
+            runPhase1(kb);
+            for (int t = 0; t < nb; t++)
+            {
+                if (t != kb)
+                    runPhase2Tile(kb, t);
+            }
+            for (int bi = 0; bi < nb; bi++)
+            {
+                if (bi == kb)
+                    continue;
+                for (int bj = 0; bj < nb; bj++)
+                {
+                    if (bj != kb)
+                        runPhase3Tile(kb, bi, bj);
+                }
+            }
+        }
+    }
+
+    int vertexCount() const { return numVertices; }
+    int tileSize() const { return blockSize; }
+    int tilesPerSide() const { return blockCount(); }
+
+    int distance(int u, int v) const
+    {
+        return dist[static_cast<std::size_t>(u) * stride + v];
+    }
+
+    // Следующая вершина на кратчайшем пути u -> v (-1 = пути нет)
+    int nextHop(int u, int v) const
+    {
+        return next[static_cast<std::size_t>(u) * stride + v];
+    }
+
+    // Восстановление пути между двумя вершинами (как в учебной версии)
+    std::vector<int> reconstructPath(int u, int v) const
+    {
+        std::vector<int> path;
+        if (next[static_cast<std::size_t>(u) * stride + v] == -1)
+            return path; // Пути нет
+
+        path.push_back(u);
+        while (u != v)
+        {
+            // Простой путь - не больше V вершин, иначе next зациклился
+            if (path.size() > static_cast<std::size_t>(numVertices))
+                throw std::logic_error("BlockedFloydWarshall: цикл в next (цикл нулевого веса)");
+            u = next[static_cast<std::size_t>(u) * stride + v];
+            path.push_back(u);
+        }
+        return path;
+    }
+
+    bool hasNegativeCycle() const
+    {
+        for (int i = 0; i < numVertices; i++)
+        {
+            if (distance(i, i) < 0)
+                return true;
+        }
+        return false;
+    }
+};
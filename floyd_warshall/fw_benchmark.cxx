@@ -0,0 +1,140 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "blocked_floyd_warshall.h"
+
+// ========================================================================
+// СРАВНЕНИЕ: учебный Флойд-Уоршелл vs блочный
+// ========================================================================
+// Случайный ориентированный граф с плотностью ~10% и весами [1, 1000].
+// Учебная версия - тот же тройной цикл, что и Graph::floydWarshall
+// в simple_floyd_warshall.cxx, но без вывода.
+//
+// Запуск: ./fw_benchmark [V] [B] (по умолчанию V = 1024, B = 64)
+// ========================================================================
+
+const int INF = INT_MAX / 2;
+
+struct RandomEdge
+{
+    int u, v, w;
+};
+
+void naiveFloydWarshall(std::vector<std::vector<int>>& dist, std::vector<std::vector<int>>& next)
+{
+    int n = static_cast<int>(dist.size());
+    for (int k = 0; k < n; k++)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                if (dist[i][k] != INF && dist[k][j] != INF && dist[i][k] + dist[k][j] < dist[i][j])
+                {
+                    dist[i][j] = dist[i][k] + dist[k][j];
+                    next[i][j] = next[i][k];
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int V = (argc > 1) ? std::atoi(argv[1]) : 1024;
+    int B = (argc > 2) ? std::atoi(argv[2]) : 64;
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  ФЛОЙД-УОРШЕЛЛ: учебный vs блочный" << std::endl;
+    std::cout << "========================================" << std::endl;
+#if defined(__AVX2__)
+    std::cout << "Ядро: AVX2" << std::endl;
+#else
+    std::cout << "Ядро: скалярное (соберите с -march=native для AVX2)" << std::endl;
+#endif
+
+    std::mt19937 rng(123);
+    std::uniform_int_distribution<int> vertexDist(0, V - 1);
+    std::uniform_int_distribution<int> weightDist(1, 1000);
+    std::vector<RandomEdge> edges;
+    for (long long i = 0; i < static_cast<long long>(V) * V / 10; i++)
+    {
+        edges.push_back({vertexDist(rng), vertexDist(rng), weightDist(rng)});
+    }
+    std::cout << "V = " << V << ", E = " << edges.size() << ", тайл " << B << "x" << B << std::endl;
+
+    std::vector<std::vector<int>> dist(V, std::vector<int>(V, INF));
+    std::vector<std::vector<int>> weight(V, std::vector<int>(V, INF)); // Исходные рёбра
+    std::vector<std::vector<int>> next(V, std::vector<int>(V, -1));
+    for (int i = 0; i < V; i++)
+    {
+        dist[i][i] = 0;
+        next[i][i] = i;
+    }
+    BlockedFloydWarshall blocked(V, B);
+    for (const RandomEdge& e : edges)
+    {
+        if (e.u == e.v)
+            continue;
+        dist[e.u][e.v] = e.w;
+        weight[e.u][e.v] = e.w;
+        next[e.u][e.v] = e.v;
+        blocked.addEdge(e.u, e.v, e.w);
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    naiveFloydWarshall(dist, next);
+    auto t1 = std::chrono::steady_clock::now();
+    blocked.run();
+    auto t2 = std::chrono::steady_clock::now();
+
+    double naiveMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    double blockedMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+
+    // Проверка: совпадение расстояний и корректность восстановленных путей
+    bool same = true;
+    for (int i = 0; i < V && same; i++)
+    {
+        for (int j = 0; j < V; j++)
+        {
+            if (dist[i][j] != blocked.distance(i, j))
+            {
+                same = false;
+                break;
+            }
+        }
+    }
+
+    bool pathsOk = true;
+    for (int s = 0; s < 200 && pathsOk; s++)
+    {
+        int u = vertexDist(rng), v = vertexDist(rng);
+        std::vector<int> path = blocked.reconstructPath(u, v);
+        if (blocked.distance(u, v) == BlockedFloydWarshall::INF)
+        {
+            pathsOk = path.empty();
+            continue;
+        }
+        // Каждый шаг пути должен быть ребром графа, а сумма весов - равна расстоянию
+        long long length = 0;
+        for (std::size_t p = 0; p + 1 < path.size() && pathsOk; p++)
+        {
+            int w = weight[path[p]][path[p + 1]];
+            pathsOk = w != INF;
+            length += w;
+        }
+        pathsOk = pathsOk && length == blocked.distance(u, v) && path.front() == u && path.back() == v;
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Учебный: " << naiveMs << " мс" << std::endl;
+    std::cout << "Блочный: " << blockedMs << " мс (ускорение " << std::setprecision(2)
+              << naiveMs / blockedMs << "x)" << std::endl;
+    std::cout << "Расстояния совпадают: " << (same ? "✓" : "✗") << std::endl;
+    std::cout << "Пути корректны:       " << (pathsOk ? "✓" : "✗") << std::endl;
+    return (same && pathsOk) ? 0 : 1;
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "blocked_floyd_warshall.h"
+#include "../graph_common/csr_graph.h"
+#include "../graph_common/indexed_heap.h"
+#include "../graph_common/thread_pool.h"
+
+// ========================================================================
+// ПАРАЛЛЕЛЬНЫЙ ПОИСК КРАТЧАЙШИХ ПУТЕЙ МЕЖДУ ВСЕМИ ПАРАМИ (APSP)
+// ========================================================================
+// Два способа, выбираемые по плотности графа:
+//
+// 1. Параллельный блочный Флойд-Уоршелл - O(V³), не зависит от E.
+//    Внутри итерации блока kb фазы зависят друг от друга, но тайлы
+//    ВНУТРИ фазы независимы:
+//      Фаза 1: один диагональный тайл - последовательно
+//      Фаза 2: (nb - 1) тайлов строки и столбца - параллельно
+//      Фаза 3: (nb - 1)² остальных тайлов - параллельно
+//    Между фазами - барьер (конец parallelFor).
+//
+// 2. Дейкстра из каждой вершины - O(V · E log V). Запуски из разных
+//    источников полностью независимы, поэтому параллелятся идеально:
+//    каждый поток берёт очередной источник и заполняет свою строку
+//    матрицы. Работает только с неотрицательными весами.
+//
+// Для разреженных графов (E << V²) второй способ быстрее на порядки,
+// для плотных - первый (векторизованное ядро и отсутствие кучи).
+// ========================================================================
+
+// Матрица расстояний и матрица путей, V x V, row-major. Флойд-Уоршелл на
+// положительных весах заполняет next, иначе заполняется prev: строка u -
+// дерево кратчайших путей из u, путь u -> v восстанавливается назад только
+// по строке u. Переход по следующим вершинам чужих строк корректен лишь
+// без циклов нулевого веса: на таком цикле следующие вершины соседних
+// строк могут указывать друг на друга, и путь зацикливается
+struct APSPResult
+{
+    static constexpr int INF = BlockedFloydWarshall::INF;
+
+    int numVertices = 0;
+    std::vector<int> dist; // dist[u * V + v], INF = недостижима
+    std::vector<int> next; // Следующая вершина на пути u -> v, -1 = пути нет
+    std::vector<int> prev; // Предыдущая вершина на пути u -> v, -1 = пути нет
+
+    int distance(int u, int v) const
+    {
+        return dist[static_cast<std::size_t>(u) * numVertices + v];
+    }
+
+    std::vector<int> reconstructPath(int u, int v) const
+    {
+        std::vector<int> path;
+        if (!prev.empty())
+        {
+            // Назад от v по дереву источника u
+            const int* row = &prev[static_cast<std::size_t>(u) * numVertices];
+            if (row[v] == -1)
+                return path;
+            for (int x = v; x != u; x = row[x])
+                path.push_back(x);
+            path.push_back(u);
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+        if (next[static_cast<std::size_t>(u) * numVertices + v] == -1)
+            return path;
+        path.push_back(u);
+        while (u != v)
+        {
+            u = next[static_cast<std::size_t>(u) * numVertices + v];
+            path.push_back(u);
+        }
+        return path;
+    }
+};
+
+enum class APSPMethod
+{
+    FloydWarshall,
+    Dijkstra,
+    Auto
+};
+
+// Параллельный запуск блочного Флойда-Уоршелла (см. фазы выше)
+inline void parallelFloydWarshall(BlockedFloydWarshall& fw, ThreadPool& pool)
+{
+    const int nb = fw.tilesPerSide();
+    for (int kb = 0; kb < nb; kb++)
+    {
+        fw.runPhase1(kb);
+
+        pool.parallelFor(0, nb, [&](std::int64_t t) {
+            if (t != kb)
+                fw.runPhase2Tile(kb, static_cast<int>(t));
+        });
+
+        pool.parallelFor(0, static_cast<std::int64_t>(nb) * nb, [&](std::int64_t tile) {
+            int bi = static_cast<int>(tile / nb);
+            int bj = static_cast<int>(tile % nb);
+            if (bi != kb && bj != kb)
+                fw.runPhase3Tile(kb, bi, bj);
+        });
+    }
+}
+
+// Дейкстра из источника s, результат пишется прямо в строку матрицы.
+// prev[v] - вершина, через которую пришло последнее улучшение dist[v]
+inline void dijkstraRow(const CSRGraph& g, int s, IndexedDaryHeap<4>& heap, int* dist, int* prev)
+{
+    dist[s] = 0;
+    prev[s] = s;
+    heap.push(s, 0);
+
+    while (!heap.empty())
+    {
+        int u = heap.pop();
+        int distU = dist[u];
+        for (std::int64_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++)
+        {
+            int v = g.target(e);
+            int newDist = distU + g.weight(e);
+            if (newDist < dist[v])
+            {
+                if (dist[v] == APSPResult::INF)
+                    heap.push(v, newDist);
+                else
+                    heap.decreaseKey(v, newDist);
+                dist[v] = newDist;
+                prev[v] = u;
+            }
+        }
+    }
+}
+
+// Дерево кратчайших путей из s по готовой строке расстояний: ребро
+// x -> y "тугое", если dist[x] + w = dist[y], и каждый кратчайший путь
+// состоит из тугих рёбер. Обход в ширину по ним даёт каждой достижимой
+// вершине ровно одного предшественника - без циклов и при нулевых весах
+inline void shortestPathTreeRow(const CSRGraph& g, int s, const int* dist, int* prev, std::vector<int>& queue)
+{
+    queue.clear();
+    queue.push_back(s);
+    prev[s] = s;
+    for (std::size_t head = 0; head < queue.size(); head++)
+    {
+        int x = queue[head];
+        for (std::int64_t e = g.edgeBegin(x); e < g.edgeEnd(x); e++)
+        {
+            int y = g.target(e);
+            if (prev[y] == -1 && dist[x] + g.weight(e) == dist[y])
+            {
+                prev[y] = x;
+                queue.push_back(y);
+            }
+        }
+    }
+}
+
+// Все веса > 0: циклов нулевого веса нет, и next Флойда-Уоршелла годится
+inline bool hasPositiveWeightsOnly(const CSRGraph& g)
+{
+    const int* w = g.weightData();
+    for (std::int64_t e = 0; e < g.edgeCount(); e++)
+    {
+        if (w[e] <= 0)
+            return false;
+    }
+    return true;
+}
+
+inline bool hasNegativeWeights(const CSRGraph& g)
+{
+    const int* w = g.weightData();
+    for (std::int64_t e = 0; e < g.edgeCount(); e++)
+    {
+        if (w[e] < 0)
+            return true;
+    }
+    return false;
+}
+
+// Порог плотности E / V² для режима Auto. Грубая оценка стоимости:
+// Дейкстра - около V · E релаксаций (~2-3 нс каждая, случайный доступ),
+// Флойд-Уоршелл - V³ векторизованных операций (~0.3-0.6 нс). Равенство
+// даёт E / V² ≈ 0.1-0.2; берём нижнюю границу, так как на малых V
+// матрица Флойда-Уоршелла ещё помещается в кэш.
+const double APSP_DIJKSTRA_MAX_DENSITY = 0.1;
+
+inline bool preferDijkstraAPSP(const CSRGraph& g)
+{
+    const double V = g.vertexCount();
+    if (V < 2 || hasNegativeWeights(g))
+        return false;
+    double density = static_cast<double>(g.edgeCount()) / (V * V);
+    return density < APSP_DIJKSTRA_MAX_DENSITY;
+}
+
+inline APSPResult parallelAPSP(const CSRGraph& g, ThreadPool& pool, APSPMethod method = APSPMethod::Auto)
+{
+    const int V = g.vertexCount();
+    APSPResult result;
+    result.numVertices = V;
+
+    if (method == APSPMethod::Auto)
+        method = preferDijkstraAPSP(g) ? APSPMethod::Dijkstra : APSPMethod::FloydWarshall;
+
+    if (method == APSPMethod::Dijkstra)
+    {
+        if (hasNegativeWeights(g))
+            throw std::invalid_argument("APSP Дейкстрой: отрицательный вес ребра");
+
+        result.dist.assign(static_cast<std::size_t>(V) * V, APSPResult::INF);
+        result.prev.assign(static_cast<std::size_t>(V) * V, -1);
+
+        // Своя куча у каждого потока: после запуска она пуста и переиспользуется
+        std::vector<IndexedDaryHeap<4>> heaps(pool.threadCount(), IndexedDaryHeap<4>(V));
+        pool.parallelFor(0, V, [&](std::int64_t s) {
+            std::size_t row = static_cast<std::size_t>(s) * V;
+            dijkstraRow(g, static_cast<int>(s), heaps[pool.currentThreadIndex()],
+                        &result.dist[row], &result.prev[row]);
+        });
+        return result;
+    }
+
+    // Флойд-Уоршелл: из кратных рёбер оставляем самое лёгкое
+    BlockedFloydWarshall fw(V);
+    for (int u = 0; u < V; u++)
+    {
+        for (std::int64_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++)
+        {
+            if (g.weight(e) < fw.distance(u, g.target(e)))
+                fw.addEdge(u, g.target(e), g.weight(e));
+        }
+    }
+    parallelFloydWarshall(fw, pool);
+
+    result.dist.resize(static_cast<std::size_t>(V) * V);
+    const bool useNext = hasPositiveWeightsOnly(g);
+    if (useNext)
+        result.next.resize(static_cast<std::size_t>(V) * V);
+    pool.parallelFor(0, V, [&](std::int64_t u) {
+        for (int v = 0; v < V; v++)
+        {
+            std::size_t idx = static_cast<std::size_t>(u) * V + v;
+            result.dist[idx] = fw.distance(static_cast<int>(u), v);
+            if (useNext)
+                result.next[idx] = fw.nextHop(static_cast<int>(u), v);
+        }
+    });
+    if (useNext)
+        return result;
+
+    // Нулевые или отрицательные веса: пути - деревьями по тугим рёбрам, O(V · E)
+    result.prev.assign(static_cast<std::size_t>(V) * V, -1);
+    std::vector<std::vector<int>> queues(pool.threadCount());
+    pool.parallelFor(0, V, [&](std::int64_t u) {
+        std::size_t row = static_cast<std::size_t>(u) * V;
+        shortestPathTreeRow(g, static_cast<int>(u), &result.dist[row], &result.prev[row],
+                            queues[pool.currentThreadIndex()]);
+    });
+    return result;
+}
@@ -3,13 +3,16 @@
 #include <iomanip>
 #include <climits>
 
+#include "../common/trace.h"
+
 // Класс для представления взвешенного графа
+template <typename Trace = NoTrace>
 class Graph
 {
     int numVertices;                              // Количество вершин
     std::vector<std::vector<int>> dist;          // Матрица расстояний
     std::vector<std::vector<int>> next;          // Матрица для восстановления путей
-    bool verbose;                                  // Режим детального вывода
+    Trace verbose;                                 // Режим детального вывода
 
 public:
     // Конструктор: создаем граф с заданным количеством вершин
@@ -228,7 +231,7 @@ int main()
     //     |        |
     //     V        V
     //     2 --2--> 3
-    Graph g1(4, false);
+    Graph<> g1(4, false);
     g1.addEdge(0, 1, 4);
     g1.addEdge(0, 2, 2);
     g1.addEdge(1, 3, 1);
@@ -239,7 +242,7 @@ int main()
     std::cout << "  ТЕСТ 2: Граф с несколькими путями" << std::endl;
     std::cout << "========================================" << std::endl;
     // Тест 2: Граф с несколькими путями
-    Graph g2(4, false);
+    Graph<> g2(4, false);
     g2.addEdge(0, 1, 3);
     g2.addEdge(0, 3, 7);
     g2.addEdge(1, 0, 8);
@@ -254,7 +257,7 @@ int main()
     std::cout << "  ТЕСТ 3: Полный граф (без детального вывода)" << std::endl;
     std::cout << "========================================" << std::endl;
     // Тест 3: Полный граф
-    Graph g3(5, false);
+    Graph<> g3(5, false);
     g3.addEdge(0, 1, 10);
     g3.addEdge(0, 2, 5);
     g3.addEdge(1, 2, 2);
@@ -271,7 +274,7 @@ int main()
     std::cout << "  ТЕСТ 4: Граф с отрицательными весами" << std::endl;
     std::cout << "========================================" << std::endl;
     // Тест 4: Граф с отрицательными весами (но без отрицательных циклов)
-    Graph g4(4, false);
+    Graph<> g4(4, false);
     g4.addEdge(0, 1, 2);
     g4.addEdge(1, 2, -3);  // Отрицательный вес
     g4.addEdge(2, 3, 2);
@@ -285,7 +288,7 @@ int main()
     // Цикл: 0 -> 1 -> 2 -> 0 с суммой весов: 1 + (-3) + (-2) = -4
     std::cout << "Граф содержит цикл: 0 -> 1 -> 2 -> 0" << std::endl;
     std::cout << "Сумма весов: 1 + (-3) + (-2) = -4 (отрицательный цикл!)" << std::endl;
-    Graph g5(3, false);
+    Graph<> g5(3, false);
     g5.addEdge(0, 1, 1);
     g5.addEdge(1, 2, -3);
     g5.addEdge(2, 0, -2);  // Замыкает отрицательный цикл
@@ -300,7 +303,7 @@ int main()
     std::cout << "Граф состоит из двух несвязных компонент:" << std::endl;
     std::cout << "Компонента 1: 0 <-> 1" << std::endl;
     std::cout << "Компонента 2: 2 <-> 3" << std::endl;
-    Graph g6(4, false);
+    Graph<> g6(4, false);
     g6.addEdge(0, 1, 2);
     g6.addEdge(1, 0, 2);
     g6.addEdge(2, 3, 5);
@@ -317,7 +320,7 @@ int main()
     //     5 |1 2
     //       3
     std::cout << "Все вершины соединены только с центральной вершиной 0" << std::endl;
-    Graph g7(5, false);
+    Graph<> g7(5, false);
     g7.addEdge(0, 1, 3);
     g7.addEdge(0, 2, 5);
     g7.addEdge(0, 3, 1);
@@ -331,7 +334,7 @@ int main()
     // Показывает минимальное количество шагов между вершинами
     std::cout << "Все рёбра имеют вес 1 (как в невзвешенном графе)" << std::endl;
     std::cout << "Результат показывает минимальное количество рёбер в пути" << std::endl;
-    Graph g8(5, false);
+    Graph<> g8(5, false);
     g8.addEdge(0, 1, 1);
     g8.addEdge(1, 2, 1);
     g8.addEdge(2, 3, 1);
@@ -346,7 +349,7 @@ int main()
     // Прямой путь 0->2 длиннее, чем 0->1->2
     std::cout << "Прямой путь 0->2 (вес 10) длиннее, чем 0->1->2 (вес 2+3=5)" << std::endl;
     std::cout << "Алгоритм найдёт более короткий путь через вершину 1" << std::endl;
-    Graph g9(3, false);
+    Graph<> g9(3, false);
     g9.addEdge(0, 1, 2);
     g9.addEdge(1, 2, 3);
     g9.addEdge(0, 2, 10);  // Неэффективный прямой путь
@@ -364,7 +367,7 @@ int main()
     //1---4---2
     //     1
     std::cout << "Граф с симметричными рёбрами (неориентированный)" << std::endl;
-    Graph g10(4, false);
+    Graph<> g10(4, false);
     // Добавляем рёбра в обе стороны
     g10.addEdge(0, 1, 2);
     g10.addEdge(1, 0, 2);
@@ -384,7 +387,7 @@ int main()
     std::cout << "Длинная цепь: 0->1->2->3->4 (сумма 4)" << std::endl;
     std::cout << "Прямое ребро: 0->4 (вес 10)" << std::endl;
     std::cout << "Обратный путь: 4->0->1 короче чем 4->3->2->1" << std::endl;
-    Graph g11(5, false);
+    Graph<> g11(5, false);
     g11.addEdge(0, 1, 1);
     g11.addEdge(1, 2, 1);
     g11.addEdge(2, 3, 1);
@@ -400,7 +403,7 @@ int main()
     // Тест 12: Плотный граф с множеством рёбер
     std::cout << "Граф с большим количеством рёбер - показывает эффективность" << std::endl;
     std::cout << "для плотных графов (без детального вывода)" << std::endl;
-    Graph g12(6, false);
+    Graph<> g12(6, false);
     // Добавляем много рёбер с различными весами
     g12.addEdge(0, 1, 7);
     g12.addEdge(0, 2, 9);
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+// ========================================================================
+// КОНКУРЕНТНЫЙ UNION-FIND (Anderson, Woll)
+// ========================================================================
+// UnionFind из simple_kruskal.cxx / simple_boruvka.cxx нельзя вызывать из
+// нескольких потоков: рекурсивное сжатие путей и union by rank пишут
+// в общие массивы без синхронизации.
+//
+// Здесь parent[] - массив атомиков, и каждая запись - одна CAS:
+//
+//   find(x)    - подъём к корню с ПОЛОВИНЕНИЕМ пути: parent[x] заменяется
+//                на дедушку через CAS. Неудачная CAS не страшна - значит,
+//                другой поток уже поднял x выше. Ни одного цикла ожидания:
+//                каждый шаг приближает к корню (wait-free).
+//   unite(x,y) - находим корни rx < ry и подвешиваем rx под ry одной CAS
+//                (parent[rx]: rx -> ry). Если CAS не прошла, rx перестал
+//                быть корнем - кто-то другой успел его присоединить;
+//                повторяем с новыми корнями (lock-free).
+//
+// Подвешивание всегда "меньший индекс под больший", поэтому родитель любой
+// вершины имеет больший номер, и циклов в лесе не бывает ни при каком
+// чередовании потоков.
+// ========================================================================
+
+class ConcurrentUnionFind
+{
+    std::vector<std::atomic<int>> parent;
+
+public:
+    explicit ConcurrentUnionFind(int n) : parent(n)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            parent[i].store(i, std::memory_order_relaxed);
+        }
+    }
+
+    int size() const { return static_cast<int>(parent.size()); }
+
+    // Снова сделать x отдельным множеством (для повторного использования
+    // структуры; вызывать, когда другие потоки с ней не работают)
+    void makeSet(int x) { parent[x].store(x, std::memory_order_relaxed); }
+
+    int find(int x)
+    {
+        while (true)
+        {
+            int p = parent[x].load(std::memory_order_acquire);
+            if (p == x)
+                return x;
+            int grandparent = parent[p].load(std::memory_order_acquire);
+            if (p != grandparent)
+            {
+                // Половинение пути: x -> дедушка (результат CAS не важен)
+                parent[x].compare_exchange_weak(p, grandparent, std::memory_order_acq_rel,
+                                                std::memory_order_relaxed);
+            }
+            x = grandparent;
+        }
+    }
+
+    // true - если множества были разными и этот вызов их объединил
+    bool unite(int x, int y)
+    {
+        while (true)
+        {
+            x = find(x);
+            y = find(y);
+            if (x == y)
+                return false;
+            if (x > y)
+                std::swap(x, y);
+            int expected = x;
+            if (parent[x].compare_exchange_strong(expected, y, std::memory_order_acq_rel,
+                                                  std::memory_order_relaxed))
+                return true;
+        }
+    }
+
+    bool same(int x, int y)
+    {
+        while (true)
+        {
+            x = find(x);
+            y = find(y);
+            if (x == y)
+                return true;
+            // x всё ещё корень => в момент проверки множества были разными
+            if (parent[x].load(std::memory_order_acquire) == x)
+                return false;
+        }
+    }
+};
@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "csr_graph.h"
+#include "text_columns.h"
+#include "../bfs/csr_bfs.h"
+#include "../dfs/csr_dfs.h"
+#include "../dijkstra/csr_dijkstra.h"
+#include "../prim/csr_prim.h"
+
+// ========================================================================
+// СРАВНЕНИЕ: список смежности vs CSR
+// ========================================================================
+// Генерируем "дорожный" граф: решётка W x H (каждая вершина связана с
+// соседями справа и снизу) плюс немного случайных дальних рёбер.
+// Затем запускаем BFS, DFS, Дейкстру и Прима на двух представлениях:
+//   1. std::vector<std::vector<Edge>> - как в simple_*.cxx
+//   2. CSRGraph                       - общий тип из graph_common/
+// и проверяем, что результаты совпадают.
+//
+// Запуск: ./csr_benchmark [сторона_решётки] (по умолчанию 1000 => 1M вершин)
+// ========================================================================
+
+struct Edge
+{
+    int destination; // Конечная вершина
+    int weight;      // Вес ребра
+};
+
+using AdjacencyList = std::vector<std::vector<Edge>>;
+
+// ---------- Эталонные реализации на списке смежности (без вывода) ----------
+
+std::vector<int> adjBFS(const AdjacencyList& adj, int start)
+{
+    std::vector<int> distance(adj.size(), -1);
+    std::queue<int> q;
+    distance[start] = 0;
+    q.push(start);
+    while (!q.empty())
+    {
+        int u = q.front();
+        q.pop();
+        for (const Edge& e : adj[u])
+        {
+            if (distance[e.destination] == -1)
+            {
+                distance[e.destination] = distance[u] + 1;
+                q.push(e.destination);
+            }
+        }
+    }
+    return distance;
+}
+
+std::vector<int> adjDFS(const AdjacencyList& adj, int start)
+{
+    std::vector<bool> visited(adj.size(), false);
+    std::vector<int> stack;
+    std::vector<int> order;
+    visited[start] = true;
+    stack.push_back(start);
+    while (!stack.empty())
+    {
+        int u = stack.back();
+        stack.pop_back();
+        order.push_back(u);
+        for (int i = static_cast<int>(adj[u].size()) - 1; i >= 0; i--)
+        {
+            int v = adj[u][i].destination;
+            if (!visited[v])
+            {
+                visited[v] = true;
+                stack.push_back(v);
+            }
+        }
+    }
+    return order;
+}
+
+std::vector<int> adjDijkstra(const AdjacencyList& adj, int start)
+{
+    std::vector<int> distance(adj.size(), INT_MAX);
+    std::vector<bool> visited(adj.size(), false);
+    std::priority_queue<std::pair<int, int>,
+                        std::vector<std::pair<int, int>>,
+                        std::greater<std::pair<int, int>>> pq;
+    distance[start] = 0;
+    pq.push({0, start});
+    while (!pq.empty())
+    {
+        int u = pq.top().second;
+        pq.pop();
+        if (visited[u])
+            continue;
+        visited[u] = true;
+        for (const Edge& e : adj[u])
+        {
+            int v = e.destination;
+            if (!visited[v] && distance[u] + e.weight < distance[v])
+            {
+                distance[v] = distance[u] + e.weight;
+                pq.push({distance[v], v});
+            }
+        }
+    }
+    return distance;
+}
+
+long long adjPrim(const AdjacencyList& adj, int start)
+{
+    std::vector<int> key(adj.size(), INT_MAX);
+    std::vector<bool> inMST(adj.size(), false);
+    std::priority_queue<std::pair<int, int>,
+                        std::vector<std::pair<int, int>>,
+                        std::greater<std::pair<int, int>>> pq;
+    long long total = 0;
+    key[start] = 0;
+    pq.push({0, start});
+    while (!pq.empty())
+    {
+        int w = pq.top().first;
+        int u = pq.top().second;
+        pq.pop();
+        if (inMST[u])
+            continue;
+        inMST[u] = true;
+        total += w;
+        for (const Edge& e : adj[u])
+        {
+            if (!inMST[e.destination] && e.weight < key[e.destination])
+            {
+                key[e.destination] = e.weight;
+                pq.push({e.weight, e.destination});
+            }
+        }
+    }
+    return total;
+}
+
+// ---------- Генерация графа ----------
+
+std::vector<WeightedEdge> makeRoadLikeGraph(int side, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> weightDist(1, 100);
+    std::uniform_int_distribution<int> vertexDist(0, side * side - 1);
+    std::vector<WeightedEdge> edges;
+    edges.reserve(static_cast<std::size_t>(side) * side * 2 + side * side / 100);
+
+    for (int r = 0; r < side; r++)
+    {
+        for (int c = 0; c < side; c++)
+        {
+            int u = r * side + c;
+            if (c + 1 < side) edges.push_back({u, u + 1, weightDist(rng)});
+            if (r + 1 < side) edges.push_back({u, u + side, weightDist(rng)});
+        }
+    }
+    // ~1% "шоссе" между случайными точками
+    for (int i = 0; i < side * side / 100; i++)
+    {
+        edges.push_back({vertexDist(rng), vertexDist(rng), weightDist(rng) * 10});
+    }
+
+    // Перемешиваем, чтобы рёбра приходили в случайном порядке, как из файла
+    std::shuffle(edges.begin(), edges.end(), rng);
+    return edges;
+}
+
+template <typename Func>
+double measureMs(Func&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void printRow(const std::string& name, double adjMs, double csrMs, bool same)
+{
+    std::cout << alignLeft(name, 12)
+              << std::right << std::setw(14) << std::fixed << std::setprecision(2) << adjMs
+              << std::setw(14) << csrMs
+              << std::setw(10) << std::setprecision(2) << (adjMs / csrMs) << "x"
+              << (same ? "   ✓" : "   ✗ РЕЗУЛЬТАТЫ РАЗЛИЧАЮТСЯ") << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    int side = (argc > 1) ? std::atoi(argv[1]) : 1000;
+    int V = side * side;
+    std::mt19937 rng(42);
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  СРАВНЕНИЕ: список смежности vs CSR" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    std::vector<WeightedEdge> edges = makeRoadLikeGraph(side, rng);
+    std::cout << "Граф: решётка " << side << "x" << side << " + шоссе, V = " << V
+              << ", E = " << edges.size() << " (неориентированных)" << std::endl;
+
+    AdjacencyList adj;
+    double adjBuildMs = measureMs([&]() {
+        adj.assign(V, {});
+        for (const WeightedEdge& e : edges)
+        {
+            adj[e.source].push_back({e.destination, e.weight});
+            adj[e.destination].push_back({e.source, e.weight});
+        }
+    });
+
+    CSRGraph csr;
+    double csrBuildMs = measureMs([&]() { csr = CSRGraph::fromEdgeList(V, edges, true); });
+
+    std::cout << "Память CSR: " << csr.memoryBytes() / (1024 * 1024) << " МБ" << std::endl;
+    std::cout << "\n" << alignLeft("Алгоритм", 12) << alignRight("adj, мс", 14) << alignRight("CSR, мс", 14)
+              << "   ускорение" << std::endl;
+
+    printRow("Построение", adjBuildMs, csrBuildMs, true);
+
+    std::vector<int> a, b;
+    double t1 = measureMs([&]() { a = adjBFS(adj, 0); });
+    double t2 = measureMs([&]() { b = csrBFS(csr, 0).distance; });
+    printRow("BFS", t1, t2, a == b);
+
+    t1 = measureMs([&]() { a = adjDFS(adj, 0); });
+    t2 = measureMs([&]() { b = csrDFS(csr, 0); });
+    printRow("DFS", t1, t2, a == b);
+
+    t1 = measureMs([&]() { a = adjDijkstra(adj, 0); });
+    t2 = measureMs([&]() { b = csrDijkstra(csr, 0); });
+    printRow("Dijkstra", t1, t2, a == b);
+
+    long long w1 = 0, w2 = 0;
+    t1 = measureMs([&]() { w1 = adjPrim(adj, 0); });
+    t2 = measureMs([&]() { w2 = csrPrim(csr, 0).totalWeight; });
+    printRow("Prim", t1, t2, w1 == w2);
+
+    return 0;
+}
@@ -0,0 +1,281 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// ========================================================================
+// CSR-ГРАФ (Compressed Sparse Row)
+// ========================================================================
+// Учебные реализации (bfs/, dfs/, dijkstra/, prim/) хранят граф как
+// std::vector<std::vector<Edge>>: у каждой вершины свой маленький массив
+// в куче. На графах с миллионами вершин это тысячи разбросанных по памяти
+// блоков, и каждый переход к соседям - промах кэша.
+//
+// CSR хранит ВСЕ рёбра в трёх плотных массивах:
+//
+//   offsets[V + 1] - рёбра вершины u лежат в диапазоне [offsets[u], offsets[u + 1])
+//   targets[E]     - конечные вершины рёбер, подряд для каждой вершины
+//   weights[E]     - веса рёбер (параллельно targets)
+//
+// Пример: рёбра 0->1 (5), 0->2 (3), 2->1 (1)
+//   offsets = [0, 2, 2, 3]
+//   targets = [1, 2, 1]
+//   weights = [5, 3, 1]
+//
+// Граф неизменяем: его строят один раз через CSRGraphBuilder, после чего
+// все алгоритмы только читают массивы последовательно.
+//
+// Массивы либо принадлежат графу (std::vector), либо лежат во внешней
+// памяти - например, в файле, отображённом через mmap (graph_io.h).
+// Алгоритмы этого не различают: доступ всегда идёт через указатели.
+// ========================================================================
+
+// Ребро во входном списке рёбер (имена полей как в Edge учебных примеров)
+struct WeightedEdge
+{
+    int source;      // Начальная вершина
+    int destination; // Конечная вершина
+    int weight;      // Вес ребра
+};
+
+class CSRGraph
+{
+    int numVertices;                 // Количество вершин
+    std::vector<std::int64_t> offsets; // Начало списка рёбер каждой вершины (V + 1 элемент)
+    std::vector<int> targets;        // Конечные вершины всех рёбер
+    std::vector<int> weights;        // Веса всех рёбер
+
+    // Внешние массивы: владелец памяти (например, отображение файла)
+    // живёт, пока жива хотя бы одна копия графа
+    std::shared_ptr<const void> externalOwner;
+
+    // Через эти указатели идёт весь доступ (на свои векторы или внешнюю память)
+    const std::int64_t* offsetPtr = nullptr;
+    const int* targetPtr = nullptr;
+    const int* weightPtr = nullptr;
+
+    void bindOwnStorage()
+    {
+        offsetPtr = offsets.data();
+        targetPtr = targets.data();
+        weightPtr = weights.data();
+    }
+
+public:
+    // Диапазон соседей вершины: позволяет писать for (int v : g.neighbors(u))
+    class NeighborRange
+    {
+        const int* first;
+        const int* last;
+
+    public:
+        NeighborRange(const int* b, const int* e) : first(b), last(e) {}
+        const int* begin() const { return first; }
+        const int* end() const { return last; }
+        std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    };
+
+    CSRGraph() : numVertices(0), offsets(1, 0) { bindOwnStorage(); }
+
+    // Построение из готовых массивов (используется билдером)
+    CSRGraph(int V, std::vector<std::int64_t> offs, std::vector<int> tgts, std::vector<int> wts)
+        : numVertices(V), offsets(std::move(offs)), targets(std::move(tgts)), weights(std::move(wts))
+    {
+        if (static_cast<int>(offsets.size()) != V + 1 || targets.size() != weights.size() ||
+            offsets.back() != static_cast<std::int64_t>(targets.size()))
+        {
+            throw std::invalid_argument("CSRGraph: несогласованные размеры массивов");
+        }
+        bindOwnStorage();
+    }
+
+    // Граф поверх чужой памяти без копирования: offs[V + 1], tgts[E], wts[E].
+    // owner удерживает память (например, отображённый файл).
+    static CSRGraph fromExternal(int V, const std::int64_t* offs, const int* tgts, const int* wts,
+                                 std::shared_ptr<const void> owner)
+    {
+        if (!owner)
+            throw std::invalid_argument("CSRGraph: у внешних массивов нет владельца");
+        CSRGraph g;
+        g.numVertices = V;
+        g.offsets.clear();
+        g.externalOwner = std::move(owner);
+        g.offsetPtr = offs;
+        g.targetPtr = tgts;
+        g.weightPtr = wts;
+        return g;
+    }
+
+    // Копия своих векторов переназначает указатели; внешняя память общая
+    CSRGraph(const CSRGraph& other)
+        : numVertices(other.numVertices), offsets(other.offsets), targets(other.targets),
+          weights(other.weights), externalOwner(other.externalOwner)
+    {
+        bindAfterCopy(other);
+    }
+
+    CSRGraph(CSRGraph&& other) noexcept
+        : numVertices(other.numVertices), offsets(std::move(other.offsets)), targets(std::move(other.targets)),
+          weights(std::move(other.weights)), externalOwner(std::move(other.externalOwner))
+    {
+        bindAfterCopy(other);
+    }
+
+    CSRGraph& operator=(CSRGraph other) noexcept
+    {
+        numVertices = other.numVertices;
+        offsets.swap(other.offsets);
+        targets.swap(other.targets);
+        weights.swap(other.weights);
+        externalOwner.swap(other.externalOwner);
+        bindAfterCopy(other);
+        return *this;
+    }
+
+    // true - массивы во внешней памяти (mmap), а не в своих векторах
+    bool isExternal() const { return externalOwner != nullptr; }
+
+    // Построение из списка рёбер за O(V + E) сортировкой подсчётом по source.
+    // undirected = true добавляет каждое ребро в обе стороны.
+    static CSRGraph fromEdgeList(int V, const std::vector<WeightedEdge>& edges, bool undirected)
+    {
+        // Проход 1: считаем степень каждой вершины
+        std::vector<std::int64_t> offs(V + 1, 0);
+        for (const WeightedEdge& e : edges)
+        {
+            if (e.source < 0 || e.source >= V || e.destination < 0 || e.destination >= V)
+            {
+                throw std::out_of_range("CSRGraph: вершина ребра вне диапазона [0, V)");
+            }
+            offs[e.source + 1]++;
+            if (undirected)
+                offs[e.destination + 1]++;
+        }
+
+        // Префиксные суммы: offs[u] = начало рёбер вершины u
+        for (int u = 0; u < V; u++)
+        {
+            offs[u + 1] += offs[u];
+        }
+
+        // Проход 2: раскладываем рёбра по своим местам
+        std::vector<int> tgts(static_cast<std::size_t>(offs[V]));
+        std::vector<int> wts(static_cast<std::size_t>(offs[V]));
+        std::vector<std::int64_t> cursor(offs.begin(), offs.end() - 1);
+        for (const WeightedEdge& e : edges)
+        {
+            std::int64_t pos = cursor[e.source]++;
+            tgts[pos] = e.destination;
+            wts[pos] = e.weight;
+            if (undirected)
+            {
+                pos = cursor[e.destination]++;
+                tgts[pos] = e.source;
+                wts[pos] = e.weight;
+            }
+        }
+
+        return CSRGraph(V, std::move(offs), std::move(tgts), std::move(wts));
+    }
+
+    int vertexCount() const { return numVertices; }
+    std::int64_t edgeCount() const { return offsetPtr[numVertices]; }
+
+    int degree(int u) const { return static_cast<int>(offsetPtr[u + 1] - offsetPtr[u]); }
+
+    // Индексы рёбер вершины u: [edgeBegin(u), edgeEnd(u))
+    std::int64_t edgeBegin(int u) const { return offsetPtr[u]; }
+    std::int64_t edgeEnd(int u) const { return offsetPtr[u + 1]; }
+
+    int target(std::int64_t e) const { return targetPtr[e]; }
+    int weight(std::int64_t e) const { return weightPtr[e]; }
+
+    NeighborRange neighbors(int u) const
+    {
+        return NeighborRange(targetPtr + offsetPtr[u], targetPtr + offsetPtr[u + 1]);
+    }
+
+    // Сырые массивы - для алгоритмов, которым нужен прямой доступ
+    const std::int64_t* offsetData() const { return offsetPtr; }
+    const int* targetData() const { return targetPtr; }
+    const int* weightData() const { return weightPtr; }
+
+    // Обратный граф (все рёбра развёрнуты): входящие рёбра вершины становятся
+    // исходящими. Нужен алгоритмам, которые ходят по рёбрам "назад"
+    // (bottom-up BFS, обратный поиск в двунаправленной Дейкстре).
+    CSRGraph transpose() const
+    {
+        std::vector<std::int64_t> offs(numVertices + 1, 0);
+        for (std::int64_t e = 0; e < edgeCount(); e++)
+        {
+            offs[targetPtr[e] + 1]++;
+        }
+        for (int u = 0; u < numVertices; u++)
+        {
+            offs[u + 1] += offs[u];
+        }
+
+        std::vector<int> tgts(static_cast<std::size_t>(edgeCount()));
+        std::vector<int> wts(static_cast<std::size_t>(edgeCount()));
+        std::vector<std::int64_t> cursor(offs.begin(), offs.end() - 1);
+        for (int u = 0; u < numVertices; u++)
+        {
+            for (std::int64_t e = offsetPtr[u]; e < offsetPtr[u + 1]; e++)
+            {
+                std::int64_t pos = cursor[targetPtr[e]]++;
+                tgts[pos] = u;
+                wts[pos] = weightPtr[e];
+            }
+        }
+        return CSRGraph(numVertices, std::move(offs), std::move(tgts), std::move(wts));
+    }
+
+    // Объём памяти под массивы графа в байтах
+    std::size_t memoryBytes() const
+    {
+        return (static_cast<std::size_t>(numVertices) + 1) * sizeof(std::int64_t) +
+               static_cast<std::size_t>(edgeCount()) * 2 * sizeof(int);
+    }
+
+private:
+    void bindAfterCopy(const CSRGraph& other)
+    {
+        if (externalOwner)
+        {
+            offsetPtr = other.offsetPtr;
+            targetPtr = other.targetPtr;
+            weightPtr = other.weightPtr;
+        }
+        else
+        {
+            bindOwnStorage();
+        }
+    }
+};
+
+// Билдер с тем же интерфейсом addEdge, что и у Graph в учебных примерах:
+// достаточно заменить Graph g(V) на CSRGraphBuilder b(V) и в конце вызвать build().
+class CSRGraphBuilder
+{
+    int numVertices;
+    bool undirected;
+    std::vector<WeightedEdge> edges;
+
+public:
+    CSRGraphBuilder(int V, bool undirectedGraph = false) : numVertices(V), undirected(undirectedGraph) {}
+
+    void reserve(std::size_t edgeCount) { edges.reserve(edgeCount); }
+
+    void addEdge(int u, int v, int weight = 1)
+    {
+        edges.push_back({u, v, weight});
+    }
+
+    CSRGraph build() const
+    {
+        return CSRGraph::fromEdgeList(numVertices, edges, undirected);
+    }
+};
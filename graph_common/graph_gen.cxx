@@ -0,0 +1,172 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include "graph_io.h"
+#include "stream_generators.h"
+#include "thread_pool.h"
+
+// ========================================================================
+// GRAPH_GEN - СИНТЕТИЧЕСКИЕ ГРАФЫ ДЛЯ БЕНЧМАРКОВ
+// ========================================================================
+//   ./graph_gen <модель> <выход> [параметры]
+//
+//   rmat       --scale S --edge-factor F          R-MAT, 2^S вершин, F * 2^S рёбер
+//   kronecker  --scale S --edge-factor F          R-MAT с перестановкой номеров (Graph500)
+//   er         --vertices N --edges M             Эрдёш-Реньи G(n, m)
+//   grid       --side N [--highway K]             дорожная решётка N x N
+//   geometric  --vertices N --degree D            случайный геометрический граф
+//
+// Общие параметры:
+//   --seed S          (1)    одинаковый seed - одинаковый файл при любом числе потоков
+//   --max-weight W    (1)    веса [1, W] для rmat / kronecker / er
+//   --undirected             rmat / kronecker / er: рёбра в обе стороны
+//                            (grid и geometric всегда неориентированные)
+//   --threads N       (все ядра)
+//   --buffer-mb M     (2048) буфер записи двоичного CSR
+//   --verify                 прочитать файл обратно и сравнить число вершин
+//                            и рёбер с записанными (make roundtrip)
+//
+// Формат выхода - по расширению: .csr - двоичный CSR (loadBinaryCSR),
+// .gr - DIMACS, иначе SNAP. Рёбра не хранятся в памяти целиком, поэтому
+// можно генерировать графы больше оперативной памяти.
+//
+// Пример: ./graph_gen kronecker kron26.csr --scale 26 --edge-factor 16 --undirected
+// ========================================================================
+
+using Clock = std::chrono::steady_clock;
+
+bool endsWith(const std::string& s, const std::string& suffix)
+{
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Круговая проверка: файл читается тем же кодом, что и у graph_tool
+void verifyGraph(const std::string& path, int vertices, std::int64_t edges, ThreadPool& pool)
+{
+    int readVertices;
+    std::int64_t readEdges;
+    if (endsWith(path, ".csr"))
+    {
+        CSRGraph g = loadBinaryCSR(path, true);
+        readVertices = g.vertexCount();
+        readEdges = g.edgeCount();
+    }
+    else
+    {
+        EdgeList list = readEdgeList(path, &pool);
+        readVertices = list.vertexCount;
+        readEdges = static_cast<std::int64_t>(list.edges.size());
+    }
+    if (readVertices != vertices || readEdges != edges)
+        throw std::runtime_error("проверка " + path + ": прочитано " + std::to_string(readVertices) + " вершин, " +
+                                 std::to_string(readEdges) + " рёбер, записано " + std::to_string(vertices) +
+                                 " и " + std::to_string(edges));
+    std::cout << path << ": проверка пройдена\n";
+}
+
+template <typename Generator>
+void writeGraph(const Generator& gen, const std::string& path, ThreadPool& pool, std::int64_t bufferEdges,
+                bool verify)
+{
+    auto start = Clock::now();
+    std::int64_t edges;
+    if (endsWith(path, ".csr"))
+        edges = writeBinaryCSRStream(gen, path, pool, bufferEdges);
+    else
+        edges = writeEdgeListStream(gen, path, endsWith(path, ".gr") ? EdgeListFormat::DIMACS : EdgeListFormat::SNAP,
+                                    pool);
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << path << ": " << gen.vertexCount() << " вершин, " << edges << " рёбер за " << seconds << " с ("
+              << static_cast<long long>(edges / std::max(seconds, 1e-9)) << " рёбер/с)\n";
+    if (verify)
+        verifyGraph(path, gen.vertexCount(), edges, pool);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Использование: graph_gen <rmat|kronecker|er|grid|geometric> <выход> [параметры]\n"
+                  << "(параметры - в начале graph_gen.cxx)\n";
+        return 1;
+    }
+    const std::string model = argv[1];
+    const std::string path = argv[2];
+
+    // --ключ значение; --undirected и --verify без значения
+    std::map<std::string, std::string> options;
+    bool undirected = false;
+    bool verify = false;
+    for (int i = 3; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--undirected") == 0)
+            undirected = true;
+        else if (std::strcmp(argv[i], "--verify") == 0)
+            verify = true;
+        else if (std::strncmp(argv[i], "--", 2) == 0 && i + 1 < argc)
+        {
+            options[argv[i] + 2] = argv[i + 1];
+            i++;
+        }
+        else
+        {
+            std::cerr << "Неизвестный параметр: " << argv[i] << "\n";
+            return 1;
+        }
+    }
+    auto number = [&](const std::string& key, long long fallback) {
+        auto it = options.find(key);
+        return it == options.end() ? fallback : std::atoll(it->second.c_str());
+    };
+
+    try
+    {
+        ThreadPool pool(static_cast<int>(number("threads", 0)));
+        const std::uint64_t seed = static_cast<std::uint64_t>(number("seed", 1));
+        const int maxWeight = static_cast<int>(number("max-weight", 1));
+        // Буфер: 12 байт ребра + 4 байта столбца для записи
+        const std::int64_t bufferEdges = std::max(1LL, number("buffer-mb", 2048) * 1024 * 1024 / 16);
+
+        if (model == "rmat" || model == "kronecker")
+        {
+            RMATStream gen(static_cast<int>(number("scale", 20)), static_cast<int>(number("edge-factor", 16)), seed,
+                           maxWeight, model == "kronecker");
+            gen.undirected = undirected;
+            writeGraph(gen, path, pool, bufferEdges, verify);
+        }
+        else if (model == "er")
+        {
+            ErdosRenyiStream gen(static_cast<int>(number("vertices", 1 << 20)), number("edges", 16LL << 20), seed,
+                                 maxWeight);
+            gen.undirected = undirected;
+            writeGraph(gen, path, pool, bufferEdges, verify);
+        }
+        else if (model == "grid")
+        {
+            GridStream gen(static_cast<int>(number("side", 1000)), seed, static_cast<int>(number("highway", 0)));
+            writeGraph(gen, path, pool, bufferEdges, verify);
+        }
+        else if (model == "geometric")
+        {
+            GeometricStream gen(static_cast<int>(number("vertices", 1 << 20)),
+                                static_cast<double>(number("degree", 8)), seed);
+            writeGraph(gen, path, pool, bufferEdges, verify);
+        }
+        else
+        {
+            std::cerr << "Неизвестная модель: " << model << "\n";
+            return 1;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Ошибка: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "csr_graph.h"
+
+// ========================================================================
+// ГЕНЕРАТОРЫ СИНТЕТИЧЕСКИХ ГРАФОВ
+// ========================================================================
+// Детерминированные (одинаковый seed => одинаковый граф) генераторы
+// входных данных для бенчмарков графовых алгоритмов.
+// ========================================================================
+
+// ------------------------------------------------------------------------
+// R-MAT (Recursive MATrix, Chakrabarti et al.)
+// ------------------------------------------------------------------------
+// Матрица смежности 2^scale x 2^scale рекурсивно делится на четыре
+// квадранта с вероятностями a, b, c, d. Для каждого ребра scale раз
+// выбираем квадрант - получаем степенное распределение степеней и малый
+// диаметр, как у социальных графов. Параметры Graph500: a=0.57, b=c=0.19.
+//
+//   +-----+-----+
+//   |  a  |  b  |
+//   +-----+-----+
+//   |  c  |  d  |
+//   +-----+-----+
+// ------------------------------------------------------------------------
+struct RMATParams
+{
+    double a = 0.57;
+    double b = 0.19;
+    double c = 0.19;
+    // d = 1 - a - b - c
+};
+
+inline WeightedEdge rmatEdge(int scale, const RMATParams& p, std::mt19937_64& rng,
+                             std::uniform_int_distribution<int>& weightDist)
+{
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    int u = 0, v = 0;
+    for (int bit = 0; bit < scale; bit++)
+    {
+        double r = coin(rng);
+        u <<= 1;
+        v <<= 1;
+        if (r < p.a)
+        {
+            // Левый верхний квадрант: оба бита 0
+        }
+        else if (r < p.a + p.b)
+        {
+            v |= 1;
+        }
+        else if (r < p.a + p.b + p.c)
+        {
+            u |= 1;
+        }
+        else
+        {
+            u |= 1;
+            v |= 1;
+        }
+    }
+    return {u, v, weightDist(rng)};
+}
+
+// Список из edgeFactor * 2^scale рёбер R-MAT графа с весами [1, maxWeight]
+inline std::vector<WeightedEdge> generateRMAT(int scale, int edgeFactor, std::uint64_t seed,
+                                              int maxWeight = 1, const RMATParams& params = RMATParams())
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> weightDist(1, maxWeight);
+    const std::int64_t numEdges = static_cast<std::int64_t>(edgeFactor) << scale;
+
+    std::vector<WeightedEdge> edges;
+    edges.reserve(static_cast<std::size_t>(numEdges));
+    for (std::int64_t i = 0; i < numEdges; i++)
+    {
+        edges.push_back(rmatEdge(scale, params, rng, weightDist));
+    }
+    return edges;
+}
+
+// ------------------------------------------------------------------------
+// "ДОРОЖНАЯ" РЕШЁТКА С КООРДИНАТАМИ
+// ------------------------------------------------------------------------
+// side x side перекрёстков, координаты сдвинуты случайно на +-30% шага
+// (шаг - 100 м), рёбра к соседям справа и снизу. Вес ребра - длина
+// отрезка, умноженная на коэффициент извилистости [1, 1.5], поэтому
+// евклидово расстояние - нижняя оценка (эвристика A*). Граф
+// неориентированный, большой диаметр - как у дорожных сетей.
+//
+// highwayEvery > 0 делает каждую highwayEvery-ю строку и столбец
+// "шоссе": вес их рёбер в HIGHWAY_SPEEDUP раз меньше (веса - время в
+// пути). Так появляется иерархия, как в настоящих дорожных сетях; нижняя
+// оценка A* тогда - евклидово расстояние / HIGHWAY_SPEEDUP.
+// ------------------------------------------------------------------------
+const int HIGHWAY_SPEEDUP = 4;
+
+struct RoadGrid
+{
+    std::vector<double> x, y; // Координаты вершин
+    CSRGraph graph;
+};
+
+inline RoadGrid generateRoadGrid(int side, std::uint64_t seed, int highwayEvery = 0)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> jitter(-0.3, 0.3);
+    std::uniform_real_distribution<double> detour(1.0, 1.5);
+    const int V = side * side;
+
+    RoadGrid grid;
+    grid.x.resize(V);
+    grid.y.resize(V);
+    for (int v = 0; v < V; v++)
+    {
+        grid.x[v] = (v % side + jitter(rng)) * 100.0;
+        grid.y[v] = (v / side + jitter(rng)) * 100.0;
+    }
+
+    CSRGraphBuilder builder(V, true);
+    builder.reserve(static_cast<std::size_t>(V) * 2);
+    auto road = [&](int a, int b, bool highway) {
+        double length = std::hypot(grid.x[a] - grid.x[b], grid.y[a] - grid.y[b]) * detour(rng);
+        if (highway)
+            length /= HIGHWAY_SPEEDUP;
+        builder.addEdge(a, b, static_cast<int>(std::ceil(length)));
+    };
+    auto isHighway = [highwayEvery](int line) { return highwayEvery > 0 && line % highwayEvery == 0; };
+    for (int r = 0; r < side; r++)
+    {
+        for (int c = 0; c < side; c++)
+        {
+            int v = r * side + c;
+            if (c + 1 < side)
+                road(v, v + 1, isHighway(r));
+            if (r + 1 < side)
+                road(v, v + side, isHighway(c));
+        }
+    }
+    grid.graph = builder.build();
+    return grid;
+}
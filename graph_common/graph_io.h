@@ -0,0 +1,468 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "csr_graph.h"
+#include "thread_pool.h"
+
+// ========================================================================
+// ЗАГРУЗКА ГРАФОВ ИЗ ФАЙЛОВ
+// ========================================================================
+// Учебные программы строят граф сотнями addEdge в main(). Для реальных
+// наборов данных (дорожные сети DIMACS, графы SNAP) нужны:
+//
+// 1. ТЕКСТОВЫЕ списки рёбер - readEdgeList:
+//      DIMACS (.gr):  c комментарий
+//                     p sp <V> <E>
+//                     a <u> <v> <w>        (вершины с 1)
+//      SNAP:          # комментарий
+//                     # vertices <V>       (необязательно, пишет graph_gen)
+//                     <u> <v> [w]          (вершины с 0, вес по умолчанию 1)
+//    Без строки "# vertices" число вершин - максимальный номер + 1, и
+//    изолированные вершины в конце нумерации теряются.
+//    Файл отображается в память и делится на куски по границам строк;
+//    куски разбираются параллельно (пул потоков), каждый в свой буфер,
+//    затем буферы копируются в общий массив по префиксным суммам.
+//    Числа разбираются вручную (strtol медленнее из-за локали и errno).
+//    Номера вершин должны лежать в [0, INT32_MAX) (число вершин - номер
+//    плюс 1 - тоже в int), веса - в [0, INT32_MAX], иначе ошибка.
+//
+// 2. ДВОИЧНЫЙ CSR - saveBinaryCSR / loadBinaryCSR:
+//      заголовок 32 байта: "CSRGRAPH", версия, флаги, V, E
+//      offsets[V + 1] (int64), targets[E] (int32), weights[E] (int32)
+//    Загрузка - mmap без чтения и копирования: CSRGraph смотрит прямо
+//    в страницы файла, ОС подгружает их при первом обращении. Запуск
+//    занимает микросекунды независимо от размера графа. Содержимое
+//    файла по умолчанию считается доверенным; validate = true - полная
+//    проверка за O(V + E).
+//
+// Ошибки (нет файла, неверный формат) - исключения std::runtime_error.
+// Только POSIX (mmap).
+// ========================================================================
+
+// Файл, отображённый в память только для чтения
+class MappedFile
+{
+    int fd = -1;
+    void* address = nullptr;
+    std::size_t length = 0;
+
+public:
+    explicit MappedFile(const std::string& path)
+    {
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("MappedFile: " + path + ": " + std::strerror(errno));
+        struct stat info;
+        if (::fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("MappedFile: " + path + ": " + std::strerror(errno));
+        }
+        length = static_cast<std::size_t>(info.st_size);
+        if (length > 0)
+        {
+            address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("MappedFile: mmap " + path + ": " + std::strerror(errno));
+            }
+        }
+    }
+
+    ~MappedFile()
+    {
+        if (address != nullptr)
+            ::munmap(address, length);
+        if (fd >= 0)
+            ::close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return static_cast<const char*>(address); }
+    std::size_t size() const { return length; }
+
+    // Подсказка ОС: файл будет читаться подряд целиком
+    void adviseSequential() const
+    {
+        if (address != nullptr)
+            ::madvise(address, length, MADV_SEQUENTIAL);
+    }
+};
+
+// ========================================================================
+// ТЕКСТОВЫЕ СПИСКИ РЁБЕР
+// ========================================================================
+
+enum class EdgeListFormat
+{
+    Auto,   // По первой значащей строке: c / p / a - DIMACS, цифра - SNAP
+    DIMACS,
+    SNAP
+};
+
+struct EdgeList
+{
+    int vertexCount = 0; // Из строки "p sp V E" / "# vertices V", иначе максимальный номер + 1
+    std::vector<WeightedEdge> edges;
+};
+
+// Минимальный размер куска разбора (меньшие файлы читает один поток)
+const std::size_t EDGE_LIST_CHUNK_MIN = 1 << 20;
+
+namespace graph_io_detail
+{
+
+// Ключ строки SNAP с числом вершин: "# vertices V"
+const char SNAP_VERTICES_KEY[] = "vertices";
+
+inline bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+// Пропустить пробелы и разобрать целое со знаком; false - числа нет
+// или оно не помещается в long long
+inline bool parseInt(const char*& p, const char* end, long long& value)
+{
+    while (p < end && isSpace(*p))
+        p++;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = (*p++ == '-');
+    if (p == end || *p < '0' || *p > '9')
+        return false;
+    long long v = 0;
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+        int digit = *p++ - '0';
+        if (v > (LLONG_MAX - digit) / 10)
+            return false;
+        v = v * 10 + digit;
+    }
+    value = negative ? -v : v;
+    return true;
+}
+
+inline EdgeListFormat detectFormat(const char* p, const char* end)
+{
+    while (p < end)
+    {
+        while (p < end && (isSpace(*p) || *p == '\n'))
+            p++;
+        if (p == end)
+            break;
+        if (*p == 'c' || *p == 'p' || *p == 'a')
+            return EdgeListFormat::DIMACS;
+        if (*p == '#' || *p == '%')
+        {
+            while (p < end && *p != '\n')
+                p++;
+            continue;
+        }
+        return EdgeListFormat::SNAP;
+    }
+    return EdgeListFormat::SNAP;
+}
+
+// Результат разбора одного куска
+struct ChunkResult
+{
+    std::vector<WeightedEdge> edges;
+    long long maxVertex = -1;
+    long long declaredVertices = -1; // Из строки "p sp V E" или "# vertices V"
+    std::string error;
+};
+
+inline void parseChunk(const char* p, const char* end, EdgeListFormat format, ChunkResult& out)
+{
+    while (p < end)
+    {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        if (lineEnd == nullptr)
+            lineEnd = end;
+        const char* q = p;
+        while (q < lineEnd && isSpace(*q))
+            q++;
+
+        if (q < lineEnd)
+        {
+            long long u = 0, v = 0, w = 1;
+            bool ok = true;
+            bool isEdge = false;
+            if (format == EdgeListFormat::DIMACS)
+            {
+                char kind = *q++;
+                if (kind == 'a')
+                {
+                    ok = parseInt(q, lineEnd, u) && parseInt(q, lineEnd, v) && parseInt(q, lineEnd, w);
+                    u--; // DIMACS нумерует вершины с 1
+                    v--;
+                    isEdge = true;
+                }
+                else if (kind == 'p')
+                {
+                    while (q < lineEnd && isSpace(*q))
+                        q++;
+                    while (q < lineEnd && !isSpace(*q)) // Тип задачи ("sp")
+                        q++;
+                    long long edges = 0;
+                    ok = parseInt(q, lineEnd, out.declaredVertices) && parseInt(q, lineEnd, edges);
+                    // Строка "a u v w" - не меньше 8 байт: E из заголовка не
+                    // может заставить выделить больше, чем есть в файле
+                    if (ok)
+                        out.edges.reserve(static_cast<std::size_t>(
+                            std::min<long long>(std::max(0LL, edges), static_cast<long long>(end - p) / 8)));
+                }
+                else if (kind != 'c')
+                {
+                    ok = false;
+                }
+            }
+            else if (*q == '#')
+            {
+                // "# vertices V ..." - число вершин; прочие строки '#' - комментарии
+                const char* r = q + 1;
+                while (r < lineEnd && isSpace(*r))
+                    r++;
+                const std::size_t keyLength = std::strlen(SNAP_VERTICES_KEY);
+                if (static_cast<std::size_t>(lineEnd - r) > keyLength &&
+                    std::memcmp(r, SNAP_VERTICES_KEY, keyLength) == 0 && isSpace(r[keyLength]))
+                {
+                    r += keyLength;
+                    long long declared = 0;
+                    if (parseInt(r, lineEnd, declared)) // Иначе - просто комментарий
+                        out.declaredVertices = std::max(out.declaredVertices, declared);
+                }
+            }
+            else if (*q != '%')
+            {
+                ok = parseInt(q, lineEnd, u) && parseInt(q, lineEnd, v);
+                while (q < lineEnd && isSpace(*q))
+                    q++;
+                // Вес необязателен, но если он есть - должен разобраться
+                if (ok && q < lineEnd)
+                    ok = parseInt(q, lineEnd, w);
+                isEdge = true;
+            }
+
+            // Номер вершины < INT32_MAX: иначе V = номер + 1 не помещается в int.
+            // Веса - в int и неотрицательные (их ждут Дейкстра, Прим и др.)
+            bool inRange = u >= 0 && v >= 0 && w >= 0 && u < INT32_MAX && v < INT32_MAX && w <= INT32_MAX;
+            if (!ok || (isEdge && !inRange))
+            {
+                out.error = "неверная строка: " + std::string(p, lineEnd);
+                return;
+            }
+            if (isEdge)
+            {
+                out.edges.push_back({static_cast<int>(u), static_cast<int>(v), static_cast<int>(w)});
+                out.maxVertex = std::max(out.maxVertex, std::max(u, v));
+            }
+        }
+        p = lineEnd + 1;
+    }
+}
+
+} // namespace graph_io_detail
+
+// Разобрать текст списка рёбер (pool == nullptr - в одном потоке)
+inline EdgeList parseEdgeList(const char* text, std::size_t size, ThreadPool* pool = nullptr,
+                              EdgeListFormat format = EdgeListFormat::Auto)
+{
+    using namespace graph_io_detail;
+    const char* end = text + size;
+    if (format == EdgeListFormat::Auto)
+        format = detectFormat(text, end);
+
+    // Куски по границам строк: начало куска сдвигается за ближайший '\n'
+    std::size_t threads = pool != nullptr ? static_cast<std::size_t>(pool->threadCount()) : 1;
+    std::size_t numChunks = std::max<std::size_t>(1, std::min(threads * 4, size / EDGE_LIST_CHUNK_MIN));
+    std::vector<const char*> bounds(numChunks + 1, end);
+    bounds[0] = text;
+    for (std::size_t c = 1; c < numChunks; c++)
+    {
+        const char* p = text + size / numChunks * c;
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        bounds[c] = newline != nullptr ? newline + 1 : end;
+        bounds[c] = std::max(bounds[c], bounds[c - 1]);
+    }
+
+    std::vector<ChunkResult> chunks(numChunks);
+    auto parseOne = [&](std::int64_t c) { parseChunk(bounds[c], bounds[c + 1], format, chunks[c]); };
+    if (pool != nullptr)
+        pool->parallelFor(0, static_cast<std::int64_t>(numChunks), parseOne);
+    else
+        for (std::size_t c = 0; c < numChunks; c++)
+            parseOne(static_cast<std::int64_t>(c));
+
+    EdgeList result;
+    long long maxVertex = -1, declared = -1;
+    std::vector<std::size_t> offset(numChunks + 1, 0);
+    for (std::size_t c = 0; c < numChunks; c++)
+    {
+        if (!chunks[c].error.empty())
+            throw std::runtime_error("parseEdgeList: " + chunks[c].error);
+        maxVertex = std::max(maxVertex, chunks[c].maxVertex);
+        declared = std::max(declared, chunks[c].declaredVertices);
+        offset[c + 1] = offset[c] + chunks[c].edges.size();
+    }
+
+    if (format == EdgeListFormat::DIMACS && declared < 0)
+        throw std::runtime_error("parseEdgeList: в DIMACS-файле нет строки \"p sp V E\"");
+    if (declared > INT32_MAX)
+        throw std::runtime_error("parseEdgeList: слишком много вершин в заголовке");
+    if (declared >= 0)
+    {
+        if (maxVertex >= declared)
+            throw std::runtime_error("parseEdgeList: номер вершины не меньше V из заголовка");
+        result.vertexCount = static_cast<int>(declared);
+    }
+    else
+    {
+        result.vertexCount = static_cast<int>(maxVertex + 1);
+    }
+
+    result.edges.resize(offset[numChunks]);
+    auto copyOne = [&](std::int64_t c) {
+        std::copy(chunks[c].edges.begin(), chunks[c].edges.end(), result.edges.begin() + offset[c]);
+        std::vector<WeightedEdge>().swap(chunks[c].edges);
+    };
+    if (pool != nullptr)
+        pool->parallelFor(0, static_cast<std::int64_t>(numChunks), copyOne);
+    else
+        for (std::size_t c = 0; c < numChunks; c++)
+            copyOne(static_cast<std::int64_t>(c));
+    return result;
+}
+
+inline EdgeList readEdgeList(const std::string& path, ThreadPool* pool = nullptr,
+                             EdgeListFormat format = EdgeListFormat::Auto)
+{
+    MappedFile file(path);
+    file.adviseSequential();
+    return parseEdgeList(file.data(), file.size(), pool, format);
+}
+
+// ========================================================================
+// ДВОИЧНЫЙ CSR
+// ========================================================================
+
+struct BinaryCSRHeader
+{
+    char magic[8];          // "CSRGRAPH"
+    std::uint32_t version;  // BINARY_CSR_VERSION
+    std::uint32_t flags;    // Зарезервировано (0)
+    std::int64_t vertices;
+    std::int64_t edges;
+};
+
+static_assert(sizeof(BinaryCSRHeader) == 32, "заголовок CSR-файла - 32 байта");
+
+const char BINARY_CSR_MAGIC[8] = {'C', 'S', 'R', 'G', 'R', 'A', 'P', 'H'};
+const std::uint32_t BINARY_CSR_VERSION = 1;
+
+inline bool isBinaryCSR(const char* data, std::size_t size)
+{
+    return size >= sizeof(BinaryCSRHeader) && std::memcmp(data, BINARY_CSR_MAGIC, 8) == 0;
+}
+
+inline void saveBinaryCSR(const CSRGraph& g, const std::string& path)
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+        throw std::runtime_error("saveBinaryCSR: не удалось открыть " + path);
+
+    BinaryCSRHeader header;
+    std::memcpy(header.magic, BINARY_CSR_MAGIC, 8);
+    header.version = BINARY_CSR_VERSION;
+    header.flags = 0;
+    header.vertices = g.vertexCount();
+    header.edges = g.edgeCount();
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(g.offsetData()),
+              static_cast<std::streamsize>((header.vertices + 1) * sizeof(std::int64_t)));
+    out.write(reinterpret_cast<const char*>(g.targetData()), static_cast<std::streamsize>(header.edges * sizeof(int)));
+    out.write(reinterpret_cast<const char*>(g.weightData()), static_cast<std::streamsize>(header.edges * sizeof(int)));
+    if (!out)
+        throw std::runtime_error("saveBinaryCSR: ошибка записи " + path);
+}
+
+// Граф поверх отображённого файла: O(1), без чтения рёбер. Проверяются
+// только заголовок, размер файла и крайние смещения - содержимое файла
+// считается доверенным (его записал saveBinaryCSR / graph_gen). Для
+// файлов из чужих рук validate = true: проход O(V + E) проверяет, что
+// смещения не убывают, концы рёбер лежат в [0, V), а веса неотрицательны -
+// иначе повреждённый файл приведёт к чтению за границами в алгоритмах.
+inline CSRGraph loadBinaryCSR(const std::string& path, bool validate = false)
+{
+    auto file = std::make_shared<MappedFile>(path);
+    if (!isBinaryCSR(file->data(), file->size()))
+        throw std::runtime_error("loadBinaryCSR: " + path + " - не двоичный CSR");
+
+    BinaryCSRHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (header.version != BINARY_CSR_VERSION)
+        throw std::runtime_error("loadBinaryCSR: неподдерживаемая версия формата в " + path);
+    if (header.vertices < 0 || header.vertices > INT32_MAX || header.edges < 0)
+        throw std::runtime_error("loadBinaryCSR: повреждённый заголовок " + path);
+
+    // E из заголовка сравнивается с остатком файла делением - без переполнения
+    const std::size_t payload = file->size() - sizeof(header);
+    const std::size_t offsetBytes = static_cast<std::size_t>(header.vertices + 1) * sizeof(std::int64_t);
+    const std::size_t edgeBytes = 2 * sizeof(int);
+    if (offsetBytes > payload || static_cast<std::uint64_t>(header.edges) != (payload - offsetBytes) / edgeBytes ||
+        (payload - offsetBytes) % edgeBytes != 0)
+        throw std::runtime_error("loadBinaryCSR: размер " + path + " не совпадает с заголовком");
+
+    const char* base = file->data() + sizeof(header);
+    const auto* offsets = reinterpret_cast<const std::int64_t*>(base);
+    const auto* targets = reinterpret_cast<const int*>(offsets + header.vertices + 1);
+    const auto* weights = targets + header.edges;
+    if (offsets[0] != 0 || offsets[header.vertices] != header.edges)
+        throw std::runtime_error("loadBinaryCSR: повреждённые смещения в " + path);
+
+    if (validate)
+    {
+        for (std::int64_t u = 0; u < header.vertices; u++)
+            if (offsets[u] > offsets[u + 1])
+                throw std::runtime_error("loadBinaryCSR: смещения убывают у вершины " + std::to_string(u) +
+                                         " в " + path);
+        for (std::int64_t e = 0; e < header.edges; e++)
+            if (targets[e] < 0 || targets[e] >= header.vertices || weights[e] < 0)
+                throw std::runtime_error("loadBinaryCSR: неверное ребро " + std::to_string(e) + " в " + path);
+    }
+
+    return CSRGraph::fromExternal(static_cast<int>(header.vertices), offsets, targets, weights, file);
+}
+
+// Любой из форматов: двоичный CSR (по заголовку) или текстовый список
+// рёбер. undirected - добавить обратные рёбра (только для текста: в
+// двоичном файле граф уже сохранён в нужном виде). validate - полная
+// проверка двоичного CSR (текст проверяется при разборе всегда).
+inline CSRGraph loadGraph(const std::string& path, bool undirected, ThreadPool* pool = nullptr,
+                          bool validate = false)
+{
+    {
+        MappedFile probe(path);
+        if (isBinaryCSR(probe.data(), probe.size()))
+            return loadBinaryCSR(path, validate);
+    }
+    EdgeList list = readEdgeList(path, pool);
+    return CSRGraph::fromEdgeList(list.vertexCount, list.edges, undirected);
+}
@@ -0,0 +1,217 @@
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "csr_graph.h"
+#include "graph_io.h"
+#include "thread_pool.h"
+#include "../bfs/parallel_bfs.h"
+#include "../dijkstra/csr_dijkstra.h"
+#include "../dijkstra/delta_stepping.h"
+#include "../prim/csr_prim.h"
+#include "../kruskal/filter_kruskal.h"
+#include "../boruvka/parallel_boruvka.h"
+#include "../floyd_warshall/parallel_apsp.h"
+
+// ========================================================================
+// GRAPH_TOOL - ЗАПУСК АЛГОРИТМОВ НА ГРАФАХ ИЗ ФАЙЛОВ
+// ========================================================================
+//   ./graph_tool convert <вход.gr|.txt> <выход.csr> [--undirected] [--threads N]
+//       разобрать текстовый список рёбер (DIMACS / SNAP) и сохранить
+//       двоичный CSR; --undirected - каждое ребро в обе стороны
+//   ./graph_tool info <файл>
+//       число вершин и рёбер, максимальная степень и вес
+//   ./graph_tool run <алгоритм> <файл> [источник] [--undirected] [--threads N]
+//       bfs | dijkstra | delta | prim | kruskal | boruvka | apsp
+//
+// Файл может быть как текстовым, так и двоичным CSR (определяется по
+// заголовку). Двоичный CSR отображается в память - загрузка мгновенная.
+// --validate - полная проверка двоичного CSR за O(V + E) для файлов,
+// которые записаны не graph_tool / graph_gen.
+// Для prim / kruskal / boruvka граф должен быть неориентированным.
+// ========================================================================
+
+// Больше вершин - матрица V x V для APSP не поместится в память разумно
+const int APSP_MAX_VERTICES = 20000;
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void printUsage()
+{
+    std::cerr << "Использование:\n"
+              << "  graph_tool convert <вход> <выход.csr> [--undirected] [--threads N]\n"
+              << "  graph_tool info <файл> [--undirected] [--validate]\n"
+              << "  graph_tool run <bfs|dijkstra|delta|prim|kruskal|boruvka|apsp> <файл> [источник]"
+              << " [--undirected] [--validate] [--threads N]\n";
+}
+
+// Рёбра неориентированного CSR-графа по одному разу (u < v)
+std::vector<WeightedEdge> undirectedEdges(const CSRGraph& g)
+{
+    std::vector<WeightedEdge> edges;
+    edges.reserve(static_cast<std::size_t>(g.edgeCount() / 2));
+    for (int u = 0; u < g.vertexCount(); u++)
+    {
+        for (std::int64_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++)
+        {
+            if (u < g.target(e))
+                edges.push_back({u, g.target(e), g.weight(e)});
+        }
+    }
+    return edges;
+}
+
+int countReachable(const std::vector<int>& dist, int unreachable)
+{
+    int count = 0;
+    for (int d : dist)
+    {
+        if (d != unreachable)
+            count++;
+    }
+    return count;
+}
+
+void printInfo(const CSRGraph& g)
+{
+    int maxDegree = 0;
+    int maxWeight = 0;
+    for (int u = 0; u < g.vertexCount(); u++)
+        maxDegree = std::max(maxDegree, g.degree(u));
+    for (std::int64_t e = 0; e < g.edgeCount(); e++)
+        maxWeight = std::max(maxWeight, g.weight(e));
+    std::cout << "Вершин: " << g.vertexCount() << "\n"
+              << "Рёбер (записей CSR): " << g.edgeCount() << "\n"
+              << "Максимальная степень: " << maxDegree << "\n"
+              << "Максимальный вес: " << maxWeight << "\n"
+              << "Память: " << g.memoryBytes() / (1024 * 1024) << " МБ"
+              << (g.isExternal() ? " (отображена из файла)" : "") << "\n";
+}
+
+void runAlgorithm(const std::string& name, const CSRGraph& g, int source, ThreadPool& pool)
+{
+    if (source < 0 || source >= g.vertexCount())
+        throw std::invalid_argument("источник вне диапазона вершин");
+
+    auto start = Clock::now();
+    if (name == "bfs")
+    {
+        CSRGraph reverse = g.transpose();
+        ParallelBFS bfs(g, reverse, pool);
+        BFSResult r = bfs.run(source);
+        std::cout << "BFS: достижимо " << countReachable(r.distance, -1) << " вершин";
+    }
+    else if (name == "dijkstra")
+    {
+        std::vector<int> dist = csrDijkstra(g, source, DijkstraQueue::Auto);
+        std::cout << "Дейкстра: достижимо " << countReachable(dist, INT_MAX) << " вершин";
+    }
+    else if (name == "delta")
+    {
+        std::vector<int> dist = deltaStepping(g, source, pool);
+        std::cout << "Delta-stepping: достижимо " << countReachable(dist, INT_MAX) << " вершин";
+    }
+    else if (name == "prim")
+    {
+        PrimResult r = csrPrim(g, source, PrimQueue::Auto);
+        std::cout << "Прим: " << r.edgeCount << " рёбер, вес " << r.totalWeight;
+    }
+    else if (name == "kruskal" || name == "boruvka")
+    {
+        std::vector<WeightedEdge> edges = undirectedEdges(g);
+        MSTResult r = name == "kruskal" ? filterKruskal(g.vertexCount(), edges, pool)
+                                        : parallelBoruvka(g.vertexCount(), edges, pool);
+        std::cout << (name == "kruskal" ? "Крускал" : "Борувка") << ": " << r.edges.size()
+                  << " рёбер, вес " << r.totalWeight << ", компонент " << r.components;
+    }
+    else if (name == "apsp")
+    {
+        if (g.vertexCount() > APSP_MAX_VERTICES)
+            throw std::invalid_argument("APSP: слишком много вершин (матрица V x V)");
+        APSPResult r = parallelAPSP(g, pool);
+        std::cout << "APSP: d(" << source << ", " << g.vertexCount() - 1 << ") = "
+                  << r.distance(source, g.vertexCount() - 1);
+    }
+    else
+    {
+        throw std::invalid_argument("неизвестный алгоритм: " + name);
+    }
+    std::cout << " за " << secondsSince(start) << " с\n";
+}
+
+int main(int argc, char* argv[])
+{
+    // Разбор аргументов: флаги в любом месте, остальное - позиционные
+    std::vector<std::string> args;
+    bool undirected = false;
+    bool validate = false;
+    int threads = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--undirected") == 0)
+            undirected = true;
+        else if (std::strcmp(argv[i], "--validate") == 0)
+            validate = true;
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = std::atoi(argv[++i]);
+        else
+            args.push_back(argv[i]);
+    }
+    if (args.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    try
+    {
+        ThreadPool pool(threads);
+        const std::string& command = args[0];
+        if (command == "convert" && args.size() == 3)
+        {
+            auto start = Clock::now();
+            CSRGraph g = loadGraph(args[1], undirected, &pool, validate);
+            std::cout << "Прочитано: " << g.vertexCount() << " вершин, " << g.edgeCount()
+                      << " рёбер за " << secondsSince(start) << " с\n";
+            start = Clock::now();
+            saveBinaryCSR(g, args[2]);
+            std::cout << "Записано в " << args[2] << " за " << secondsSince(start) << " с\n";
+        }
+        else if (command == "info" && args.size() == 2)
+        {
+            auto start = Clock::now();
+            CSRGraph g = loadGraph(args[1], undirected, &pool, validate);
+            std::cout << "Загрузка: " << secondsSince(start) << " с\n";
+            printInfo(g);
+        }
+        else if (command == "run" && (args.size() == 3 || args.size() == 4))
+        {
+            auto start = Clock::now();
+            CSRGraph g = loadGraph(args[2], undirected, &pool, validate);
+            std::cout << "Загрузка: " << g.vertexCount() << " вершин, " << g.edgeCount()
+                      << " рёбер за " << secondsSince(start) << " с\n";
+            int source = args.size() == 4 ? std::atoi(args[3].c_str()) : 0;
+            runAlgorithm(args[1], g, source, pool);
+        }
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Ошибка: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+// ========================================================================
+// ИНДЕКСИРОВАННАЯ D-АРНАЯ КУЧА (min-heap с операцией decreaseKey)
+// ========================================================================
+// std::priority_queue не умеет уменьшать ключ уже лежащего в ней элемента,
+// поэтому учебные Дейкстра и Прим кладут вершину повторно и пропускают
+// устаревшие записи ("ленивое удаление"). В худшем случае куча разрастается
+// до O(E) элементов.
+//
+// Индексированная куча хранит для каждой вершины её позицию в массиве
+// кучи (pos[v]), поэтому:
+//   - каждая вершина лежит в куче не более одного раза (размер <= V)
+//   - decreaseKey(v, k) находит вершину за O(1) и просеивает вверх
+//
+// Арность D: у узла i потомки D*i + 1 ... D*i + D.
+//   D = 2 - классическая двоичная куча
+//   D = 4 - меньше уровней, потомки узла лежат в одной кэш-линии;
+//           обычно быстрее на графах, где decreaseKey вызывается часто
+// ========================================================================
+
+template <int D = 4>
+class IndexedDaryHeap
+{
+    static_assert(D >= 2, "Арность кучи должна быть не меньше 2");
+
+    std::vector<std::pair<int, int>> heap; // (ключ, элемент), ключ рядом для локальности
+    std::vector<int> pos;                  // Позиция элемента в heap, -1 = нет в куче
+
+    void place(std::size_t i, const std::pair<int, int>& item)
+    {
+        heap[i] = item;
+        pos[item.second] = static_cast<int>(i);
+    }
+
+    void siftUp(std::size_t i)
+    {
+        std::pair<int, int> item = heap[i];
+        while (i > 0)
+        {
+            std::size_t parent = (i - 1) / D;
+            if (heap[parent].first <= item.first)
+                break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, item);
+    }
+
+    void siftDown(std::size_t i)
+    {
+        std::pair<int, int> item = heap[i];
+        const std::size_t n = heap.size();
+        while (true)
+        {
+            std::size_t first = D * i + 1;
+            if (first >= n)
+                break;
+            std::size_t last = first + D < n ? first + D : n;
+
+            // Ищем минимального потомка
+            std::size_t best = first;
+            for (std::size_t c = first + 1; c < last; c++)
+            {
+                if (heap[c].first < heap[best].first)
+                    best = c;
+            }
+            if (heap[best].first >= item.first)
+                break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, item);
+    }
+
+public:
+    // capacity - количество различных элементов (вершин): 0 .. capacity-1
+    explicit IndexedDaryHeap(int capacity = 0) : pos(capacity, -1)
+    {
+        heap.reserve(capacity);
+    }
+
+    // Изменить количество элементов (куча должна быть пустой)
+    void resize(int capacity)
+    {
+        pos.assign(capacity, -1);
+        heap.clear();
+        heap.reserve(capacity);
+    }
+
+    bool empty() const { return heap.empty(); }
+    std::size_t size() const { return heap.size(); }
+    bool contains(int item) const { return pos[item] != -1; }
+
+    int top() const { return heap[0].second; }
+    int topKey() const { return heap[0].first; }
+
+    // Ключ элемента, лежащего в куче
+    int keyOf(int item) const { return heap[pos[item]].first; }
+
+    void push(int item, int key)
+    {
+        heap.push_back({key, item});
+        siftUp(heap.size() - 1);
+    }
+
+    // Уменьшить ключ элемента, который уже в куче
+    void decreaseKey(int item, int key)
+    {
+        std::size_t i = static_cast<std::size_t>(pos[item]);
+        heap[i].first = key;
+        siftUp(i);
+    }
+
+    // push для нового элемента, decreaseKey для уже лежащего в куче
+    void pushOrDecrease(int item, int key)
+    {
+        if (contains(item))
+            decreaseKey(item, key);
+        else
+            push(item, key);
+    }
+
+    // Извлечь элемент с минимальным ключом
+    int pop()
+    {
+        int item = heap[0].second;
+        pos[item] = -1;
+        std::pair<int, int> last = heap.back();
+        heap.pop_back();
+        if (!heap.empty())
+        {
+            heap[0] = last;
+            siftDown(0);
+        }
+        return item;
+    }
+
+    // Очистка за O(size), а не O(capacity): удобно при повторных запусках
+    void clear()
+    {
+        for (const std::pair<int, int>& item : heap)
+        {
+            pos[item.second] = -1;
+        }
+        heap.clear();
+    }
+};
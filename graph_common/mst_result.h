@@ -0,0 +1,15 @@
+#pragma once
+
+#include <vector>
+
+#include "csr_graph.h"
+
+// Результат алгоритмов минимального остовного дерева на списке рёбер
+// (параллельный Борувка, Filter-Kruskal). Для несвязного графа - остовный
+// лес: по дереву на каждую компоненту связности.
+struct MSTResult
+{
+    std::vector<WeightedEdge> edges; // Рёбра MST (V - components штук)
+    long long totalWeight = 0;       // Суммарный вес рёбер
+    int components = 0;              // Количество компонент связности графа
+};
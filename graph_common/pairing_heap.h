@@ -0,0 +1,173 @@
+#pragma once
+
+#include <vector>
+
+// ========================================================================
+// ИНДЕКСИРОВАННАЯ PAIRING-КУЧА (Fredman, Sedgewick, Sleator, Tarjan)
+// ========================================================================
+// Куча - дерево с произвольным числом детей, корень - минимум.
+// Узлы - сами элементы 0 .. capacity-1, связи хранятся в массивах
+// (child - первый ребёнок, next - правый брат, prev - левый брат или
+// родитель для первого ребёнка), поэтому после конструктора память
+// не выделяется.
+//
+//   push(v, k)        - новый одиночный узел сливается с корнем: O(1)
+//   decreaseKey(v, k) - поддерево v вырезается и сливается с корнем: O(1)
+//                       (амортизированно o(log n) - дешевле, чем просеивание
+//                       вверх в двоичной куче)
+//   pop()             - корень удаляется, его дети сливаются в два прохода:
+//                       попарно слева направо, затем справа налево;
+//                       O(log n) амортизированно
+//
+// Интерфейс совпадает с IndexedDaryHeap, поэтому обе кучи подходят
+// для одних и тех же шаблонных алгоритмов (Дейкстра, Прим).
+// ========================================================================
+
+class IndexedPairingHeap
+{
+    std::vector<int> key;
+    std::vector<int> child, next, prev;
+    std::vector<char> inHeap;
+    std::vector<int> pairs; // Буфер первого прохода pop (зарезервирован под capacity)
+    int root = -1;
+    std::size_t count = 0;
+
+    // Слить два дерева (корни a и b), вернуть новый корень
+    int meld(int a, int b)
+    {
+        if (key[b] < key[a])
+        {
+            int t = a;
+            a = b;
+            b = t;
+        }
+        // b становится первым ребёнком a
+        next[b] = child[a];
+        if (child[a] != -1)
+            prev[child[a]] = b;
+        prev[b] = a;
+        child[a] = b;
+        return a;
+    }
+
+public:
+    explicit IndexedPairingHeap(int capacity = 0)
+    {
+        resize(capacity);
+    }
+
+    // Изменить количество элементов (куча должна быть пустой)
+    void resize(int capacity)
+    {
+        key.assign(capacity, 0);
+        child.assign(capacity, -1);
+        next.assign(capacity, -1);
+        prev.assign(capacity, -1);
+        inHeap.assign(capacity, 0);
+        pairs.clear();
+        pairs.reserve(capacity);
+        root = -1;
+        count = 0;
+    }
+
+    bool empty() const { return root == -1; }
+    std::size_t size() const { return count; }
+    bool contains(int item) const { return inHeap[item] != 0; }
+
+    int top() const { return root; }
+    int topKey() const { return key[root]; }
+    int keyOf(int item) const { return key[item]; }
+
+    void push(int item, int k)
+    {
+        key[item] = k;
+        child[item] = next[item] = prev[item] = -1;
+        inHeap[item] = 1;
+        count++;
+        root = (root == -1) ? item : meld(root, item);
+    }
+
+    void decreaseKey(int item, int k)
+    {
+        key[item] = k;
+        if (item == root)
+            return;
+        // Вырезаем item из списка братьев (вместе с его поддеревом)
+        int p = prev[item];
+        if (child[p] == item)
+            child[p] = next[item];
+        else
+            next[p] = next[item];
+        if (next[item] != -1)
+            prev[next[item]] = p;
+        next[item] = prev[item] = -1;
+        root = meld(root, item);
+    }
+
+    void pushOrDecrease(int item, int k)
+    {
+        if (contains(item))
+            decreaseKey(item, k);
+        else
+            push(item, k);
+    }
+
+    int pop()
+    {
+        int item = root;
+        inHeap[item] = 0;
+        count--;
+
+        // Проход 1: сливаем детей попарно слева направо
+        pairs.clear();
+        int c = child[item];
+        while (c != -1)
+        {
+            int a = c;
+            int b = next[a];
+            if (b == -1)
+            {
+                next[a] = prev[a] = -1;
+                pairs.push_back(a);
+                break;
+            }
+            c = next[b];
+            next[a] = prev[a] = next[b] = prev[b] = -1;
+            pairs.push_back(meld(a, b));
+        }
+
+        // Проход 2: справа налево сливаем результаты в одно дерево
+        root = -1;
+        for (std::size_t i = pairs.size(); i-- > 0;)
+        {
+            root = (root == -1) ? pairs[i] : meld(root, pairs[i]);
+        }
+        if (root != -1)
+            prev[root] = -1;
+        child[item] = -1;
+        return item;
+    }
+
+    // Очистка за O(size): обход дерева по ссылкам child / next сбрасывает
+    // связи и флаги оставшихся узлов (стек - буфер pairs, он не растёт:
+    // в нём не больше size элементов)
+    void clear()
+    {
+        pairs.clear();
+        if (root != -1)
+            pairs.push_back(root);
+        while (!pairs.empty())
+        {
+            int item = pairs.back();
+            pairs.pop_back();
+            if (child[item] != -1)
+                pairs.push_back(child[item]);
+            if (next[item] != -1)
+                pairs.push_back(next[item]);
+            child[item] = next[item] = prev[item] = -1;
+            inHeap[item] = 0;
+        }
+        root = -1;
+        count = 0;
+    }
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "thread_pool.h"
+
+// ========================================================================
+// ПАРАЛЛЕЛЬНАЯ СОРТИРОВКА СЛИЯНИЕМ
+// ========================================================================
+// 1. Массив делится на куски по числу потоков (округлённому до степени
+//    двойки), каждый кусок сортируется std::sort в своём потоке.
+// 2. Раунды попарного слияния отсортированных кусков через буфер.
+//    Чтобы последние раунды (два огромных куска) не выполнял один поток,
+//    каждое слияние режется на части по выходу ("merge path"): для
+//    позиции k выхода бинарным поиском находится, сколько элементов
+//    взять из левого куска (coRank). Части сливаются независимо.
+//
+// Сортировка устойчивая в пределах слияния (при равенстве левый кусок
+// идёт первым), но std::sort внутри кусков неустойчив - как и std::sort.
+// ========================================================================
+
+// Ниже этого размера накладные расходы на потоки больше выигрыша
+const std::int64_t PARALLEL_SORT_MIN = 1 << 15;
+
+// Сколько элементов из a (длины m) стоит в первых k элементах слияния a и b (длины n)
+template <typename T, typename Compare>
+std::int64_t coRank(std::int64_t k, const T* a, std::int64_t m, const T* b, std::int64_t n, Compare comp)
+{
+    std::int64_t lo = std::max<std::int64_t>(0, k - n);
+    std::int64_t hi = std::min(k, m);
+    while (lo < hi)
+    {
+        std::int64_t i = lo + (hi - lo) / 2;
+        std::int64_t j = k - i;
+        // a[i] > b[j - 1] => из a взято слишком много (или ровно)
+        if (comp(b[j - 1], a[i]))
+            hi = i;
+        else
+            lo = i + 1;
+    }
+    return lo;
+}
+
+template <typename T, typename Compare>
+void parallelSort(T* first, T* last, ThreadPool& pool, Compare comp)
+{
+    const std::int64_t n = last - first;
+    const int threads = pool.threadCount();
+    if (threads == 1 || n < PARALLEL_SORT_MIN)
+    {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    int runs = 1;
+    while (runs < threads)
+        runs *= 2;
+    std::vector<std::int64_t> bounds(runs + 1);
+    for (int r = 0; r <= runs; r++)
+    {
+        bounds[r] = n * r / runs;
+    }
+
+    pool.parallelFor(0, runs, [&](std::int64_t r) {
+        std::sort(first + bounds[r], first + bounds[r + 1], comp);
+    });
+
+    std::vector<T> buffer(static_cast<std::size_t>(n));
+    T* src = first;
+    T* dst = buffer.data();
+
+    while (runs > 1)
+    {
+        // Слияние пар (2p, 2p + 1); каждая пара режется на piecesPerPair частей
+        const int pairs = runs / 2;
+        const int piecesPerPair = std::max(1, 4 * threads / pairs);
+        pool.parallelFor(0, static_cast<std::int64_t>(pairs) * piecesPerPair, [&](std::int64_t task) {
+            int p = static_cast<int>(task / piecesPerPair);
+            int piece = static_cast<int>(task % piecesPerPair);
+            const T* a = src + bounds[2 * p];
+            const T* b = src + bounds[2 * p + 1];
+            std::int64_t m = bounds[2 * p + 1] - bounds[2 * p];
+            std::int64_t len = bounds[2 * p + 2] - bounds[2 * p + 1];
+            std::int64_t k0 = (m + len) * piece / piecesPerPair;
+            std::int64_t k1 = (m + len) * (piece + 1) / piecesPerPair;
+            std::int64_t i0 = coRank(k0, a, m, b, len, comp);
+            std::int64_t i1 = coRank(k1, a, m, b, len, comp);
+            std::merge(a + i0, a + i1, b + (k0 - i0), b + (k1 - i1), dst + bounds[2 * p] + k0, comp);
+        });
+
+        for (int p = 0; p <= pairs; p++)
+        {
+            bounds[p] = bounds[2 * p];
+        }
+        bounds.resize(pairs + 1);
+        runs = pairs;
+        std::swap(src, dst);
+    }
+
+    if (src != first)
+    {
+        const std::int64_t block = 1 << 16;
+        pool.parallelFor(0, (n + block - 1) / block, [&](std::int64_t b) {
+            std::copy(src + b * block, src + std::min(n, (b + 1) * block), first + b * block);
+        });
+    }
+}
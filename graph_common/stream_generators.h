@@ -0,0 +1,613 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "csr_graph.h"
+#include "graph_generators.h"
+#include "graph_io.h"
+#include "thread_pool.h"
+
+// ========================================================================
+// ПОТОКОВЫЕ ГЕНЕРАТОРЫ ГРАФОВ
+// ========================================================================
+// generateRMAT / generateRoadGrid (graph_generators.h) строят граф в
+// памяти - миллиарды рёбер туда не помещаются. Здесь генератор выдаёт
+// рёбра БЛОКАМИ, и каждый блок можно построить независимо и повторно:
+//
+//   int vertexCount() const
+//   std::int64_t blockCount() const
+//   void generateBlock(block, emit) const   // emit(u, v, w) для рёбер блока
+//   bool undirected                          // каждое ребро - в обе стороны
+//
+// Генератор случайных чисел блока инициализируется от (seed, номер
+// блока) - счётчиковая схема: граф зависит только от seed, но не от
+// числа потоков и не от порядка обработки блоков. Используется свой
+// SplitMix64, а не std::*_distribution: их результаты различаются между
+// реализациями стандартной библиотеки.
+//
+// Генераторы:
+//   RMATStream      - R-MAT; scrambleIds = перестановка номеров вершин
+//                     (Kronecker-граф Graph500: хабы не скучены у нуля)
+//   ErdosRenyiStream - G(n, m): m рёбер с равновероятными концами
+//   GridStream      - дорожная решётка как generateRoadGrid, но координаты
+//                     вершины - функция (seed, v), а не массив
+//   GeometricStream - случайный геометрический граф: n точек в единичном
+//                     квадрате, рёбра между точками ближе радиуса
+//
+// Запись (память O(V), не O(E)):
+//   writeEdgeListStream  - текст SNAP / DIMACS: блоки пачками строятся
+//                          параллельно и дописываются по порядку
+//   writeBinaryCSRStream - двоичный CSR (формат loadBinaryCSR):
+//                          проход 1 считает рёбра в разделах вершин;
+//                          затем разделы группируются так, чтобы их рёбра
+//                          поместились в буфер, и для каждой группы все
+//                          блоки генерируются заново, а в буфер попадают
+//                          только её рёбра. Рёбра вершины сортируются -
+//                          файл не зависит от числа потоков.
+// ========================================================================
+
+struct SplitMix64
+{
+    std::uint64_t state;
+
+    explicit SplitMix64(std::uint64_t seed) : state(seed) {}
+
+    std::uint64_t next()
+    {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // [0, 1)
+    double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+    // [0, n)
+    std::int64_t below(std::int64_t n) { return static_cast<std::int64_t>(uniform() * static_cast<double>(n)); }
+};
+
+// Независимая последовательность для подпотока stream генератора seed
+inline std::uint64_t streamSeed(std::uint64_t seed, std::uint64_t stream)
+{
+    SplitMix64 mix(seed ^ (stream * 0xD1B54A32D192ED03ULL));
+    return mix.next();
+}
+
+// Рёбер в блоке R-MAT и Эрдёша-Реньи
+const std::int64_t STREAM_BLOCK_EDGES = 1 << 16;
+
+// ------------------------------------------------------------------------
+// R-MAT / KRONECKER
+// ------------------------------------------------------------------------
+class RMATStream
+{
+    int scale;
+    std::int64_t numEdges;
+    std::uint64_t seed;
+    int maxWeight;
+    bool scramble;
+    RMATParams params;
+
+    // Биекция на [0, 2^scale): умножение на нечётное и xorshift обратимы
+    int permute(std::uint64_t x) const
+    {
+        const std::uint64_t mask = (1ULL << scale) - 1;
+        const int shift = (scale + 1) / 2;
+        x = (x * 0x9E3779B97F4A7C15ULL + seed) & mask;
+        x ^= x >> shift;
+        x = (x * 0xC2B2AE3D27D4EB4FULL) & mask;
+        x ^= x >> shift;
+        return static_cast<int>(x);
+    }
+
+public:
+    bool undirected = false;
+
+    RMATStream(int graphScale, int edgeFactor, std::uint64_t randomSeed, int maxEdgeWeight = 1,
+               bool scrambleIds = false, const RMATParams& p = RMATParams())
+        : scale(graphScale), numEdges(static_cast<std::int64_t>(edgeFactor) << graphScale), seed(randomSeed),
+          maxWeight(maxEdgeWeight), scramble(scrambleIds), params(p)
+    {
+        if (scale < 1 || scale > 30 || edgeFactor < 1 || maxWeight < 1)
+            throw std::invalid_argument("RMATStream: scale в [1, 30], edgeFactor и maxWeight >= 1");
+    }
+
+    int vertexCount() const { return 1 << scale; }
+    std::int64_t blockCount() const { return (numEdges + STREAM_BLOCK_EDGES - 1) / STREAM_BLOCK_EDGES; }
+
+    template <typename Emit>
+    void generateBlock(std::int64_t block, Emit&& emit) const
+    {
+        // Квадрант выбирается по 16 случайным битам (четыре уровня на одно
+        // число SplitMix64) сравнением с порогами - без ветвлений
+        const std::uint64_t ta = static_cast<std::uint64_t>(params.a * 65536);
+        const std::uint64_t tab = static_cast<std::uint64_t>((params.a + params.b) * 65536);
+        const std::uint64_t tabc = static_cast<std::uint64_t>((params.a + params.b + params.c) * 65536);
+        SplitMix64 rng(streamSeed(seed, static_cast<std::uint64_t>(block)));
+        const std::int64_t first = block * STREAM_BLOCK_EDGES;
+        const std::int64_t last = std::min(numEdges, first + STREAM_BLOCK_EDGES);
+        for (std::int64_t i = first; i < last; i++)
+        {
+            std::uint64_t u = 0, v = 0;
+            std::uint64_t bits = 0;
+            for (int bit = 0; bit < scale; bit++)
+            {
+                if (bit % 4 == 0)
+                    bits = rng.next();
+                const std::uint64_t r = bits & 0xFFFF;
+                bits >>= 16;
+                // r < a: (0, 0); < a + b: (0, 1); < a + b + c: (1, 0); иначе (1, 1)
+                u = (u << 1) | (r >= tab);
+                v = (v << 1) | ((r >= ta) & (r < tab)) | (r >= tabc);
+            }
+            int w = 1 + static_cast<int>(rng.below(maxWeight));
+            if (scramble)
+                emit(permute(u), permute(v), w);
+            else
+                emit(static_cast<int>(u), static_cast<int>(v), w);
+        }
+    }
+};
+
+// ------------------------------------------------------------------------
+// ЭРДЁШ-РЕНЬИ G(n, m)
+// ------------------------------------------------------------------------
+// Концы ребра равновероятны, петель нет (v выбирается среди n - 1 вершин,
+// отличных от u). Кратные рёбра возможны, но при m << n² их ничтожно мало.
+class ErdosRenyiStream
+{
+    int numVertices;
+    std::int64_t numEdges;
+    std::uint64_t seed;
+    int maxWeight;
+
+public:
+    bool undirected = false;
+
+    ErdosRenyiStream(int vertices, std::int64_t edges, std::uint64_t randomSeed, int maxEdgeWeight = 1)
+        : numVertices(vertices), numEdges(edges), seed(randomSeed), maxWeight(maxEdgeWeight)
+    {
+        if (numVertices < 2 || numEdges < 0 || maxWeight < 1)
+            throw std::invalid_argument("ErdosRenyiStream: нужно >= 2 вершин, edges >= 0, maxWeight >= 1");
+    }
+
+    int vertexCount() const { return numVertices; }
+    std::int64_t blockCount() const { return (numEdges + STREAM_BLOCK_EDGES - 1) / STREAM_BLOCK_EDGES; }
+
+    template <typename Emit>
+    void generateBlock(std::int64_t block, Emit&& emit) const
+    {
+        SplitMix64 rng(streamSeed(seed, static_cast<std::uint64_t>(block)));
+        const std::int64_t first = block * STREAM_BLOCK_EDGES;
+        const std::int64_t last = std::min(numEdges, first + STREAM_BLOCK_EDGES);
+        for (std::int64_t i = first; i < last; i++)
+        {
+            int u = static_cast<int>(rng.below(numVertices));
+            int v = static_cast<int>((u + 1 + rng.below(numVertices - 1)) % numVertices);
+            emit(u, v, 1 + static_cast<int>(rng.below(maxWeight)));
+        }
+    }
+};
+
+// ------------------------------------------------------------------------
+// ДОРОЖНАЯ РЕШЁТКА
+// ------------------------------------------------------------------------
+// Та же модель, что generateRoadGrid: шаг 100 м, сдвиг +-30%, извилистость
+// [1, 1.5], шоссе на каждой highwayEvery-й линии. Блок - строка решётки:
+// её рёбра вправо и вниз. Неориентированный граф.
+class GridStream
+{
+    int side;
+    std::uint64_t seed;
+    int highwayEvery;
+
+    void position(int v, double& x, double& y) const
+    {
+        SplitMix64 rng(streamSeed(seed, static_cast<std::uint64_t>(v)));
+        x = (v % side + 0.6 * rng.uniform() - 0.3) * 100.0;
+        y = (v / side + 0.6 * rng.uniform() - 0.3) * 100.0;
+    }
+
+public:
+    bool undirected = true;
+
+    GridStream(int gridSide, std::uint64_t randomSeed, int highwayLine = 0)
+        : side(gridSide), seed(randomSeed), highwayEvery(highwayLine)
+    {
+        if (side < 1 || static_cast<std::int64_t>(side) * side > INT32_MAX)
+            throw std::invalid_argument("GridStream: side * side должно помещаться в int");
+    }
+
+    int vertexCount() const { return side * side; }
+    std::int64_t blockCount() const { return side; }
+
+    template <typename Emit>
+    void generateBlock(std::int64_t row, Emit&& emit) const
+    {
+        // Свой подпоток для весов строки (номера >= V заняты не будут: V < 2^31)
+        SplitMix64 rng(streamSeed(seed, (1ULL << 32) + static_cast<std::uint64_t>(row)));
+        auto isHighway = [this](std::int64_t line) { return highwayEvery > 0 && line % highwayEvery == 0; };
+        auto road = [&](int a, int b, bool highway) {
+            double ax, ay, bx, by;
+            position(a, ax, ay);
+            position(b, bx, by);
+            double length = std::hypot(ax - bx, ay - by) * (1.0 + 0.5 * rng.uniform());
+            if (highway)
+                length /= HIGHWAY_SPEEDUP;
+            emit(a, b, static_cast<int>(std::ceil(length)));
+        };
+        for (int c = 0; c < side; c++)
+        {
+            int v = static_cast<int>(row) * side + c;
+            if (c + 1 < side)
+                road(v, v + 1, isHighway(row));
+            if (row + 1 < side)
+                road(v, v + side, isHighway(c));
+        }
+    }
+};
+
+// ------------------------------------------------------------------------
+// СЛУЧАЙНЫЙ ГЕОМЕТРИЧЕСКИЙ ГРАФ
+// ------------------------------------------------------------------------
+// n точек равномерно в единичном квадрате, ребро - между точками на
+// расстоянии не больше r, где r подобран под среднюю степень:
+// pi * r² * n = averageDegree. Вес - расстояние в тысячных долях r
+// (от 1 до 1000).
+//
+// Квадрат делится на клетки со стороной >= r: соседи точки лежат в её
+// клетке и восьми соседних. Вершины перенумерованы по клеткам (строка за
+// строкой), поэтому близкие точки имеют близкие номера. Точки хранятся в
+// памяти - O(V), блок - строка клеток.
+class GeometricStream
+{
+    int numVertices;
+    int cells; // Клеток по стороне
+    double radius;
+    std::vector<double> x, y;          // Координаты в порядке новой нумерации
+    std::vector<std::int64_t> cellStart; // Вершины клетки c - [cellStart[c], cellStart[c + 1])
+
+public:
+    bool undirected = true;
+
+    GeometricStream(int vertices, double averageDegree, std::uint64_t seed)
+        : numVertices(vertices)
+    {
+        if (numVertices < 1 || averageDegree <= 0)
+            throw std::invalid_argument("GeometricStream: нужны vertices >= 1 и averageDegree > 0");
+        radius = std::sqrt(averageDegree / (std::acos(-1.0) * numVertices));
+        // Клеток не больше, чем вершин (иначе cellStart больше самого графа)
+        cells = std::max(1, std::min(static_cast<int>(1.0 / radius), static_cast<int>(std::sqrt(numVertices)) + 1));
+
+        // Точки и сортировка подсчётом по клеткам
+        std::vector<double> px(numVertices), py(numVertices);
+        std::vector<int> cellOf(numVertices);
+        cellStart.assign(static_cast<std::size_t>(cells) * cells + 1, 0);
+        for (int v = 0; v < numVertices; v++)
+        {
+            SplitMix64 rng(streamSeed(seed, static_cast<std::uint64_t>(v)));
+            px[v] = rng.uniform();
+            py[v] = rng.uniform();
+            int cx = std::min(cells - 1, static_cast<int>(px[v] * cells));
+            int cy = std::min(cells - 1, static_cast<int>(py[v] * cells));
+            cellOf[v] = cy * cells + cx;
+            cellStart[cellOf[v] + 1]++;
+        }
+        for (std::size_t c = 1; c < cellStart.size(); c++)
+            cellStart[c] += cellStart[c - 1];
+        x.resize(numVertices);
+        y.resize(numVertices);
+        std::vector<std::int64_t> next(cellStart.begin(), cellStart.end() - 1);
+        for (int v = 0; v < numVertices; v++)
+        {
+            std::int64_t pos = next[cellOf[v]]++;
+            x[pos] = px[v];
+            y[pos] = py[v];
+        }
+    }
+
+    int vertexCount() const { return numVertices; }
+    std::int64_t blockCount() const { return cells; }
+
+    template <typename Emit>
+    void generateBlock(std::int64_t cellRow, Emit&& emit) const
+    {
+        const double r2 = radius * radius;
+        auto connect = [&](std::int64_t u, std::int64_t v) {
+            double dx = x[u] - x[v], dy = y[u] - y[v];
+            double d2 = dx * dx + dy * dy;
+            if (d2 <= r2)
+            {
+                int w = std::max(1, static_cast<int>(std::ceil(1000.0 * std::sqrt(d2) / radius)));
+                emit(static_cast<int>(u), static_cast<int>(v), w);
+            }
+        };
+        const int cy = static_cast<int>(cellRow);
+        for (int cx = 0; cx < cells; cx++)
+        {
+            const std::int64_t c = static_cast<std::int64_t>(cy) * cells + cx;
+            for (std::int64_t u = cellStart[c]; u < cellStart[c + 1]; u++)
+            {
+                // Своя клетка - пары u < v; соседние - только "вперёд"
+                // (справа и строка ниже), чтобы каждая пара встретилась один раз
+                for (std::int64_t v = u + 1; v < cellStart[c + 1]; v++)
+                    connect(u, v);
+                const int forward[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+                for (const auto& d : forward)
+                {
+                    int nx = cx + d[0], ny = cy + d[1];
+                    if (nx < 0 || nx >= cells || ny >= cells)
+                        continue;
+                    const std::int64_t n = static_cast<std::int64_t>(ny) * cells + nx;
+                    for (std::int64_t v = cellStart[n]; v < cellStart[n + 1]; v++)
+                        connect(u, v);
+                }
+            }
+        }
+    }
+};
+
+// ========================================================================
+// ЗАПИСЬ И СБОР
+// ========================================================================
+
+// Буфер writeBinaryCSRStream по умолчанию: 2^27 рёбер (2 ГБ)
+const std::int64_t STREAM_BUFFER_EDGES = 1LL << 27;
+
+// Все рёбра в памяти (для графов, которые в неё помещаются)
+template <typename Generator>
+EdgeList collectEdges(const Generator& gen, ThreadPool& pool)
+{
+    std::vector<std::vector<WeightedEdge>> parts(static_cast<std::size_t>(gen.blockCount()));
+    pool.parallelFor(0, gen.blockCount(), [&](std::int64_t b) {
+        gen.generateBlock(b, [&](int u, int v, int w) { parts[b].push_back({u, v, w}); });
+    });
+    EdgeList result;
+    result.vertexCount = gen.vertexCount();
+    std::size_t total = 0;
+    for (const auto& part : parts)
+        total += part.size();
+    result.edges.reserve(total);
+    for (auto& part : parts)
+    {
+        result.edges.insert(result.edges.end(), part.begin(), part.end());
+        std::vector<WeightedEdge>().swap(part);
+    }
+    return result;
+}
+
+// Текстовый список рёбер (SNAP или DIMACS), ребро - как его выдал
+// генератор (неориентированное - один раз). Возвращает число рёбер.
+template <typename Generator>
+std::int64_t writeEdgeListStream(const Generator& gen, const std::string& path, EdgeListFormat format,
+                                 ThreadPool& pool)
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+        throw std::runtime_error("writeEdgeListStream: не удалось открыть " + path);
+
+    const bool dimacs = format == EdgeListFormat::DIMACS;
+    std::streampos countPos;
+    if (dimacs)
+    {
+        // Число рёбер заранее неизвестно: место под него, дописываем в конце
+        out << "c generated\np sp " << gen.vertexCount() << ' ';
+        countPos = out.tellp();
+        out << std::string(20, ' ') << '\n';
+    }
+    else
+    {
+        out << "# vertices " << gen.vertexCount() << (gen.undirected ? " undirected\n" : " directed\n");
+    }
+
+    const std::int64_t batch = 4 * static_cast<std::int64_t>(pool.threadCount());
+    std::vector<std::string> text(static_cast<std::size_t>(batch));
+    std::vector<std::int64_t> counts(static_cast<std::size_t>(batch));
+    std::int64_t total = 0;
+    for (std::int64_t first = 0; first < gen.blockCount(); first += batch)
+    {
+        const std::int64_t n = std::min(batch, gen.blockCount() - first);
+        pool.parallelFor(0, n, [&](std::int64_t i) {
+            std::string& s = text[i];
+            s.clear();
+            counts[i] = 0;
+            gen.generateBlock(first + i, [&](int u, int v, int w) {
+                char line[48];
+                char* p = line;
+                if (dimacs)
+                {
+                    *p++ = 'a';
+                    *p++ = ' ';
+                    u++; // DIMACS нумерует вершины с 1
+                    v++;
+                }
+                p = std::to_chars(p, line + sizeof(line), u).ptr;
+                *p++ = ' ';
+                p = std::to_chars(p, line + sizeof(line), v).ptr;
+                *p++ = ' ';
+                p = std::to_chars(p, line + sizeof(line), w).ptr;
+                *p++ = '\n';
+                s.append(line, p);
+                counts[i]++;
+            });
+        });
+        for (std::int64_t i = 0; i < n; i++)
+        {
+            out.write(text[i].data(), static_cast<std::streamsize>(text[i].size()));
+            total += counts[i];
+        }
+    }
+
+    if (dimacs)
+    {
+        out.seekp(countPos);
+        out << total;
+    }
+    if (!out)
+        throw std::runtime_error("writeEdgeListStream: ошибка записи " + path);
+    return total;
+}
+
+// Вершины делятся на разделы по 2^shift подряд (не больше STREAM_PARTITIONS
+// разделов). Рёбра раздела лежат в буфере подряд, поэтому раскладка по
+// вершинам идёт внутри кэша, а не случайной записью по всему буферу.
+const int STREAM_PARTITIONS = 4096;
+
+// Двоичный CSR без хранения всех рёбер: память O(V + bufferEdges),
+// 16 байт на ребро буфера. Возвращает число записей CSR (для
+// неориентированного графа - удвоенное число рёбер).
+template <typename Generator>
+std::int64_t writeBinaryCSRStream(const Generator& gen, const std::string& path, ThreadPool& pool,
+                                  std::int64_t bufferEdges = STREAM_BUFFER_EDGES)
+{
+    const int V = gen.vertexCount();
+    const std::int64_t blocks = gen.blockCount();
+    const bool symmetric = gen.undirected;
+    int shift = 0;
+    while (((V - 1) >> shift) + 1 > STREAM_PARTITIONS)
+        shift++;
+    const int P = ((V - 1) >> shift) + 1;
+
+    auto forEachArc = [&](std::int64_t block, auto&& arc) {
+        gen.generateBlock(block, [&](int u, int v, int w) {
+            arc(u, v, w);
+            if (symmetric)
+                arc(v, u, w);
+        });
+    };
+
+    // Проход 1: число рёбер в каждом разделе
+    std::vector<std::atomic<std::int64_t>> partCursor(P);
+    for (auto& c : partCursor)
+        c.store(0, std::memory_order_relaxed);
+    pool.parallelFor(0, blocks, [&](std::int64_t b) {
+        std::vector<std::int64_t> local(P, 0);
+        forEachArc(b, [&](int u, int, int) { local[u >> shift]++; });
+        for (int p = 0; p < P; p++)
+        {
+            if (local[p] != 0)
+                partCursor[p].fetch_add(local[p], std::memory_order_relaxed);
+        }
+    });
+    std::vector<std::int64_t> partStart(static_cast<std::size_t>(P) + 1, 0);
+    for (int p = 0; p < P; p++)
+        partStart[p + 1] = partStart[p] + partCursor[p].load(std::memory_order_relaxed);
+    const std::int64_t E = partStart[P];
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+        throw std::runtime_error("writeBinaryCSRStream: не удалось открыть " + path);
+    BinaryCSRHeader header;
+    std::memcpy(header.magic, BINARY_CSR_MAGIC, 8);
+    header.version = BINARY_CSR_VERSION;
+    header.flags = 0;
+    header.vertices = V;
+    header.edges = E;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    std::vector<std::int64_t> offsets(static_cast<std::size_t>(V) + 1, 0); // Записываются в конце
+    const std::int64_t targetsPos = static_cast<std::int64_t>(sizeof(header) + offsets.size() * sizeof(std::int64_t));
+    const std::int64_t weightsPos = targetsPos + E * static_cast<std::int64_t>(sizeof(int));
+
+    // Проходы по группам разделов [first, last), рёбра которых помещаются в буфер
+    std::vector<WeightedEdge> staging;
+    std::vector<int> column;
+    for (int first = 0; first < P;)
+    {
+        int last = first + 1; // Раздел больше буфера - отдельным проходом
+        while (last < P && partStart[last + 1] - partStart[first] <= bufferEdges)
+            last++;
+        const std::int64_t base = partStart[first];
+        const std::int64_t count = partStart[last] - base;
+        staging.resize(static_cast<std::size_t>(count));
+        for (int p = first; p < last; p++)
+            partCursor[p].store(partStart[p] - base, std::memory_order_relaxed);
+
+        // Блок раскладывает свои рёбра по разделам локально и дописывает
+        // каждый раздел одним куском
+        const int lo = first << shift;
+        const int hi = last == P ? V : (last << shift);
+        pool.parallelFor(0, blocks, [&](std::int64_t b) {
+            std::vector<WeightedEdge> arcs;
+            forEachArc(b, [&](int u, int v, int w) {
+                if (u >= lo && u < hi)
+                    arcs.push_back({u, v, w});
+            });
+            std::vector<std::int64_t> runStart(static_cast<std::size_t>(last - first) + 1, 0);
+            for (const WeightedEdge& a : arcs)
+                runStart[(a.source >> shift) - first + 1]++;
+            for (std::size_t p = 1; p < runStart.size(); p++)
+                runStart[p] += runStart[p - 1];
+            std::vector<WeightedEdge> sorted(arcs.size());
+            std::vector<std::int64_t> next(runStart.begin(), runStart.end() - 1);
+            for (const WeightedEdge& a : arcs)
+                sorted[next[(a.source >> shift) - first]++] = a;
+            for (int p = first; p < last; p++)
+            {
+                std::int64_t n = runStart[p - first + 1] - runStart[p - first];
+                if (n == 0)
+                    continue;
+                std::int64_t pos = partCursor[p].fetch_add(n, std::memory_order_relaxed);
+                std::copy(sorted.begin() + runStart[p - first], sorted.begin() + runStart[p - first + 1],
+                          staging.begin() + pos);
+            }
+        });
+
+        // Внутри раздела: сортировка подсчётом по вершине, затем рёбра
+        // вершины по (цель, вес) - порядок не зависит от потоков
+        pool.parallelFor(first, last, [&](std::int64_t p) {
+            WeightedEdge* arcs = staging.data() + (partStart[p] - base);
+            const std::int64_t n = partStart[p + 1] - partStart[p];
+            const int vBegin = static_cast<int>(p) << shift;
+            const int vEnd = std::min(V, vBegin + (1 << shift));
+            std::vector<std::int64_t> start(static_cast<std::size_t>(vEnd - vBegin) + 1, 0);
+            for (std::int64_t i = 0; i < n; i++)
+                start[arcs[i].source - vBegin + 1]++;
+            for (std::size_t i = 1; i < start.size(); i++)
+                start[i] += start[i - 1];
+            for (int v = vBegin; v < vEnd; v++)
+                offsets[v] = partStart[p] + start[v - vBegin];
+
+            std::vector<WeightedEdge> sorted(static_cast<std::size_t>(n));
+            std::vector<std::int64_t> next(start.begin(), start.end() - 1);
+            for (std::int64_t i = 0; i < n; i++)
+                sorted[next[arcs[i].source - vBegin]++] = arcs[i];
+            for (int v = vBegin; v < vEnd; v++)
+            {
+                std::sort(sorted.begin() + start[v - vBegin], sorted.begin() + start[v - vBegin + 1],
+                          [](const WeightedEdge& a, const WeightedEdge& b) {
+                              return a.destination != b.destination ? a.destination < b.destination
+                                                                    : a.weight < b.weight;
+                          });
+            }
+            std::copy(sorted.begin(), sorted.end(), arcs);
+        });
+
+        column.resize(static_cast<std::size_t>(count));
+        for (std::int64_t i = 0; i < count; i++)
+            column[i] = staging[i].destination;
+        out.seekp(targetsPos + base * static_cast<std::int64_t>(sizeof(int)));
+        out.write(reinterpret_cast<const char*>(column.data()), static_cast<std::streamsize>(count * sizeof(int)));
+        for (std::int64_t i = 0; i < count; i++)
+            column[i] = staging[i].weight;
+        out.seekp(weightsPos + base * static_cast<std::int64_t>(sizeof(int)));
+        out.write(reinterpret_cast<const char*>(column.data()), static_cast<std::streamsize>(count * sizeof(int)));
+        first = last;
+    }
+
+    offsets[V] = E;
+    out.seekp(sizeof(header));
+    out.write(reinterpret_cast<const char*>(offsets.data()),
+              static_cast<std::streamsize>(offsets.size() * sizeof(std::int64_t)));
+    if (!out)
+        throw std::runtime_error("writeBinaryCSRStream: ошибка записи " + path);
+    return E;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+
+// ========================================================================
+// ВЫРАВНИВАНИЕ СТОЛБЦОВ С РУССКИМ ТЕКСТОМ (таблицы бенчмарков)
+// ========================================================================
+// std::setw считает байты, а русская буква в UTF-8 занимает два: строка
+// с кириллицей получает меньше пробелов, и столбцы съезжают. Здесь
+// ширина считается в символах - байты 10xxxxxx продолжают символ и не
+// считаются. Числа по-прежнему выводятся через std::setw.
+// ========================================================================
+
+// Число символов UTF-8 в строке
+inline int displayWidth(const std::string& text)
+{
+    int symbols = 0;
+    for (char c : text)
+    {
+        if ((c & 0xC0) != 0x80)
+            symbols++;
+    }
+    return symbols;
+}
+
+// Текст и пробелы справа до width символов (аналог std::left << std::setw)
+inline std::string alignLeft(const std::string& text, int width)
+{
+    return text + std::string(std::max(0, width - displayWidth(text)), ' ');
+}
+
+// Пробелы слева и текст (аналог std::right << std::setw)
+inline std::string alignRight(const std::string& text, int width)
+{
+    return std::string(std::max(0, width - displayWidth(text)), ' ') + text;
+}
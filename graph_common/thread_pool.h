@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ========================================================================
+// ПУЛ ПОТОКОВ ДЛЯ ПАРАЛЛЕЛЬНЫХ ЦИКЛОВ (fork-join)
+// ========================================================================
+// Параллельным графовым алгоритмам нужна одна операция: "выполнить тело
+// цикла для индексов [begin, end) на всех ядрах и дождаться окончания".
+// Создавать std::thread на каждый такой цикл дорого (десятки микросекунд),
+// а блочный Флойд-Уоршелл, например, выполняет тысячи коротких фаз.
+//
+// Поэтому потоки создаются один раз, а parallelFor:
+//   1. публикует задачу и будит рабочие потоки
+//   2. вызывающий поток тоже берёт куски работы (итого threadCount() потоков)
+//   3. индексы раздаются кусками по grain через atomic fetch_add -
+//      быстрые потоки забирают больше кусков (динамическая балансировка)
+//   4. parallelFor возвращается, когда все потоки закончили
+//
+// Тело цикла не должно бросать исключения.
+// ========================================================================
+
+class ThreadPool
+{
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeCondition; // Появилась новая задача
+    std::condition_variable doneCondition; // Все рабочие потоки закончили
+
+    std::function<void(std::int64_t)> job; // Тело цикла текущей задачи
+    std::atomic<std::int64_t> nextIndex;   // Следующий нераздатый индекс
+    std::int64_t jobEnd;
+    std::int64_t jobGrain;
+    std::uint64_t generation; // Номер задачи (рабочий поток ждёт его изменения)
+    int busyWorkers;          // Сколько рабочих потоков ещё выполняют задачу
+    bool stopping;
+
+    void runChunks()
+    {
+        while (true)
+        {
+            std::int64_t first = nextIndex.fetch_add(jobGrain, std::memory_order_relaxed);
+            if (first >= jobEnd)
+                break;
+            std::int64_t last = std::min(first + jobGrain, jobEnd);
+            for (std::int64_t i = first; i < last; i++)
+            {
+                job(i);
+            }
+        }
+    }
+
+    void workerLoop()
+    {
+        std::uint64_t seen = 0;
+        while (true)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+            lock.unlock();
+
+            runChunks();
+
+            lock.lock();
+            if (--busyWorkers == 0)
+                doneCondition.notify_one();
+        }
+    }
+
+public:
+    // threads - общее число потоков, включая вызывающий (0 = по числу ядер)
+    explicit ThreadPool(int threads = 0)
+        : nextIndex(0), jobEnd(0), jobGrain(1), generation(0), busyWorkers(0), stopping(false)
+    {
+        if (threads <= 0)
+            threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        for (int t = 1; t < threads; t++)
+        {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeCondition.notify_all();
+        for (std::thread& t : workers)
+        {
+            t.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int threadCount() const { return static_cast<int>(workers.size()) + 1; }
+
+    // Выполнить body(i) для всех i из [begin, end), раздавая индексы кусками по grain
+    void parallelFor(std::int64_t begin, std::int64_t end, const std::function<void(std::int64_t)>& body,
+                     std::int64_t grain = 1)
+    {
+        if (begin >= end)
+            return;
+        if (workers.empty() || end - begin <= grain)
+        {
+            for (std::int64_t i = begin; i < end; i++)
+            {
+                body(i);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = body;
+            nextIndex.store(begin, std::memory_order_relaxed);
+            jobEnd = end;
+            jobGrain = std::max<std::int64_t>(1, grain);
+            busyWorkers = static_cast<int>(workers.size());
+            generation++;
+        }
+        wakeCondition.notify_all();
+
+        runChunks();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCondition.wait(lock, [&]() { return busyWorkers == 0; });
+        job = nullptr;
+    }
+
+    // Индекс потока для per-thread буферов: 0 - вызывающий, 1.. - рабочие
+    // (вычисляется по std::this_thread::get_id, O(число потоков))
+    int currentThreadIndex() const
+    {
+        std::thread::id self = std::this_thread::get_id();
+        for (std::size_t t = 0; t < workers.size(); t++)
+        {
+            if (workers[t].get_id() == self)
+                return static_cast<int>(t) + 1;
+        }
+        return 0;
+    }
+};
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+// ========================================================================
+// СИСТЕМА НЕПЕРЕСЕКАЮЩИХСЯ МНОЖЕСТВ (DSU, Union-Find)
+// ========================================================================
+// UnionFind из simple_kruskal.cxx / simple_boruvka.cxx написан для
+// наглядности: рекурсивный find, отдельные массивы parent и rank,
+// проверки verbose внутри unite. Здесь - компактная версия для быстрых
+// алгоритмов:
+//
+//   - ОДИН массив int: parentOrSize[x] >= 0 - родитель x,
+//                      parentOrSize[x] <  0 - x корень, -parentOrSize[x] - размер
+//     (вдвое меньше памяти и одна кэш-линия на обращение вместо двух)
+//   - union by size: меньшее дерево подвешивается под большее
+//   - find итеративный, с ПОЛОВИНЕНИЕМ пути: каждая вершина на пути
+//     перевешивается на дедушку - один проход, без рекурсии и стека
+//   - количество множеств поддерживается при unite (без прохода по V)
+//
+// Пример (4 элемента после unite(0, 1) и unite(2, 1)):
+//   parentOrSize = [-3, 0, 0, -1]   => {0, 1, 2} с корнем 0 и {3}
+// ========================================================================
+
+class DSU
+{
+    std::vector<int> parentOrSize;
+    int sets;
+
+public:
+    explicit DSU(int n = 0) : parentOrSize(n, -1), sets(n) {}
+
+    // Снова n одиночных множеств (память переиспользуется)
+    void reset(int n)
+    {
+        parentOrSize.assign(n, -1);
+        sets = n;
+    }
+
+    int size() const { return static_cast<int>(parentOrSize.size()); }
+    int setCount() const { return sets; }
+
+    int find(int x)
+    {
+        while (parentOrSize[x] >= 0)
+        {
+            int parent = parentOrSize[x];
+            if (parentOrSize[parent] >= 0)
+                parentOrSize[x] = parentOrSize[parent]; // Половинение пути
+            x = parentOrSize[x];
+        }
+        return x;
+    }
+
+    // Корень без изменения структуры: можно вызывать из нескольких потоков
+    // одновременно, пока никто не вызывает find/unite
+    int root(int x) const
+    {
+        while (parentOrSize[x] >= 0)
+            x = parentOrSize[x];
+        return x;
+    }
+
+    // true - если множества были разными и объединены
+    bool unite(int x, int y)
+    {
+        x = find(x);
+        y = find(y);
+        if (x == y)
+            return false;
+        if (parentOrSize[x] > parentOrSize[y]) // Размеры отрицательные: x меньше y
+            std::swap(x, y);
+        parentOrSize[x] += parentOrSize[y];
+        parentOrSize[y] = x;
+        sets--;
+        return true;
+    }
+
+    bool same(int x, int y) { return find(x) == find(y); }
+
+    int setSize(int x) { return -parentOrSize[find(x)]; }
+};
+
+// ========================================================================
+// DSU С ОТКАТОМ
+// ========================================================================
+// Для офлайн-задач динамической связности (рёбра появляются и исчезают,
+// запросы обрабатываются обходом дерева отрезков по времени) нужно
+// отменять объединения в обратном порядке. Сжатие путей здесь запрещено -
+// его нельзя откатить дёшево, поэтому find работает за O(log n) только
+// благодаря union by size. Каждое удачное unite запоминает
+// (присоединённый корень, его прежний размер); rollback(snapshot)
+// снимает записи до сохранённой длины журнала.
+//
+//   int s = dsu.snapshot();
+//   dsu.unite(a, b);
+//   ...
+//   dsu.rollback(s); // структура как до unite
+// ========================================================================
+
+class RollbackDSU
+{
+    std::vector<int> parentOrSize;
+    std::vector<std::pair<int, int>> history; // (присоединённый корень, его прежнее значение)
+    int sets;
+
+public:
+    explicit RollbackDSU(int n = 0) : parentOrSize(n, -1), sets(n)
+    {
+        history.reserve(n); // Удачных unite без отката не больше n - 1
+    }
+
+    void reset(int n)
+    {
+        parentOrSize.assign(n, -1);
+        history.clear();
+        sets = n;
+    }
+
+    int size() const { return static_cast<int>(parentOrSize.size()); }
+    int setCount() const { return sets; }
+
+    int find(int x) const
+    {
+        while (parentOrSize[x] >= 0)
+            x = parentOrSize[x];
+        return x;
+    }
+
+    bool unite(int x, int y)
+    {
+        x = find(x);
+        y = find(y);
+        if (x == y)
+            return false;
+        if (parentOrSize[x] > parentOrSize[y])
+            std::swap(x, y);
+        history.push_back({y, parentOrSize[y]});
+        parentOrSize[x] += parentOrSize[y];
+        parentOrSize[y] = x;
+        sets--;
+        return true;
+    }
+
+    bool same(int x, int y) const { return find(x) == find(y); }
+
+    int setSize(int x) const { return -parentOrSize[find(x)]; }
+
+    // Текущая точка журнала
+    int snapshot() const { return static_cast<int>(history.size()); }
+
+    // Отменить все объединения после snapshot (в обратном порядке)
+    void rollback(int snapshot)
+    {
+        while (static_cast<int>(history.size()) > snapshot)
+        {
+            int y = history.back().first;
+            int oldValue = history.back().second;
+            history.pop_back();
+            int x = parentOrSize[y];
+            parentOrSize[x] -= oldValue;
+            parentOrSize[y] = oldValue;
+            sets++;
+        }
+    }
+};
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../graph_common/csr_graph.h"
+#include "../graph_common/mst_result.h"
+#include "../graph_common/parallel_sort.h"
+#include "../graph_common/thread_pool.h"
+#include "../graph_common/union_find.h"
+
+// ========================================================================
+// АЛГОРИТМ КРУСКАЛА НА БОЛЬШИХ СПИСКАХ РЁБЕР
+// ========================================================================
+// Graph::kruskal из simple_kruskal.cxx сортирует ВСЕ рёбра, хотя MST
+// обычно набирается из самых лёгких: на графе со 100 млн рёбер и 1 млн
+// вершин больше 90% отсортированных рёбер потом просто отбрасываются
+// проверкой "концы уже в одной компоненте". Три варианта:
+//
+// 1. kruskalFullSort     - как в учебном примере: std::sort + проход.
+// 2. kruskalParallelSort - то же, но сортировка параллельная (parallelSort).
+// 3. filterKruskal       - Filter-Kruskal (Osipov, Sanders, Singler):
+//
+//      solve(рёбра):
+//        если рёбер мало - отсортировать и пройти, как Крускал
+//        иначе выбрать опорный вес p и разбить рёбра, как в quicksort:
+//          лёгкие (< p) | равные (= p) | тяжёлые (> p)
+//        solve(лёгкие)
+//        пройти равные (сортировать не нужно - веса одинаковы)
+//        ФИЛЬТР: выбросить тяжёлые рёбра, концы которых уже в одной
+//                компоненте - их никогда не понадобится сортировать
+//        solve(оставшиеся тяжёлые)
+//
+//    Как только набрано V - 1 рёбер, оставшиеся тяжёлые рёбра не
+//    трогаются вовсе. Разбиение и фильтр - линейные проходы, которые
+//    (в версии с пулом потоков) выполняются параллельно по блокам.
+//
+// Все функции переставляют рёбра входного вектора (как std::sort в
+// Graph::kruskal), граф неориентированный, каждое ребро задано один раз.
+// ========================================================================
+
+// Ниже этого размера подмассив просто сортируется
+const std::int64_t FILTER_KRUSKAL_BASE = 1 << 12;
+
+inline bool lighterEdge(const WeightedEdge& a, const WeightedEdge& b)
+{
+    return a.weight < b.weight;
+}
+
+class FilterKruskal
+{
+    int numVertices;
+    ThreadPool* pool; // nullptr - последовательная версия
+    DSU uf;
+    MSTResult result;
+    std::mt19937_64 rng;
+
+    std::vector<WeightedEdge> buffer;      // Для параллельной раскладки по классам
+    std::vector<std::int64_t> blockCounts; // [блок * 3 + класс]
+
+    bool complete() const
+    {
+        return static_cast<int>(result.edges.size()) == numVertices - 1;
+    }
+
+    // Проход Крускала по рёбрам, уже упорядоченным по весу
+    void scan(const WeightedEdge* first, const WeightedEdge* last)
+    {
+        for (const WeightedEdge* e = first; e != last && !complete(); e++)
+        {
+            if (uf.unite(e->source, e->destination))
+            {
+                result.edges.push_back(*e);
+                result.totalWeight += e->weight;
+            }
+        }
+    }
+
+    bool parallel(std::int64_t n) const
+    {
+        return pool != nullptr && pool->threadCount() > 1 && n >= PARALLEL_SORT_MIN;
+    }
+
+    // Параллельная устойчивая раскладка [first, first + n) на классы 0, 1, 2
+    // (classify возвращает класс); класс 2 выбрасывается, если drop2.
+    // Возвращает границы: класс c лежит в [bounds[c], bounds[c + 1]).
+    template <typename Classify>
+    std::array<std::int64_t, 4> split(WeightedEdge* first, std::int64_t n, Classify classify, bool drop2)
+    {
+        const std::int64_t block = 1 << 14;
+        const std::int64_t numBlocks = (n + block - 1) / block;
+        blockCounts.assign(static_cast<std::size_t>(numBlocks) * 3, 0);
+
+        pool->parallelFor(0, numBlocks, [&](std::int64_t b) {
+            std::int64_t count[3] = {0, 0, 0};
+            for (std::int64_t i = b * block; i < std::min(n, (b + 1) * block); i++)
+            {
+                count[classify(first[i])]++;
+            }
+            for (int c = 0; c < 3; c++)
+                blockCounts[b * 3 + c] = count[c];
+        });
+
+        // Префиксные суммы: сначала все блоки класса 0, затем класса 1, ...
+        std::array<std::int64_t, 4> bounds = {0, 0, 0, 0};
+        std::int64_t offset = 0;
+        for (int c = 0; c < 3; c++)
+        {
+            bounds[c] = offset;
+            for (std::int64_t b = 0; b < numBlocks; b++)
+            {
+                std::int64_t count = blockCounts[b * 3 + c];
+                blockCounts[b * 3 + c] = offset;
+                offset += count;
+            }
+        }
+        bounds[3] = offset;
+
+        if (buffer.size() < static_cast<std::size_t>(n))
+            buffer.resize(static_cast<std::size_t>(n));
+        pool->parallelFor(0, numBlocks, [&](std::int64_t b) {
+            std::int64_t pos[3] = {blockCounts[b * 3], blockCounts[b * 3 + 1], blockCounts[b * 3 + 2]};
+            for (std::int64_t i = b * block; i < std::min(n, (b + 1) * block); i++)
+            {
+                int c = classify(first[i]);
+                if (c != 2 || !drop2)
+                    buffer[pos[c]++] = first[i];
+            }
+        });
+
+        std::int64_t kept = drop2 ? bounds[2] : bounds[3];
+        pool->parallelFor(0, (kept + block - 1) / block, [&](std::int64_t b) {
+            std::copy(buffer.begin() + b * block, buffer.begin() + std::min(kept, (b + 1) * block), first + b * block);
+        });
+        return bounds;
+    }
+
+    // Медиана трёх случайных весов - опорный вес разбиения
+    int choosePivot(const WeightedEdge* first, std::int64_t n)
+    {
+        std::uniform_int_distribution<std::int64_t> index(0, n - 1);
+        int a = first[index(rng)].weight;
+        int b = first[index(rng)].weight;
+        int c = first[index(rng)].weight;
+        return std::max(std::min(a, b), std::min(std::max(a, b), c));
+    }
+
+    void solve(WeightedEdge* first, WeightedEdge* last)
+    {
+        const std::int64_t n = last - first;
+        if (n == 0 || complete())
+            return;
+
+        if (n <= FILTER_KRUSKAL_BASE)
+        {
+            std::sort(first, last, lighterEdge);
+            scan(first, last);
+            return;
+        }
+
+        const int pivot = choosePivot(first, n);
+        WeightedEdge* lightEnd;
+        WeightedEdge* equalEnd;
+        if (parallel(n))
+        {
+            auto bounds = split(first, n, [pivot](const WeightedEdge& e) {
+                return e.weight < pivot ? 0 : (e.weight == pivot ? 1 : 2);
+            }, false);
+            lightEnd = first + bounds[1];
+            equalEnd = first + bounds[2];
+        }
+        else
+        {
+            lightEnd = std::partition(first, last, [pivot](const WeightedEdge& e) { return e.weight < pivot; });
+            equalEnd = std::partition(lightEnd, last, [pivot](const WeightedEdge& e) { return e.weight == pivot; });
+        }
+
+        solve(first, lightEnd);
+        scan(lightEnd, equalEnd);
+        if (complete())
+            return;
+
+        // Фильтр: тяжёлые рёбра внутри одной компоненты больше не нужны.
+        // Параллельно - через root (только чтение, без половинения путей).
+        const std::int64_t heavy = last - equalEnd;
+        WeightedEdge* heavyEnd;
+        if (parallel(heavy))
+        {
+            auto bounds = split(equalEnd, heavy, [this](const WeightedEdge& e) {
+                return uf.root(e.source) == uf.root(e.destination) ? 2 : 0;
+            }, true);
+            heavyEnd = equalEnd + bounds[2];
+        }
+        else
+        {
+            heavyEnd = std::remove_if(equalEnd, last, [this](const WeightedEdge& e) {
+                return uf.same(e.source, e.destination);
+            });
+        }
+        solve(equalEnd, heavyEnd);
+    }
+
+public:
+    FilterKruskal(int V, ThreadPool* threadPool = nullptr, std::uint64_t seed = 1)
+        : numVertices(V), pool(threadPool), uf(V), rng(seed)
+    {
+    }
+
+    MSTResult run(std::vector<WeightedEdge>& edges)
+    {
+        uf.reset(numVertices);
+        result = MSTResult();
+        result.edges.reserve(numVertices > 0 ? numVertices - 1 : 0);
+        solve(edges.data(), edges.data() + edges.size());
+        result.components = numVertices - static_cast<int>(result.edges.size());
+        return result;
+    }
+};
+
+// Проход Крускала по уже отсортированным рёбрам
+inline MSTResult kruskalScan(int V, const std::vector<WeightedEdge>& sortedEdges)
+{
+    DSU uf(V);
+    MSTResult result;
+    result.edges.reserve(V > 0 ? V - 1 : 0);
+    for (const WeightedEdge& e : sortedEdges)
+    {
+        if (uf.unite(e.source, e.destination))
+        {
+            result.edges.push_back(e);
+            result.totalWeight += e.weight;
+            if (static_cast<int>(result.edges.size()) == V - 1)
+                break;
+        }
+    }
+    result.components = V - static_cast<int>(result.edges.size());
+    return result;
+}
+
+inline MSTResult kruskalFullSort(int V, std::vector<WeightedEdge>& edges)
+{
+    std::sort(edges.begin(), edges.end(), lighterEdge);
+    return kruskalScan(V, edges);
+}
+
+inline MSTResult kruskalParallelSort(int V, std::vector<WeightedEdge>& edges, ThreadPool& pool)
+{
+    parallelSort(edges.data(), edges.data() + edges.size(), pool, lighterEdge);
+    return kruskalScan(V, edges);
+}
+
+inline MSTResult filterKruskal(int V, std::vector<WeightedEdge>& edges)
+{
+    FilterKruskal fk(V);
+    return fk.run(edges);
+}
+
+inline MSTResult filterKruskal(int V, std::vector<WeightedEdge>& edges, ThreadPool& pool)
+{
+    FilterKruskal fk(V, &pool);
+    return fk.run(edges);
+}
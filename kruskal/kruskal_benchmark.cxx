@@ -0,0 +1,99 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "filter_kruskal.h"
+#include "../graph_common/text_columns.h"
+
+// ========================================================================
+// КРУСКАЛ: ПОЛНАЯ СОРТИРОВКА vs ПАРАЛЛЕЛЬНАЯ СОРТИРОВКА vs FILTER-KRUSKAL
+// ========================================================================
+// Случайный граф: V вершин, degree * V рёбер со случайными весами
+// [1, 10^6]. На таком графе MST (V - 1 ребро) набирается из малой доли
+// самых лёгких рёбер, и Filter-Kruskal не сортирует остальные.
+// Время каждого варианта - без копирования входа; вес MST сверяется.
+//
+// Запуск: ./kruskal_benchmark [V] [degree] (по умолчанию 10^6 и 16)
+// ========================================================================
+
+std::vector<WeightedEdge> makeRandomGraph(int V, int degree, std::uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> vertex(0, V - 1);
+    std::uniform_int_distribution<int> weight(1, 1000000);
+    std::vector<WeightedEdge> edges;
+    edges.reserve(static_cast<std::size_t>(V) * degree);
+    // Путь 0 - 1 - ... - (V - 1) делает граф связным
+    for (int v = 0; v + 1 < V; v++)
+    {
+        edges.push_back({v, v + 1, weight(rng)});
+    }
+    while (edges.size() < static_cast<std::size_t>(V) * degree)
+    {
+        edges.push_back({vertex(rng), vertex(rng), weight(rng)});
+    }
+    std::shuffle(edges.begin(), edges.end(), rng);
+    return edges;
+}
+
+template <typename Func>
+double bestOfMs(int runs, const std::vector<WeightedEdge>& input, Func&& f)
+{
+    double best = 1e18;
+    for (int r = 0; r < runs; r++)
+    {
+        std::vector<WeightedEdge> edges = input;
+        auto start = std::chrono::steady_clock::now();
+        f(edges);
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+int main(int argc, char* argv[])
+{
+    int V = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+    int degree = (argc > 2) ? std::atoi(argv[2]) : 16;
+    int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  КРУСКАЛ НА БОЛЬШОМ ГРАФЕ (ядер: " << cores << ")" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    std::vector<WeightedEdge> input = makeRandomGraph(V, degree, 1);
+    std::cout << "V = " << V << ", E = " << input.size() << "\n" << std::endl;
+
+    ThreadPool pool(cores);
+    MSTResult expected;
+    double fullMs = bestOfMs(3, input, [&](std::vector<WeightedEdge>& e) { expected = kruskalFullSort(V, e); });
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << alignLeft("Вариант", 34) << "          мс   ускорение" << std::endl;
+
+    auto report = [&](const char* name, double ms, const MSTResult& r) {
+        bool ok = r.totalWeight == expected.totalWeight && r.components == expected.components;
+        std::cout << alignLeft(name, 34) << std::setw(12) << ms
+                  << std::setw(11) << fullMs / ms << "x" << (ok ? "   ✓" : "   ✗ ОШИБКА") << std::endl;
+    };
+
+    report("std::sort + Крускал", fullMs, expected);
+
+    MSTResult r;
+    double ms = bestOfMs(3, input, [&](std::vector<WeightedEdge>& e) { r = kruskalParallelSort(V, e, pool); });
+    report("parallelSort + Крускал", ms, r);
+
+    ms = bestOfMs(3, input, [&](std::vector<WeightedEdge>& e) { r = filterKruskal(V, e); });
+    report("Filter-Kruskal", ms, r);
+
+    ms = bestOfMs(3, input, [&](std::vector<WeightedEdge>& e) { r = filterKruskal(V, e, pool); });
+    report("Filter-Kruskal (параллельный)", ms, r);
+
+    std::cout << "\nВес MST: " << expected.totalWeight << ", рёбер: " << expected.edges.size() << std::endl;
+    return 0;
+}
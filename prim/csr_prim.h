@@ -0,0 +1,302 @@
+#pragma once
+
+#include <climits>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "../graph_common/csr_graph.h"
+#include "../graph_common/indexed_heap.h"
+#include "../graph_common/pairing_heap.h"
+
+// Алгоритм Прима на CSR-графе (тот же алгоритм, что и Graph::prim
+// в simple_prim.cxx, но без вывода). Граф должен быть построен как
+// неориентированный (CSRGraphBuilder(V, true)).
+
+struct PrimResult
+{
+    std::vector<int> parent; // Родитель вершины в MST (-1 у корня и недостижимых)
+    long long totalWeight;   // Суммарный вес рёбер MST
+    int edgeCount;           // Количество рёбер MST (V - 1 для связного графа)
+};
+
+inline PrimResult csrPrim(const CSRGraph& g, int startVertex = 0)
+{
+    const int V = g.vertexCount();
+    PrimResult result;
+    result.parent.assign(V, -1);
+    result.totalWeight = 0;
+    result.edgeCount = 0;
+
+    std::vector<int> key(V, INT_MAX);
+    std::vector<char> inMST(V, 0);
+
+    // (вес, вершина): родитель берётся из result.parent, а не хранится в очереди
+    std::priority_queue<std::pair<int, int>,
+                        std::vector<std::pair<int, int>>,
+                        std::greater<std::pair<int, int>>> pq;
+
+    key[startVertex] = 0;
+    pq.push({0, startVertex});
+
+    while (!pq.empty())
+    {
+        int weight = pq.top().first;
+        int u = pq.top().second;
+        pq.pop();
+        if (inMST[u] || weight != key[u])
+            continue; // Устаревшая запись
+
+        inMST[u] = 1;
+        if (result.parent[u] != -1)
+        {
+            result.totalWeight += weight;
+            result.edgeCount++;
+        }
+
+        for (std::int64_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++)
+        {
+            int v = g.target(e);
+            int w = g.weight(e);
+            if (!inMST[v] && w < key[v])
+            {
+                key[v] = w;
+                result.parent[v] = u;
+                pq.push({w, v});
+            }
+        }
+    }
+    return result;
+}
+
+// ========================================================================
+// ПРИМ С ВЫБОРОМ ОЧЕРЕДИ
+// ========================================================================
+// Версия выше кладёт вершину в очередь при КАЖДОМ уменьшении ключа.
+//
+//   LazyHeap    - std::priority_queue, ленивое удаление (как csrPrim)
+//   BinaryHeap  - индексированная двоичная куча, decreaseKey за O(log V)
+//   PairingHeap - pairing-куча, decreaseKey за O(1) (амортизированно o(log V))
+//   Dense       - без кучи: каждый шаг ищет минимум ключа перебором массива,
+//                 O(V² + E). На плотном графе (E ~ V²) это оптимально:
+//                 перебор плотного массива int дешевле операций с кучей.
+//   Auto        - Dense при E / V² >= PRIM_DENSE_MIN_DENSITY, иначе BinaryHeap
+//                 (на евклидовых графах prim_benchmark двоичная куча чуть
+//                 быстрее pairing: её массив компактнее в кэше)
+// ========================================================================
+
+enum class PrimQueue
+{
+    LazyHeap,
+    BinaryHeap,
+    PairingHeap,
+    Dense,
+    Auto
+};
+
+// Общее ядро для куч с decreaseKey (IndexedDaryHeap, IndexedPairingHeap)
+template <typename Queue>
+PrimResult primWithQueue(const CSRGraph& g, int startVertex, Queue& queue)
+{
+    const int V = g.vertexCount();
+    PrimResult result;
+    result.parent.assign(V, -1);
+    result.totalWeight = 0;
+    result.edgeCount = 0;
+
+    std::vector<int> key(V, INT_MAX);
+    std::vector<char> inMST(V, 0);
+
+    key[startVertex] = 0;
+    queue.push(startVertex, 0);
+
+    while (!queue.empty())
+    {
+        int u = queue.pop();
+        inMST[u] = 1;
+        if (result.parent[u] != -1)
+        {
+            result.totalWeight += key[u];
+            result.edgeCount++;
+        }
+
+        for (std::int64_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++)
+        {
+            int v = g.target(e);
+            int w = g.weight(e);
+            if (!inMST[v] && w < key[v])
+            {
+                if (key[v] == INT_MAX)
+                    queue.push(v, w);
+                else
+                    queue.decreaseKey(v, w);
+                key[v] = w;
+                result.parent[v] = u;
+            }
+        }
+    }
+    return result;
+}
+
+// Прим для плотных графов: O(V²) без кучи.
+//
+// Вариант для матрицы весов.
+// weights - матрица V x V по строкам, INT_MAX = ребра нет (так удобно
+// передавать матрицу расстояний из задач кластеризации напрямую).
+// Каждый шаг - ОДИН проход по строке новой вершины дерева: релаксация
+// ключей и поиск минимума вместе, подряд по памяти и без ветвлений -
+// компилятор векторизует его (при -O3). Ключ вершины, уже попавшей в
+// дерево, равен INT_MAX, и релаксация его не трогает.
+inline PrimResult densePrim(const std::vector<int>& weights, int V, int startVertex = 0)
+{
+    PrimResult result;
+    result.parent.assign(V, -1);
+    result.totalWeight = 0;
+    result.edgeCount = 0;
+
+    std::vector<int> key(V, INT_MAX);
+    std::vector<int> inTree(V, 0); // int, а не char: та же ширина, что и key, для векторизации
+    int* keys = key.data();
+    int* parent = result.parent.data();
+    const int* done = inTree.data();
+
+    int u = startVertex;
+    int weight = 0;
+    while (true)
+    {
+        inTree[u] = 1;
+        key[u] = INT_MAX;
+        if (parent[u] != -1)
+        {
+            result.totalWeight += weight;
+            result.edgeCount++;
+        }
+
+        const int* row = weights.data() + static_cast<std::size_t>(u) * V;
+        int best = INT_MAX;
+        for (int v = 0; v < V; v++)
+        {
+            int candidate = done[v] ? INT_MAX : row[v];
+            bool better = candidate < keys[v];
+            keys[v] = better ? candidate : keys[v];
+            parent[v] = better ? u : parent[v];
+            best = keys[v] < best ? keys[v] : best;
+        }
+        if (best == INT_MAX)
+            break; // Оставшиеся вершины недостижимы из startVertex
+        u = 0;
+        while (keys[u] != best)
+            u++;
+        weight = best;
+    }
+    return result;
+}
+
+// То же на CSR-графе, без построения матрицы (она заняла бы V² памяти,
+// а её заполнение стоит столько же, сколько весь Прим с кучей).
+// Релаксация идёт по рёбрам вершины, поиск минимума - отдельным
+// проходом по плотному массиву ключей (минимум без ветвлений, затем
+// его позиция). Выигрыш у кучи - на графах, близких к полному, где
+// decreaseKey вызывается на большой доле из E рёбер.
+inline PrimResult densePrim(const CSRGraph& g, int startVertex = 0)
+{
+    const int V = g.vertexCount();
+    PrimResult result;
+    result.parent.assign(V, -1);
+    result.totalWeight = 0;
+    result.edgeCount = 0;
+
+    std::vector<int> key(V, INT_MAX);
+    std::vector<char> inMST(V, 0);
+    key[startVertex] = 0;
+    int u = startVertex;
+
+    while (true)
+    {
+        int weight = key[u];
+        key[u] = INT_MAX;
+        inMST[u] = 1;
+        if (result.parent[u] != -1)
+        {
+            result.totalWeight += weight;
+            result.edgeCount++;
+        }
+
+        for (std::int64_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++)
+        {
+            int v = g.target(e);
+            int w = g.weight(e);
+            if (!inMST[v] && w < key[v])
+            {
+                key[v] = w;
+                result.parent[v] = u;
+            }
+        }
+
+        int best = INT_MAX;
+        for (int v = 0; v < V; v++)
+        {
+            best = key[v] < best ? key[v] : best;
+        }
+        if (best == INT_MAX)
+            break; // Оставшиеся вершины недостижимы из startVertex
+        u = 0;
+        while (key[u] != best)
+            u++;
+    }
+    return result;
+}
+
+// Порог плотности E / V² для режима Auto (E - число записей CSR, т. е.
+// удвоенное число неориентированных рёбер). Просмотр E рёбер одинаков
+// в обоих режимах; куча добавляет decreaseKey по несколько нс, перебор -
+// V² сравнений по доле нс. По prim_benchmark перебор догоняет кучу
+// примерно с E / V² = 0.4 и выигрывает на почти полных графах.
+const double PRIM_DENSE_MIN_DENSITY = 0.4;
+
+inline bool preferDensePrim(const CSRGraph& g)
+{
+    const double V = g.vertexCount();
+    if (V < 2)
+        return false;
+    return static_cast<double>(g.edgeCount()) / (V * V) >= PRIM_DENSE_MIN_DENSITY;
+}
+
+inline PrimResult csrPrim(const CSRGraph& g, int startVertex, PrimQueue queueType)
+{
+    const int V = g.vertexCount();
+    if (queueType == PrimQueue::Auto)
+        queueType = preferDensePrim(g) ? PrimQueue::Dense : PrimQueue::BinaryHeap;
+
+    switch (queueType)
+    {
+    case PrimQueue::LazyHeap:
+        return csrPrim(g, startVertex);
+    case PrimQueue::BinaryHeap:
+    {
+        IndexedDaryHeap<2> heap(V);
+        return primWithQueue(g, startVertex, heap);
+    }
+    case PrimQueue::Dense:
+        return densePrim(g, startVertex);
+    case PrimQueue::PairingHeap:
+    default:
+    {
+        IndexedPairingHeap heap(V);
+        return primWithQueue(g, startVertex, heap);
+    }
+    }
+}
+
+inline const char* primQueueName(PrimQueue queueType)
+{
+    switch (queueType)
+    {
+    case PrimQueue::LazyHeap:    return "LazyHeap";
+    case PrimQueue::BinaryHeap:  return "BinaryHeap";
+    case PrimQueue::PairingHeap: return "PairingHeap";
+    case PrimQueue::Dense:       return "Dense";
+    default:                     return "Auto";
+    }
+}
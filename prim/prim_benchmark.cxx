@@ -0,0 +1,146 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "csr_prim.h"
+#include "../graph_common/text_columns.h"
+
+// ========================================================================
+// ПРИМ: ВЫБОР ОЧЕРЕДИ В ЗАВИСИМОСТИ ОТ ПЛОТНОСТИ ГРАФА
+// ========================================================================
+// Как в задачах кластеризации: V случайных точек в квадрате, вес ребра -
+// евклидово расстояние. Каждая пара точек соединена с вероятностью p, так
+// что плотность E / V² растёт до 1 (E - записи CSR, по две на ребро).
+// Для каждой плотности сравниваются все режимы csrPrim и отмечается
+// выбор Auto. Затем на полном графе - densePrim на готовой матрице
+// расстояний. Веса MST всех режимов должны совпадать.
+//
+// Запуск: ./prim_benchmark [V] (по умолчанию 4000)
+// ========================================================================
+
+struct Points
+{
+    std::vector<double> x, y;
+
+    explicit Points(int V, std::uint64_t seed) : x(V), y(V)
+    {
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> coordinate(0.0, 1.0);
+        for (int v = 0; v < V; v++)
+        {
+            x[v] = coordinate(rng);
+            y[v] = coordinate(rng);
+        }
+    }
+
+    int distance(int a, int b) const
+    {
+        return static_cast<int>(1e6 * std::hypot(x[a] - x[b], y[a] - y[b]));
+    }
+};
+
+CSRGraph makeGraph(const Points& points, double pairProbability, std::uint64_t seed)
+{
+    const int V = static_cast<int>(points.x.size());
+    std::mt19937_64 rng(seed);
+    std::bernoulli_distribution keep(pairProbability);
+
+    CSRGraphBuilder builder(V, true);
+    builder.reserve(static_cast<std::size_t>(pairProbability * V * V / 2) + V);
+    for (int v = 0; v + 1 < V; v++)
+    {
+        builder.addEdge(v, v + 1, 2000000); // Тяжёлый путь - только для связности
+    }
+    for (int a = 0; a < V; a++)
+    {
+        for (int b = a + 1; b < V; b++)
+        {
+            if (keep(rng))
+                builder.addEdge(a, b, points.distance(a, b));
+        }
+    }
+    return builder.build();
+}
+
+template <typename Func>
+double bestOfMs(int runs, Func&& f)
+{
+    double best = 1e18;
+    for (int r = 0; r < runs; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+int main(int argc, char* argv[])
+{
+    int V = (argc > 1) ? std::atoi(argv[1]) : 4000;
+    const PrimQueue modes[] = {PrimQueue::LazyHeap, PrimQueue::BinaryHeap, PrimQueue::PairingHeap,
+                               PrimQueue::Dense, PrimQueue::Auto};
+    const double probabilities[] = {0.005, 0.02, 0.05, 0.1, 0.2, 0.4, 0.7, 1.0};
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  ПРИМ: КУЧИ vs ПЕРЕБОР (V = " << V << ")" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Время в мс; Auto выбирает Dense при E / V² >= " << PRIM_DENSE_MIN_DENSITY << "\n" << std::endl;
+
+    std::cout << alignLeft("E / V²", 10);
+    for (PrimQueue mode : modes)
+        std::cout << std::right << std::setw(13) << primQueueName(mode);
+    std::cout << std::endl;
+
+    Points points(V, 1);
+    std::cout << std::fixed;
+    for (double p : probabilities)
+    {
+        CSRGraph g = makeGraph(points, p, 2);
+        std::cout << std::left << std::setw(10) << std::setprecision(3)
+                  << static_cast<double>(g.edgeCount()) / (static_cast<double>(V) * V) << std::setprecision(2);
+
+        long long expected = -1;
+        bool ok = true;
+        for (PrimQueue mode : modes)
+        {
+            PrimResult result;
+            double ms = bestOfMs(3, [&]() { result = csrPrim(g, 0, mode); });
+            if (expected == -1)
+                expected = result.totalWeight;
+            ok = ok && result.totalWeight == expected && result.edgeCount == V - 1;
+            std::cout << std::right << std::setw(13) << ms;
+        }
+        std::cout << "   " << (preferDensePrim(g) ? "Dense" : "BinaryHeap")
+                  << (ok ? "   ✓" : "   ✗ ОШИБКА") << std::endl;
+    }
+
+    // Полный граф, заданный матрицей расстояний: один проход по строке на шаг
+    std::vector<int> matrix(static_cast<std::size_t>(V) * V);
+    CSRGraphBuilder builder(V, true);
+    builder.reserve(static_cast<std::size_t>(V) * (V - 1) / 2);
+    for (int a = 0; a < V; a++)
+    {
+        for (int b = 0; b < V; b++)
+        {
+            matrix[static_cast<std::size_t>(a) * V + b] = (a == b) ? INT_MAX : points.distance(a, b);
+            if (a < b)
+                builder.addEdge(a, b, points.distance(a, b));
+        }
+    }
+    CSRGraph complete = builder.build();
+
+    PrimResult heapResult, matrixResult;
+    double heapMs = bestOfMs(3, [&]() { heapResult = csrPrim(complete, 0, PrimQueue::BinaryHeap); });
+    double matrixMs = bestOfMs(3, [&]() { matrixResult = densePrim(matrix, V, 0); });
+    std::cout << "\nПолный граф: BinaryHeap на CSR " << heapMs << " мс, densePrim на матрице "
+              << matrixMs << " мс (" << heapMs / matrixMs << "x)"
+              << (heapResult.totalWeight == matrixResult.totalWeight ? "   ✓" : "   ✗ ОШИБКА") << std::endl;
+    return 0;
+}
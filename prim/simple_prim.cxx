@@ -4,6 +4,8 @@
 #include <climits>
 #include <iomanip>
 
+#include "../common/trace.h"
+
 // Вспомогательная функция для вывода содержимого приоритетной очереди
 void printPriorityQueue(std::priority_queue<std::pair<int, std::pair<int, int>>, 
                                            std::vector<std::pair<int, std::pair<int, int>>>, 
@@ -35,6 +37,7 @@ struct Edge
 };
 
 // Класс для представления неориентированного взвешенного графа
+template <typename Trace = NoTrace>
 class Graph
 {
     int numVertices;                              // Количество вершин
@@ -42,7 +45,7 @@ class Graph
     std::vector<bool> inMST;                      // Вершины уже включенные в MST
     std::vector<int> parent;                      // Родитель каждой вершины в MST
     std::vector<int> key;                         // Минимальный вес ребра для включения в MST
-    bool verbose;                                  // Режим детального вывода
+    Trace verbose;                                 // Режим детального вывода
 
 public:
     // Конструктор: создаем граф с заданным количеством вершин
@@ -293,7 +296,7 @@ int main()
     //     |
     //     1
     //     3
-    Graph g1(4, true);
+    Graph<VerboseTrace> g1(4, true);
     g1.addEdge(0, 1, 1);
     g1.addEdge(0, 2, 4);
     g1.addEdge(1, 2, 2);
@@ -304,7 +307,7 @@ int main()
     std::cout << "  ТЕСТ 2: Полный граф K4" << std::endl;
     std::cout << "========================================" << std::endl;
     // Тест 2: Полный граф (все вершины соединены)
-    Graph g2(4, true);
+    Graph<VerboseTrace> g2(4, true);
     g2.addEdge(0, 1, 10);
     g2.addEdge(0, 2, 6);
     g2.addEdge(0, 3, 5);
@@ -318,7 +321,7 @@ int main()
     std::cout << "========================================" << std::endl;
     // Тест 3: Линейная цепь (уже является деревом)
     // 0 --2-- 1 --3-- 2 --1-- 3 --4-- 4
-    Graph g3(5, true);
+    Graph<VerboseTrace> g3(5, true);
     g3.addEdge(0, 1, 2);
     g3.addEdge(1, 2, 3);
     g3.addEdge(2, 3, 1);
@@ -340,7 +343,7 @@ int main()
     //      1  6  4
     //       \ | /
     //         6
-    Graph g4(7, true);
+    Graph<VerboseTrace> g4(7, true);
     g4.addEdge(0, 1, 2);
     g4.addEdge(0, 2, 5);
     g4.addEdge(0, 3, 3);
@@ -355,7 +358,7 @@ int main()
     std::cout << "  ТЕСТ 5: Большой граф (без детального вывода)" << std::endl;
     std::cout << "========================================" << std::endl;
     // Тест 5: Большой граф
-    Graph g5(9, false);
+    Graph<> g5(9, false);
     g5.addEdge(0, 1, 4);
     g5.addEdge(0, 7, 8);
     g5.addEdge(1, 2, 8);
@@ -0,0 +1,508 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "../common/epoch.h"
+
+// ========================================================================
+// PersistentRBTree<Key, Value, Compare> - КРАСНО-ЧЁРНОЕ ДЕРЕВО ДЛЯ
+// МНОГИХ ЧИТАТЕЛЕЙ И ОДНОГО ПИСАТЕЛЯ (снимки в стиле RCU)
+// ========================================================================
+// RedBlackTree из simple_rbtree.cxx меняет узлы на месте (insertFixup
+// перекрашивает и поворачивает), поэтому читатель без блокировки может
+// увидеть дерево посреди поворота. Здесь опубликованный узел не меняется
+// никогда:
+//
+//   Копирование пути. Вставка и удаление копируют узлы на пути от корня
+//   (O(log n) узлов), нетронутые поддеревья общие у старой и новой версий.
+//   Балансировка - функциональная (Okasaki - вставка, Kahrs - удаление):
+//   каждый шаг строит узел заново из частей, а не крутит указатели.
+//
+//   Пакеты. Писатель накапливает изменения в рабочей версии и публикует
+//   её одной атомарной записью корня (commit). Узлы, созданные после
+//   последней публикации, ещё никто не видел - второе изменение в том же
+//   пакете меняет их на месте, а не копирует снова. Поэтому пакет из k
+//   изменений стоит меньше k отдельных копирований путей.
+//
+//   Снимки. Читатель берёт корень один раз и дальше читает неизменяемое
+//   дерево - весь снимок согласован, видны все изменения пакета или ни
+//   одного. Блокировок и записей в общие данные у читателя нет, кроме
+//   эпохи в собственном слоте.
+//
+//   Освобождение. Узлы, заменённые в пакете, удаляются через эпохи
+//   (common/epoch.h) - после того, как все снимки, которые могли их
+//   видеть, закрыты.
+//
+// Потоки:
+//   insert / erase / commit / rollback - только один поток-писатель;
+//   reader() - из любого потока, Reader и его снимки - в одном потоке.
+// Долго открытый снимок задерживает освобождение памяти, но не писателя.
+// ========================================================================
+
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class PersistentRBTree
+{
+    struct Node
+    {
+        Key key;
+        Value value;
+        Node* left;
+        Node* right;
+        bool red;
+        std::uint64_t version; // Номер пакета, в котором узел создан
+    };
+
+    // Опубликованная версия: корень и размер меняются вместе
+    struct Version
+    {
+        Node* root;
+        std::size_t size;
+    };
+
+    Compare compare;
+    EpochDomain domain;
+    std::atomic<Version*> published;
+
+    // Состояние писателя
+    Node* working = nullptr;          // Корень рабочей (неопубликованной) версии
+    std::size_t workingSize = 0;
+    std::uint64_t writeVersion = 1;   // Узлы с этим номером принадлежат пакету
+    std::vector<Node*> replaced;      // Опубликованные узлы, заменённые в пакете
+    bool dirty = false;
+
+public:
+    // --------------------------------------------------------------------
+    // Снимок: согласованная версия дерева, открытая для чтения
+    // --------------------------------------------------------------------
+    class Snapshot
+    {
+        EpochDomain::Participant* participant;
+        const Version* version;
+        const Compare* compare;
+
+    public:
+        Snapshot(EpochDomain::Participant& owner, const std::atomic<Version*>& source, const Compare& order)
+            : participant(&owner), compare(&order)
+        {
+            participant->pin();
+            version = source.load(std::memory_order_seq_cst);
+        }
+
+        Snapshot(Snapshot&& other) noexcept
+            : participant(std::exchange(other.participant, nullptr)), version(other.version), compare(other.compare)
+        {
+        }
+
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        Snapshot& operator=(Snapshot&&) = delete;
+
+        ~Snapshot()
+        {
+            if (participant != nullptr)
+                participant->unpin();
+        }
+
+        std::size_t size() const { return version->size; }
+        bool empty() const { return version->size == 0; }
+
+        // Указатель действителен, пока открыт снимок
+        const Value* find(const Key& key) const
+        {
+            const Node* node = findNode(version->root, key, *compare);
+            return node == nullptr ? nullptr : &node->value;
+        }
+
+        bool contains(const Key& key) const { return findNode(version->root, key, *compare) != nullptr; }
+
+        // visit(key, value) для всех пар по возрастанию ключей
+        template <typename Visit>
+        void forEach(Visit visit) const
+        {
+            std::vector<const Node*> stack;
+            const Node* node = version->root;
+            while (node != nullptr || !stack.empty())
+            {
+                while (node != nullptr)
+                {
+                    stack.push_back(node);
+                    node = node->left;
+                }
+                node = stack.back();
+                stack.pop_back();
+                visit(node->key, node->value);
+                node = node->right;
+            }
+        }
+    };
+
+    // Читающий поток: владеет слотом эпох, открывает снимки
+    class Reader
+    {
+        PersistentRBTree* tree;
+        EpochDomain::Participant participant;
+
+    public:
+        explicit Reader(PersistentRBTree& owner) : tree(&owner), participant(owner.domain.participant()) {}
+
+        Snapshot snapshot() { return Snapshot(participant, tree->published, tree->compare); }
+    };
+
+    explicit PersistentRBTree(int maxReaders = 128, const Compare& order = Compare())
+        : compare(order), domain(maxReaders), published(new Version{nullptr, 0})
+    {
+    }
+
+    PersistentRBTree(const PersistentRBTree&) = delete;
+    PersistentRBTree& operator=(const PersistentRBTree&) = delete;
+
+    // Читателей к этому моменту быть не должно
+    ~PersistentRBTree()
+    {
+        rollback();
+        domain.drain();
+        Version* last = published.load(std::memory_order_relaxed);
+        destroyTree(last->root);
+        delete last;
+    }
+
+    Reader reader() { return Reader(*this); }
+
+    // --------------------------------------------------------------------
+    // Операции писателя (рабочая версия, видна читателям после commit)
+    // --------------------------------------------------------------------
+    // Вставить пару или заменить значение; true - ключ новый
+    bool insert(const Key& key, const Value& value)
+    {
+        bool inserted = false;
+        working = makeBlack(insertNode(working, key, value, inserted));
+        workingSize += inserted;
+        dirty = true;
+        return inserted;
+    }
+
+    bool erase(const Key& key)
+    {
+        if (findNode(working, key, compare) == nullptr)
+            return false;
+        working = makeBlack(eraseNode(working, key));
+        workingSize--;
+        dirty = true;
+        return true;
+    }
+
+    const Value* find(const Key& key) const
+    {
+        const Node* node = findNode(working, key, compare);
+        return node == nullptr ? nullptr : &node->value;
+    }
+
+    bool contains(const Key& key) const { return findNode(working, key, compare) != nullptr; }
+    std::size_t size() const { return workingSize; }
+
+    // Опубликовать рабочую версию; заменённые узлы освобождаются, когда
+    // закроются снимки, которые могли их видеть
+    void commit()
+    {
+        if (dirty)
+        {
+            Version* previous = published.exchange(new Version{working, workingSize}, std::memory_order_seq_cst);
+            domain.retire([previous, garbage = std::move(replaced)]() {
+                for (Node* node : garbage)
+                    delete node;
+                delete previous;
+            });
+            replaced.clear();
+            writeVersion++;
+            dirty = false;
+        }
+        domain.collect();
+    }
+
+    // Отменить изменения после последнего commit
+    void rollback()
+    {
+        std::vector<Node*> stack;
+        if (working != nullptr)
+            stack.push_back(working);
+        while (!stack.empty())
+        {
+            Node* node = stack.back();
+            stack.pop_back();
+            if (!owned(node))
+                continue; // Опубликованное поддерево целиком общее
+            if (node->left != nullptr)
+                stack.push_back(node->left);
+            if (node->right != nullptr)
+                stack.push_back(node->right);
+            delete node;
+        }
+        replaced.clear();
+        Version* current = published.load(std::memory_order_relaxed);
+        working = current->root;
+        workingSize = current->size;
+        dirty = false;
+    }
+
+    // Отложенных удалений (пакетов, ждущих закрытия снимков)
+    std::size_t pendingReclaim() const { return domain.pending(); }
+
+private:
+    static const Node* findNode(const Node* node, const Key& key, const Compare& order)
+    {
+        while (node != nullptr)
+        {
+            if (order(key, node->key))
+                node = node->left;
+            else if (order(node->key, key))
+                node = node->right;
+            else
+                return node;
+        }
+        return nullptr;
+    }
+
+    static bool isRed(const Node* node) { return node != nullptr && node->red; }
+    static bool isBlack(const Node* node) { return node != nullptr && !node->red; }
+
+    bool owned(const Node* node) const { return node->version == writeVersion; }
+
+    // --------------------------------------------------------------------
+    // Копирование пути
+    // --------------------------------------------------------------------
+    // Узел, который можно менять: свой - как есть, опубликованный - копия
+    Node* own(Node* node)
+    {
+        if (owned(node))
+            return node;
+        Node* copy = new Node(*node);
+        copy->version = writeVersion;
+        replaced.push_back(node);
+        return copy;
+    }
+
+    // "Новый" узел с ключом node и заданными цветом и детьми. Поля node
+    // читаются до вызова: свой узел меняется на месте
+    Node* rebuild(Node* node, bool red, Node* left, Node* right)
+    {
+        node = own(node);
+        node->red = red;
+        node->left = left;
+        node->right = right;
+        return node;
+    }
+
+    void dropNode(Node* node)
+    {
+        if (owned(node))
+            delete node;
+        else
+            replaced.push_back(node);
+    }
+
+    Node* makeBlack(Node* node)
+    {
+        if (!isRed(node))
+            return node;
+        return rebuild(node, false, node->left, node->right);
+    }
+
+    // Балансировка Окасаки с дополнительным случаем Карса (оба ребёнка
+    // красные): любая пара красных под mid превращается в красный узел
+    // с двумя чёрными детьми. Иначе mid становится чёрным
+    Node* balance(Node* left, Node* mid, Node* right)
+    {
+        if (isRed(left) && isRed(right))
+        {
+            Node* newLeft = rebuild(left, false, left->left, left->right);
+            Node* newRight = rebuild(right, false, right->left, right->right);
+            return rebuild(mid, true, newLeft, newRight);
+        }
+        if (isRed(left) && isRed(left->left))
+        {
+            Node* y = left;
+            Node* x = left->left;
+            Node* c = y->right;
+            Node* newLeft = rebuild(x, false, x->left, x->right);
+            Node* newRight = rebuild(mid, false, c, right);
+            return rebuild(y, true, newLeft, newRight);
+        }
+        if (isRed(left) && isRed(left->right))
+        {
+            Node* x = left;
+            Node* y = left->right;
+            Node* b = y->left;
+            Node* c = y->right;
+            Node* newLeft = rebuild(x, false, x->left, b);
+            Node* newRight = rebuild(mid, false, c, right);
+            return rebuild(y, true, newLeft, newRight);
+        }
+        if (isRed(right) && isRed(right->right))
+        {
+            Node* y = right;
+            Node* z = right->right;
+            Node* b = y->left;
+            Node* newLeft = rebuild(mid, false, left, b);
+            Node* newRight = rebuild(z, false, z->left, z->right);
+            return rebuild(y, true, newLeft, newRight);
+        }
+        if (isRed(right) && isRed(right->left))
+        {
+            Node* z = right;
+            Node* y = right->left;
+            Node* b = y->left;
+            Node* c = y->right;
+            Node* newLeft = rebuild(mid, false, left, b);
+            Node* newRight = rebuild(z, false, c, z->right);
+            return rebuild(y, true, newLeft, newRight);
+        }
+        return rebuild(mid, false, left, right);
+    }
+
+    // --------------------------------------------------------------------
+    // Вставка (Okasaki)
+    // --------------------------------------------------------------------
+    Node* insertNode(Node* node, const Key& key, const Value& value, bool& inserted)
+    {
+        if (node == nullptr)
+        {
+            inserted = true;
+            return new Node{key, value, nullptr, nullptr, true, writeVersion};
+        }
+        Node* left = node->left;
+        Node* right = node->right;
+        if (compare(key, node->key))
+        {
+            Node* newLeft = insertNode(left, key, value, inserted);
+            return node->red ? rebuild(node, true, newLeft, right) : balance(newLeft, node, right);
+        }
+        if (compare(node->key, key))
+        {
+            Node* newRight = insertNode(right, key, value, inserted);
+            return node->red ? rebuild(node, true, left, newRight) : balance(left, node, newRight);
+        }
+        node = own(node);
+        node->value = value;
+        return node;
+    }
+
+    // --------------------------------------------------------------------
+    // Удаление (Kahrs). eraseNode уменьшает чёрную высоту поддерева с
+    // чёрным корнем на 1; balanceLeft / balanceRight возвращают её
+    // --------------------------------------------------------------------
+    Node* eraseNode(Node* node, const Key& key)
+    {
+        Node* left = node->left;
+        Node* right = node->right;
+        if (compare(key, node->key))
+        {
+            if (isBlack(left))
+                return balanceLeft(eraseNode(left, key), node, right);
+            return rebuild(node, true, eraseNode(left, key), right);
+        }
+        if (compare(node->key, key))
+        {
+            if (isBlack(right))
+                return balanceRight(left, node, eraseNode(right, key));
+            return rebuild(node, true, left, eraseNode(right, key));
+        }
+        dropNode(node);
+        return fuse(left, right);
+    }
+
+    // Чёрный узел -> красный (у дерева с чёрным корнем высота - 1)
+    Node* redden(Node* node) { return rebuild(node, true, node->left, node->right); }
+
+    // Левое поддерево стало на 1 ниже по чёрной высоте
+    Node* balanceLeft(Node* left, Node* mid, Node* right)
+    {
+        if (isRed(left))
+            return rebuild(mid, true, rebuild(left, false, left->left, left->right), right);
+        if (isBlack(right))
+            return balance(left, mid, redden(right));
+        // right красный, его левый ребёнок чёрный
+        Node* z = right;
+        Node* y = right->left;
+        Node* a = y->left;
+        Node* b = y->right;
+        Node* c = z->right;
+        Node* newLeft = rebuild(mid, false, left, a);
+        Node* newRight = balance(b, z, redden(c));
+        return rebuild(y, true, newLeft, newRight);
+    }
+
+    Node* balanceRight(Node* left, Node* mid, Node* right)
+    {
+        if (isRed(right))
+            return rebuild(mid, true, left, rebuild(right, false, right->left, right->right));
+        if (isBlack(left))
+            return balance(redden(left), mid, right);
+        // left красный, его правый ребёнок чёрный
+        Node* x = left;
+        Node* y = left->right;
+        Node* a = x->left;
+        Node* b = y->left;
+        Node* c = y->right;
+        Node* newLeft = balance(redden(a), x, b);
+        Node* newRight = rebuild(mid, false, c, right);
+        return rebuild(y, true, newLeft, newRight);
+    }
+
+    // Склейка детей удалённого узла (все ключи left < ключей right)
+    Node* fuse(Node* left, Node* right)
+    {
+        if (left == nullptr)
+            return right;
+        if (right == nullptr)
+            return left;
+        if (isRed(left) && isRed(right))
+        {
+            Node* inner = fuse(left->right, right->left);
+            if (isRed(inner))
+            {
+                Node* newLeft = rebuild(left, true, left->left, inner->left);
+                Node* newRight = rebuild(right, true, inner->right, right->right);
+                return rebuild(inner, true, newLeft, newRight);
+            }
+            Node* newRight = rebuild(right, true, inner, right->right);
+            return rebuild(left, true, left->left, newRight);
+        }
+        if (!left->red && !right->red)
+        {
+            Node* inner = fuse(left->right, right->left);
+            if (isRed(inner))
+            {
+                Node* newLeft = rebuild(left, false, left->left, inner->left);
+                Node* newRight = rebuild(right, false, inner->right, right->right);
+                return rebuild(inner, true, newLeft, newRight);
+            }
+            Node* newRight = rebuild(right, false, inner, right->right);
+            return balanceLeft(left->left, left, newRight);
+        }
+        if (isRed(right))
+            return rebuild(right, true, fuse(left, right->left), right->right);
+        return rebuild(left, true, left->left, fuse(left->right, right));
+    }
+
+    static void destroyTree(Node* node)
+    {
+        std::vector<Node*> stack;
+        if (node != nullptr)
+            stack.push_back(node);
+        while (!stack.empty())
+        {
+            node = stack.back();
+            stack.pop_back();
+            if (node->left != nullptr)
+                stack.push_back(node->left);
+            if (node->right != nullptr)
+                stack.push_back(node->right);
+            delete node;
+        }
+    }
+};
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "../common/tree_join.h"
+
+// ========================================================================
+// RBTreeMap<Key, Value, Compare, Allocator> - СЛОВАРЬ НА КРАСНО-ЧЁРНОМ ДЕРЕВЕ
+// ========================================================================
+// Интерфейс - как у std::map (см. common/tree_map.h); сам std::map обычно
+// тоже красно-чёрное дерево, поэтому это самое честное сравнение.
+// Алгоритмы вставки и удаления - из CLRS, как в учебном simple_rbtree.cxx,
+// но вместо узла-стража nil используются nullptr (nullptr - чёрный лист),
+// поэтому при удалении отдельно хранится родитель x.
+//
+// Массовое построение, split / join и объединение / пересечение / разность
+// словарей - из common/tree_join.h; здесь только join по чёрным высотам.
+// ========================================================================
+
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>, typename Augment = NoAugment>
+class RBTreeMap
+    : public JoinableTreeMap<RBTreeMap<Key, Value, Compare, Allocator, Augment>, Key, Value, Compare, Allocator,
+                             bool, Augment>
+{
+protected:
+    using Base = JoinableTreeMap<RBTreeMap, Key, Value, Compare, Allocator, bool, Augment>;
+    using Node = typename Base::Node;
+    friend Base;
+    friend typename Base::MapBase;
+
+public:
+    using Base::Base;
+
+protected:
+    // balance = true - красный узел
+    static bool isRed(const Node* node) { return node != nullptr && node->balance; }
+
+    void afterInsert(Node* z, int)
+    {
+        z->balance = true;
+        while (isRed(z->parent))
+        {
+            Node* parent = z->parent;
+            Node* grandparent = parent->parent;  // Есть: красный узел не корень
+            if (parent == grandparent->left)
+            {
+                Node* uncle = grandparent->right;
+                if (isRed(uncle))
+                {
+                    // Случай 1: красный дядя - перекраска, подъём на два уровня
+                    parent->balance = false;
+                    uncle->balance = false;
+                    grandparent->balance = true;
+                    z = grandparent;
+                    continue;
+                }
+                if (z == parent->right)
+                {
+                    // Случай 2: "треугольник" превращаем в "линию"
+                    z = parent;
+                    this->rotateLeft(z);
+                    parent = z->parent;
+                }
+                // Случай 3: "линия" - поворот вокруг деда
+                parent->balance = false;
+                grandparent->balance = true;
+                this->rotateRight(grandparent);
+            }
+            else
+            {
+                Node* uncle = grandparent->left;
+                if (isRed(uncle))
+                {
+                    parent->balance = false;
+                    uncle->balance = false;
+                    grandparent->balance = true;
+                    z = grandparent;
+                    continue;
+                }
+                if (z == parent->left)
+                {
+                    z = parent;
+                    this->rotateRight(z);
+                    parent = z->parent;
+                }
+                parent->balance = false;
+                grandparent->balance = true;
+                this->rotateLeft(grandparent);
+            }
+        }
+        this->root->balance = false;
+    }
+
+    void eraseNode(Node* z)
+    {
+        bool removedBlack;
+        Node* x;        // Узел, занявший место удалённого (может быть nullptr)
+        Node* xParent;  // Его родитель - нужен, когда x == nullptr
+        if (z->left == nullptr || z->right == nullptr)
+        {
+            removedBlack = !z->balance;
+            x = z->left != nullptr ? z->left : z->right;
+            xParent = this->spliceOut(z);
+        }
+        else
+        {
+            // Преемник y занимает место z и забирает его цвет; фактически
+            // из дерева уходит цвет y с его старого места
+            Node* y = treeMinimum(z->right);
+            removedBlack = !y->balance;
+            x = y->right;
+            xParent = y->parent == z ? y : y->parent;
+            this->bstErase(z);
+        }
+        if (removedBlack)
+            eraseFixup(x, xParent);
+    }
+
+    // Устранение "двойной черноты" x
+    void eraseFixup(Node* x, Node* xParent)
+    {
+        while (x != this->root && !isRed(x))
+        {
+            if (x == xParent->left)
+            {
+                Node* sibling = xParent->right;
+                if (isRed(sibling))
+                {
+                    sibling->balance = false;
+                    xParent->balance = true;
+                    this->rotateLeft(xParent);
+                    sibling = xParent->right;
+                }
+                if (!isRed(sibling->left) && !isRed(sibling->right))
+                {
+                    sibling->balance = true;
+                    x = xParent;
+                    xParent = x->parent;
+                }
+                else
+                {
+                    if (!isRed(sibling->right))
+                    {
+                        sibling->left->balance = false;
+                        sibling->balance = true;
+                        this->rotateRight(sibling);
+                        sibling = xParent->right;
+                    }
+                    sibling->balance = xParent->balance;
+                    xParent->balance = false;
+                    sibling->right->balance = false;
+                    this->rotateLeft(xParent);
+                    x = this->root;
+                }
+            }
+            else
+            {
+                Node* sibling = xParent->left;
+                if (isRed(sibling))
+                {
+                    sibling->balance = false;
+                    xParent->balance = true;
+                    this->rotateRight(xParent);
+                    sibling = xParent->left;
+                }
+                if (!isRed(sibling->left) && !isRed(sibling->right))
+                {
+                    sibling->balance = true;
+                    x = xParent;
+                    xParent = x->parent;
+                }
+                else
+                {
+                    if (!isRed(sibling->left))
+                    {
+                        sibling->right->balance = false;
+                        sibling->balance = true;
+                        this->rotateLeft(sibling);
+                        sibling = xParent->left;
+                    }
+                    sibling->balance = xParent->balance;
+                    xParent->balance = false;
+                    sibling->left->balance = false;
+                    this->rotateRight(xParent);
+                    x = this->root;
+                }
+            }
+        }
+        if (x != nullptr)
+            x->balance = false;
+    }
+
+    // --------------------------------------------------------------------
+    // join по чёрным высотам (для common/tree_join.h)
+    // --------------------------------------------------------------------
+    // Чёрная высота в узле не хранится, а обход края стоит O(log n). Поэтому
+    // split и splitLast вычисляют её один раз для корня и передают вниз:
+    // у ребёнка она на 1 меньше, если родитель чёрный. Иначе каждый join на
+    // пути split обходил бы края частей, и split стоил бы O(log^2 n)
+    using SplitResult = typename Base::SplitResult;
+
+    // Дерево вместе с его чёрной высотой
+    struct Joined
+    {
+        Node* tree;
+        int height;
+    };
+
+    struct HeightSplit
+    {
+        Joined left;
+        Node* match;
+        Joined right;
+    };
+
+    // Число чёрных узлов на пути от node до листа (одинаково для всех путей)
+    static int blackHeight(const Node* node)
+    {
+        int height = 0;
+        for (; node != nullptr; node = node->left)
+            height += isRed(node) ? 0 : 1;
+        return height;
+    }
+
+    static int childHeight(const Node* node, int height) { return height - (isRed(node) ? 0 : 1); }
+
+    // Спуск по правому краю tree (чёрная высота treeHeight) до чёрного узла
+    // с чёрной высотой right; там mid становится красным корнем над ним и
+    // right. Два красных подряд на правом краю исправляет ближайший чёрный
+    // предок: перекраска нижнего и левый поворот (чёрная высота сохраняется)
+    static Node* joinRight(Node* tree, int treeHeight, Node* mid, Node* right, int rightHeight)
+    {
+        if (!isRed(tree) && treeHeight == rightHeight)
+        {
+            Base::link(tree, mid, right);
+            mid->balance = true;
+            return mid;
+        }
+        Node* joined = joinRight(tree->right, treeHeight - (isRed(tree) ? 0 : 1), mid, right, rightHeight);
+        Base::setRight(tree, joined);
+        if (!isRed(tree) && isRed(joined) && isRed(joined->right))
+        {
+            joined->right->balance = false;
+            return Base::rotateLeftSubtree(tree);
+        }
+        return tree;
+    }
+
+    static Node* joinLeft(Node* left, int leftHeight, Node* mid, Node* tree, int treeHeight)
+    {
+        if (!isRed(tree) && treeHeight == leftHeight)
+        {
+            Base::link(left, mid, tree);
+            mid->balance = true;
+            return mid;
+        }
+        Node* joined = joinLeft(left, leftHeight, mid, tree->left, treeHeight - (isRed(tree) ? 0 : 1));
+        Base::setLeft(tree, joined);
+        if (!isRed(tree) && isRed(joined) && isRed(joined->left))
+        {
+            joined->left->balance = false;
+            return Base::rotateRightSubtree(tree);
+        }
+        return tree;
+    }
+
+    // Корни частей перекрашиваются в чёрный (это всегда допустимо, высота
+    // растёт на 1), корень результата - тоже: каждое дерево в split / union -
+    // корректное КЧ-дерево
+    static Joined joinWithHeights(Node* left, int leftHeight, Node* mid, Node* right, int rightHeight)
+    {
+        if (isRed(left))
+        {
+            left->balance = false;
+            leftHeight++;
+        }
+        if (isRed(right))
+        {
+            right->balance = false;
+            rightHeight++;
+        }
+        Node* top;
+        int height;
+        if (leftHeight > rightHeight)
+        {
+            top = joinRight(left, leftHeight, mid, right, rightHeight);
+            height = leftHeight + (isRed(top) ? 1 : 0);
+        }
+        else if (rightHeight > leftHeight)
+        {
+            top = joinLeft(left, leftHeight, mid, right, rightHeight);
+            height = rightHeight + (isRed(top) ? 1 : 0);
+        }
+        else
+        {
+            top = Base::link(left, mid, right);
+            height = leftHeight + 1;
+        }
+        top->balance = false;
+        top->parent = nullptr;
+        return {top, height};
+    }
+
+    // bulkLoad и union: здесь обход краёв не меняет оценок - части на
+    // глубине d рекурсии имеют высоту O(log n - d)
+    Node* joinNodes(Node* left, Node* mid, Node* right)
+    {
+        return joinWithHeights(left, blackHeight(left), mid, right, blackHeight(right)).tree;
+    }
+
+    SplitResult splitTree(Node* tree, const Key& key)
+    {
+        HeightSplit parts = splitWithHeights(tree, blackHeight(tree), key);
+        return {parts.left.tree, parts.match, parts.right.tree};
+    }
+
+    // То же, что JoinableTreeMap::splitTree, но с высотами частей
+    HeightSplit splitWithHeights(Node* tree, int height, const Key& key)
+    {
+        if (tree == nullptr)
+            return {{nullptr, 0}, nullptr, {nullptr, 0}};
+        int below = childHeight(tree, height);
+        Node* left;
+        Node* right;
+        Base::detachChildren(tree, left, right);
+        if (this->compare(key, tree->kv.first))
+        {
+            HeightSplit parts = splitWithHeights(left, below, key);
+            parts.right = joinWithHeights(parts.right.tree, parts.right.height, tree, right, below);
+            return parts;
+        }
+        if (this->compare(tree->kv.first, key))
+        {
+            HeightSplit parts = splitWithHeights(right, below, key);
+            parts.left = joinWithHeights(left, below, tree, parts.left.tree, parts.left.height);
+            return parts;
+        }
+        return {{left, below}, tree, {right, below}};
+    }
+
+    std::pair<Node*, Node*> splitLast(Node* tree)
+    {
+        std::pair<Joined, Node*> rest = splitLastWithHeights(tree, blackHeight(tree));
+        return {rest.first.tree, rest.second};
+    }
+
+    static std::pair<Joined, Node*> splitLastWithHeights(Node* tree, int height)
+    {
+        int below = childHeight(tree, height);
+        Node* left;
+        Node* right;
+        Base::detachChildren(tree, left, right);
+        if (right == nullptr)
+            return {{left, below}, tree};
+        std::pair<Joined, Node*> rest = splitLastWithHeights(right, below);
+        return {joinWithHeights(left, below, tree, rest.first.tree, rest.first.height), rest.second};
+    }
+};
@@ -1,5 +1,7 @@
 #include <iostream>
 
+#include "../common/trace.h"
+
 // ========================================================================
 // КРАСНО-ЧЕРНОЕ ДЕРЕВО (Red-Black Tree)
 // ========================================================================
@@ -45,11 +47,12 @@ struct RBNode
 };
 
 // Класс красно-черного дерева
+template <typename Trace = NoTrace>
 class RedBlackTree
 {
     RBNode* root;
     RBNode* nil;  // Специальный узел-лист (черный)
-    bool verbose;
+    Trace verbose;
 
     // Вспомогательная функция для вывода цвета
     std::string getColorName(Color c)
@@ -506,6 +509,15 @@ public:
         insertHelper(z);
     }
 
+    // Поиск: спуск от корня до nil, O(log n)
+    bool search(int val)
+    {
+        RBNode* node = root;
+        while (node != nil && node->data != val)
+            node = val < node->data ? node->left : node->right;
+        return node != nil;
+    }
+
     void inorder()
     {
         std::cout << "Inorder обход: ";
@@ -527,7 +539,7 @@ int main()
     std::cout << "  ТЕСТ 1: Красно-черное дерево - вставка" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    RedBlackTree rbt1(true);
+    RedBlackTree<VerboseTrace> rbt1(true);
     
     std::cout << "\n--- Вставка элементов ---" << std::endl;
     std::cout << "Вставляем 10 (корень, становится черным)" << std::endl;
@@ -560,7 +572,7 @@ int main()
     std::cout << "  ТЕСТ 2: Вставка в порядке возрастания" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    RedBlackTree rbt2(false);
+    RedBlackTree<> rbt2(false);
     std::cout << "Вставка в порядке возрастания (1-7) в красно-черное дерево:" << std::endl;
     for (int i = 1; i <= 7; i++)
     {
@@ -573,7 +585,7 @@ int main()
     std::cout << "  ТЕСТ 3: Большое дерево" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    RedBlackTree rbt3(false);
+    RedBlackTree<> rbt3(false);
     int values[] = {50, 30, 70, 20, 40, 60, 80, 10, 25, 35, 45, 55, 65, 75, 85};
     std::cout << "Вставка множества элементов:" << std::endl;
     for (int val : values)
@@ -586,7 +598,7 @@ int main()
     std::cout << "  ТЕСТ 4: Ручное распознавание случаев балансировки" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    RedBlackTree rbt4(true);
+    RedBlackTree<VerboseTrace> rbt4(true);
     std::cout << "\nПример: Случай 1 (дядя красный - перекрашивание)" << std::endl;
     std::cout << "Вставляем: 50, 30, 70, 20" << std::endl;
     std::cout << "Анализ при вставке 20:" << std::endl;
@@ -604,7 +616,7 @@ int main()
     std::cout << "  ТЕСТ 5: Случай 2→3 (поворот + перекрашивание)" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    RedBlackTree rbt5(true);
+    RedBlackTree<VerboseTrace> rbt5(true);
     std::cout << "Вставляем: 50, 30, 20" << std::endl;
     std::cout << "Анализ при вставке 20:" << std::endl;
     std::cout << "  1. parent(20) = 30 (красный) → нарушение" << std::endl;
@@ -1,5 +1,7 @@
 #include <iostream>
 
+#include "../common/trace.h"
+
 // Узел Splay дерева
 struct SplayNode
 {
@@ -13,10 +15,11 @@ struct SplayNode
 
 // Класс Splay дерева
 // Особенность: после каждой операции найденный узел "поднимается" в корень
+template <typename Trace = NoTrace>
 class SplayTree
 {
     SplayNode* root;
-    bool verbose;
+    Trace verbose;
 
     // Вспомогательная функция для вывода пути
     void printPath(const std::string& operation)
@@ -305,12 +308,14 @@ public:
         else
         {
             // Есть оба поддерева
+            // Отсоединяем левое поддерево, чтобы splay не поднимался выше него
+            SplayNode* rightTree = root->right;
+            root->left->parent = nullptr;
             // Находим максимум в левом поддереве
             SplayNode* maxLeft = findMax(root->left);
             splay(maxLeft);
-            maxLeft->right = root->right;
-            if (root->right != nullptr)
-                root->right->parent = maxLeft;
+            maxLeft->right = rightTree;
+            rightTree->parent = maxLeft;
             root = maxLeft;
             delete node;
         }
@@ -336,7 +341,7 @@ int main()
     std::cout << "  ТЕСТ 1: Splay дерево - базовые операции" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    SplayTree splay1(true);
+    SplayTree<VerboseTrace> splay1(true);
     
     std::cout << "\n--- Вставка элементов ---" << std::endl;
     splay1.insert(50);
@@ -367,7 +372,7 @@ int main()
     std::cout << "  ТЕСТ 2: Локальность доступа" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    SplayTree splay2(false);
+    SplayTree<> splay2(false);
     for (int i = 1; i <= 10; i++)
     {
         splay2.insert(i);
@@ -388,7 +393,7 @@ int main()
     std::cout << "  ТЕСТ 3: Различные случаи поворотов" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    SplayTree splay3(true);
+    SplayTree<VerboseTrace> splay3(true);
     std::cout << "Тест Zig-Zig (последовательные левые потомки):" << std::endl;
     splay3.insert(30);
     splay3.insert(20);
@@ -396,7 +401,7 @@ int main()
     splay3.printTree();
     
     std::cout << "\nТест Zig-Zag:" << std::endl;
-    SplayTree splay4(true);
+    SplayTree<VerboseTrace> splay4(true);
     splay4.insert(10);
     splay4.insert(30);
     splay4.insert(20);
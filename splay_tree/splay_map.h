@@ -0,0 +1,113 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "../common/tree_map.h"
+
+// ========================================================================
+// SplayMap<Key, Value, Compare, Allocator> - СЛОВАРЬ НА SPLAY-ДЕРЕВЕ
+// ========================================================================
+// Интерфейс - как у std::map (см. common/tree_map.h). Вставленный или
+// найденный (неконстантным find) узел поднимается в корень поворотами
+// Zig / Zig-Zig / Zig-Zag, как в учебном simple_splay.cxx. Часто
+// запрашиваемые ключи оказываются у корня - выигрыш на распределениях
+// с "горячими" ключами (Ципф). Константный find дерево не меняет.
+// Отдельная операция - O(n) в худшем случае (после вставки ключей по
+// возрастанию дерево - цепочка). Амортизированно O(log n) стоят только
+// операции, которые поднимают узел в корень: вставка (insert, emplace,
+// operator[]), erase существующего ключа и неконстантный find с
+// попаданием. Константные contains / count / at / lower_bound /
+// upper_bound, промахи find и erase дерево не меняют и стоят O(глубины) -
+// на цепочке O(n) каждый раз, сколько их ни повторяй.
+// ========================================================================
+
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>, typename Augment = NoAugment>
+class SplayMap
+    : public TreeMapBase<SplayMap<Key, Value, Compare, Allocator, Augment>, Key, Value, Compare, Allocator,
+                         NoBalance, Augment>
+{
+protected:
+    using Base = TreeMapBase<SplayMap, Key, Value, Compare, Allocator, NoBalance, Augment>;
+    using Node = typename Base::Node;
+    friend Base;
+
+public:
+    using Base::Base;
+
+protected:
+    // Поднять x в корень
+    void splay(Node* x)
+    {
+        while (x->parent != nullptr)
+        {
+            Node* parent = x->parent;
+            Node* grandparent = parent->parent;
+            if (grandparent == nullptr)
+            {
+                // Zig / Zag
+                if (x == parent->left)
+                    this->rotateRight(parent);
+                else
+                    this->rotateLeft(parent);
+            }
+            else if (x == parent->left && parent == grandparent->left)
+            {
+                // Zig-Zig
+                this->rotateRight(grandparent);
+                this->rotateRight(parent);
+            }
+            else if (x == parent->right && parent == grandparent->right)
+            {
+                // Zag-Zag
+                this->rotateLeft(grandparent);
+                this->rotateLeft(parent);
+            }
+            else if (x == parent->right)
+            {
+                // Zig-Zag
+                this->rotateLeft(parent);
+                this->rotateRight(grandparent);
+            }
+            else
+            {
+                // Zag-Zig
+                this->rotateRight(parent);
+                this->rotateLeft(grandparent);
+            }
+        }
+    }
+
+    void afterInsert(Node* node, int)
+    {
+        splay(node);
+    }
+
+    void onAccess(Node* node)
+    {
+        splay(node);
+    }
+
+    // Узел поднимается в корень; его поддеревья L и R соединяются:
+    // максимум L поднимается в корень L и получает R правым поддеревом
+    void eraseNode(Node* node)
+    {
+        splay(node);
+        Node* left = node->left;
+        Node* right = node->right;
+        if (left == nullptr)
+        {
+            this->replaceChild(nullptr, node, right);
+            return;
+        }
+        this->replaceChild(nullptr, node, left);
+        Node* maxLeft = treeMaximum(left);
+        splay(maxLeft);
+        maxLeft->right = right;
+        if (right != nullptr)
+            right->parent = maxLeft;
+        Base::pull(maxLeft);
+    }
+};